@@ -0,0 +1,426 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that compute and keep the per-block
+ * checksums used by the -verify checksum option.
+ * Each block of td_block_size bytes that is written gets a checksum in the
+ * table of the target. Blocks that are read are checked against the table.
+ * The table can be saved to a file at the end of the run and loaded at the
+ * start of a later run so that a read-only run can verify what was written.
+ */
+#include "xint.h"
+#if defined(__aarch64__) && defined(LINUX)
+#include <sys/auxv.h>
+#endif
+
+typedef uint32_t (*xdd_crc32c_t)(uint32_t crc, const unsigned char *bufp, size_t length);
+
+static uint32_t	xdd_crc32c_table[256];	// Table for the software CRC32C
+
+/*----------------------------------------------------------------------------*/
+/* xdd_crc32c_sw() - Table driven CRC32C for CPUs without CRC instructions
+ */
+static uint32_t
+xdd_crc32c_sw(uint32_t crc, const unsigned char *bufp, size_t length) {
+	size_t	i;
+
+	for (i = 0; i < length; i++)
+		crc = xdd_crc32c_table[(crc ^ bufp[i]) & 0xff] ^ (crc >> 8);
+	return(crc);
+} // End of xdd_crc32c_sw()
+
+#if defined(__GNUC__) && defined(__x86_64__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define XDD_CRC32C_X86
+#include <immintrin.h>
+
+__attribute__((target("sse4.2"))) static uint32_t
+xdd_crc32c_sse42(uint32_t crc, const unsigned char *bufp, size_t length) {
+	uint64_t	crc64;
+	uint64_t	word;
+
+	crc64 = crc;
+	while (length >= sizeof(uint64_t)) {
+		memcpy(&word, bufp, sizeof(word));
+		crc64 = _mm_crc32_u64(crc64, word);
+		bufp += sizeof(uint64_t);
+		length -= sizeof(uint64_t);
+	}
+	crc = (uint32_t)crc64;
+	while (length--)
+		crc = _mm_crc32_u8(crc, *bufp++);
+	return(crc);
+} // End of xdd_crc32c_sse42()
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(LINUX) && defined(HWCAP_CRC32)
+#define XDD_CRC32C_ARM
+#include <arm_acle.h>
+
+__attribute__((target("+crc"))) static uint32_t
+xdd_crc32c_armv8(uint32_t crc, const unsigned char *bufp, size_t length) {
+	uint64_t	word;
+
+	while (length >= sizeof(uint64_t)) {
+		memcpy(&word, bufp, sizeof(word));
+		crc = __crc32cd(crc, word);
+		bufp += sizeof(uint64_t);
+		length -= sizeof(uint64_t);
+	}
+	while (length--)
+		crc = __crc32cb(crc, *bufp++);
+	return(crc);
+} // End of xdd_crc32c_armv8()
+#endif
+
+static xdd_crc32c_t		xdd_crc32c = xdd_crc32c_sw;
+static pthread_once_t	xdd_crc32c_once = PTHREAD_ONCE_INIT;
+
+/*----------------------------------------------------------------------------*/
+/* xdd_crc32c_select() - Build the software CRC32C table and pick the
+ * CRC instructions of the CPU if it has them.
+ */
+static void
+xdd_crc32c_select(void) {
+	uint32_t	crc;
+	int			i, j;
+
+	for (i = 0; i < 256; i++) {
+		crc = i;
+		for (j = 0; j < 8; j++)
+			crc = (crc & 1) ? ((crc >> 1) ^ 0x82f63b78) : (crc >> 1);
+		xdd_crc32c_table[i] = crc;
+	}
+#if defined(XDD_CRC32C_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("sse4.2"))
+		xdd_crc32c = xdd_crc32c_sse42;
+#elif defined(XDD_CRC32C_ARM)
+	if (getauxval(AT_HWCAP) & HWCAP_CRC32)
+		xdd_crc32c = xdd_crc32c_armv8;
+#endif
+} // End of xdd_crc32c_select()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_xxh64() - 64-bit xxHash of a buffer with a seed of 0
+ */
+#define XDD_XXH64_P1	0x9E3779B185EBCA87ULL
+#define XDD_XXH64_P2	0xC2B2AE3D27D4EB4FULL
+#define XDD_XXH64_P3	0x165667B19E3779F9ULL
+#define XDD_XXH64_P4	0x85EBCA77C2B2AE63ULL
+#define XDD_XXH64_P5	0x27D4EB2F165667C5ULL
+#define XDD_XXH64_ROTL(x,r)	(((x) << (r)) | ((x) >> (64 - (r))))
+
+static uint64_t
+xdd_xxh64_round(uint64_t acc, uint64_t input) {
+	acc += input * XDD_XXH64_P2;
+	acc = XDD_XXH64_ROTL(acc, 31);
+	return(acc * XDD_XXH64_P1);
+} // End of xdd_xxh64_round()
+
+static uint64_t
+xdd_xxh64_merge(uint64_t acc, uint64_t val) {
+	acc ^= xdd_xxh64_round(0, val);
+	return((acc * XDD_XXH64_P1) + XDD_XXH64_P4);
+} // End of xdd_xxh64_merge()
+
+static uint64_t
+xdd_xxh64(const unsigned char *bufp, size_t length) {
+	const unsigned char	*endp;
+	uint64_t	v1, v2, v3, v4;
+	uint64_t	h, w;
+	uint32_t	w32;
+
+	endp = bufp + length;
+	if (length >= 32) {
+		v1 = XDD_XXH64_P1 + XDD_XXH64_P2;
+		v2 = XDD_XXH64_P2;
+		v3 = 0;
+		v4 = 0 - XDD_XXH64_P1;
+		while (bufp + 32 <= endp) {
+			memcpy(&w, bufp, 8);		v1 = xdd_xxh64_round(v1, w);
+			memcpy(&w, bufp + 8, 8);	v2 = xdd_xxh64_round(v2, w);
+			memcpy(&w, bufp + 16, 8);	v3 = xdd_xxh64_round(v3, w);
+			memcpy(&w, bufp + 24, 8);	v4 = xdd_xxh64_round(v4, w);
+			bufp += 32;
+		}
+		h = XDD_XXH64_ROTL(v1, 1) + XDD_XXH64_ROTL(v2, 7) + XDD_XXH64_ROTL(v3, 12) + XDD_XXH64_ROTL(v4, 18);
+		h = xdd_xxh64_merge(h, v1);
+		h = xdd_xxh64_merge(h, v2);
+		h = xdd_xxh64_merge(h, v3);
+		h = xdd_xxh64_merge(h, v4);
+	} else h = XDD_XXH64_P5;
+	h += (uint64_t)length;
+	while (bufp + 8 <= endp) {
+		memcpy(&w, bufp, 8);
+		h ^= xdd_xxh64_round(0, w);
+		h = (XDD_XXH64_ROTL(h, 27) * XDD_XXH64_P1) + XDD_XXH64_P4;
+		bufp += 8;
+	}
+	if (bufp + 4 <= endp) {
+		memcpy(&w32, bufp, 4);
+		h ^= (uint64_t)w32 * XDD_XXH64_P1;
+		h = (XDD_XXH64_ROTL(h, 23) * XDD_XXH64_P2) + XDD_XXH64_P3;
+		bufp += 4;
+	}
+	while (bufp < endp) {
+		h ^= (*bufp) * XDD_XXH64_P5;
+		h = XDD_XXH64_ROTL(h, 11) * XDD_XXH64_P1;
+		bufp++;
+	}
+	h ^= h >> 33;
+	h *= XDD_XXH64_P2;
+	h ^= h >> 29;
+	h *= XDD_XXH64_P3;
+	h ^= h >> 32;
+	return(h);
+} // End of xdd_xxh64()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_block() - Compute the checksum of one block with the
+ * specified algorithm.
+ */
+uint64_t
+xdd_checksum_block(int32_t algorithm, const unsigned char *bufp, size_t length) {
+
+	if (algorithm == XDD_CHECKSUM_XXH64)
+		return(xdd_xxh64(bufp, length));
+	pthread_once(&xdd_crc32c_once, xdd_crc32c_select);
+	return((uint64_t)(xdd_crc32c(0xffffffff, bufp, length) ^ 0xffffffff));
+} // End of xdd_checksum_block()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_name() - Return the name of a checksum algorithm
+ */
+char *
+xdd_checksum_name(int32_t algorithm) {
+	return((algorithm == XDD_CHECKSUM_XXH64) ? "xxh64" : "crc32c");
+} // End of xdd_checksum_name()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_load() - Read the checksums of a previous run from the
+ * checksum table file into the table of this target. Only the part of the
+ * saved table that overlaps the blocks of this run is used.
+ * A missing file is not an error - there is simply nothing to verify yet.
+ * Return value is 0 if good, -1 if the file cannot be used.
+ */
+static int32_t
+xdd_checksum_load(target_data_t *tdp) {
+	xint_checksum_t		*csp;
+	xint_checksum_file_header_t	hdr;
+	FILE				*fp;
+	int64_t				first, last;	// Range of blocks that both tables have
+	int64_t				n;
+	int32_t				status;
+
+
+	csp = tdp->td_csp;
+	fp = fopen(csp->cs_filename, "rb");
+	if (fp == NULL)
+		return(0);
+	status = -1;
+	if (fread(&hdr, sizeof(hdr), 1, fp) != 1) {
+		fprintf(xgp->errout,"%s: xdd_checksum_load: ERROR: Cannot read the header of checksum file '%s' for target %d\n",
+			xgp->progname, csp->cs_filename, tdp->td_target_number);
+	} else if ((hdr.csf_magic != XDD_CHECKSUM_FILE_MAGIC) || (hdr.csf_version != XDD_CHECKSUM_FILE_VERSION)) {
+		fprintf(xgp->errout,"%s: xdd_checksum_load: ERROR: File '%s' is not an xdd checksum file of version %d\n",
+			xgp->progname, csp->cs_filename, XDD_CHECKSUM_FILE_VERSION);
+	} else if ((hdr.csf_algorithm != (uint32_t)csp->cs_algorithm) || (hdr.csf_block_size != (uint32_t)tdp->td_block_size)) {
+		fprintf(xgp->errout,"%s: xdd_checksum_load: ERROR: Checksum file '%s' uses %s with a block size of %u but target %d uses %s with a block size of %d\n",
+			xgp->progname, csp->cs_filename,
+			xdd_checksum_name(hdr.csf_algorithm), hdr.csf_block_size,
+			tdp->td_target_number, xdd_checksum_name(csp->cs_algorithm), tdp->td_block_size);
+	} else {
+		first = (hdr.csf_first_block > csp->cs_first_block) ? hdr.csf_first_block : csp->cs_first_block;
+		last = ((hdr.csf_first_block + hdr.csf_num_blocks) < (csp->cs_first_block + csp->cs_num_blocks)) ?
+				(hdr.csf_first_block + hdr.csf_num_blocks) : (csp->cs_first_block + csp->cs_num_blocks);
+		n = last - first;
+		status = 0;
+		if (n > 0) {
+			if ((fseeko(fp, sizeof(hdr) + ((first - hdr.csf_first_block) * sizeof(uint64_t)), SEEK_SET) != 0) ||
+				(fread(&csp->cs_sums[first - csp->cs_first_block], sizeof(uint64_t), n, fp) != (size_t)n) ||
+				(fseeko(fp, sizeof(hdr) + (hdr.csf_num_blocks * sizeof(uint64_t)) + (first - hdr.csf_first_block), SEEK_SET) != 0) ||
+				(fread(&csp->cs_valid[first - csp->cs_first_block], 1, n, fp) != (size_t)n)) {
+				fprintf(xgp->errout,"%s: xdd_checksum_load: ERROR: Checksum file '%s' is too short\n",
+					xgp->progname, csp->cs_filename);
+				memset(csp->cs_valid, 0, csp->cs_num_blocks);
+				status = -1;
+			}
+		}
+		if ((status == 0) && (xgp->global_options & GO_VERBOSE))
+			fprintf(xgp->output,"%s: Target %d loaded %lld block checksums from '%s'\n",
+				xgp->progname, tdp->td_target_number, (long long int)((n > 0) ? n : 0), csp->cs_filename);
+	}
+	fclose(fp);
+	return(status);
+} // End of xdd_checksum_load()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_init() - Allocate the checksum table of a target so that it
+ * covers every block in the seek list, then load the checksums of a previous
+ * run if there is a checksum table file.
+ * This must be called after the seek list has been initialized.
+ * Return value is 0 if good, -1 on error.
+ */
+int32_t
+xdd_checksum_init(target_data_t *tdp) {
+	xint_checksum_t	*csp;
+	seekhdr_t		*sp;
+	int64_t			first, last;	// First block and one past the last block of any op
+	int64_t			start, reqsize;
+	int64_t			op;
+
+
+	if (!(tdp->td_target_options & TO_VERIFY_CHECKSUM))
+		return(0);
+	csp = xdd_get_csp(tdp);
+	if (csp == NULL)
+		return(-1);
+	sp = &tdp->td_seekhdr;
+	first = -1;
+	last = 0;
+	for (op = 0; op < sp->seek_total_ops; op++) {
+		start = (int64_t)(tdp->td_target_number * tdp->td_planp->target_offset) + (int64_t)sp->seeks[op].block_location;
+		reqsize = (sp->seeks[op].reqsize > 0) ? sp->seeks[op].reqsize : tdp->td_reqsize;
+		if ((first < 0) || (start < first))
+			first = start;
+		if ((start + reqsize) > last)
+			last = start + reqsize;
+	}
+	if (first < 0)
+		first = 0;
+	free(csp->cs_sums);
+	free(csp->cs_valid);
+	csp->cs_first_block = first;
+	csp->cs_num_blocks = last - first;
+	csp->cs_sums = (uint64_t *)calloc(csp->cs_num_blocks + 1, sizeof(uint64_t));
+	csp->cs_valid = (unsigned char *)calloc(csp->cs_num_blocks + 1, 1);
+	if ((csp->cs_sums == NULL) || (csp->cs_valid == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_checksum_init: ERROR: Cannot allocate memory for %lld block checksums for target %d\n",
+			xgp->progname, (long long int)csp->cs_num_blocks, tdp->td_target_number);
+		return(-1);
+	}
+	if (csp->cs_filename)
+		return(xdd_checksum_load(tdp));
+	return(0);
+} // End of xdd_checksum_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_record() - Compute and save the checksum of each block in the
+ * buffer of the write operation that this Worker Thread just completed.
+ * Blocks outside of the table are not recorded.
+ */
+void
+xdd_checksum_record(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	xint_checksum_t	*csp;
+	unsigned char	*bufp;
+	int64_t			block;			// Index of the current block in the table
+	size_t			offset;			// Byte offset of the current block in the buffer
+	uint64_t		recorded;
+
+
+	tdp = wdp->wd_tdp;
+	csp = tdp->td_csp;
+	if ((csp == NULL) || (csp->cs_sums == NULL))
+		return;
+	bufp = (unsigned char *)wdp->wd_task.task_datap;
+	block = (wdp->wd_task.task_byte_offset / tdp->td_block_size) - csp->cs_first_block;
+	recorded = 0;
+	for (offset = 0; offset + tdp->td_block_size <= wdp->wd_task.task_xfer_size; offset += tdp->td_block_size, block++) {
+		if ((block < 0) || (block >= csp->cs_num_blocks))
+			continue;
+		csp->cs_sums[block] = xdd_checksum_block(csp->cs_algorithm, &bufp[offset], tdp->td_block_size);
+		csp->cs_valid[block] = 1;
+		recorded++;
+	}
+	pthread_mutex_lock(&tdp->td_counters_mutex);
+	csp->cs_blocks_recorded += recorded;
+	pthread_mutex_unlock(&tdp->td_counters_mutex);
+} // End of xdd_checksum_record()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_save() - Write the checksum table of a target to its checksum
+ * table file if one was specified and anything was written during this run.
+ * Return value is 0 if good, -1 on error.
+ */
+int32_t
+xdd_checksum_save(target_data_t *tdp) {
+	xint_checksum_t		*csp;
+	xint_checksum_file_header_t	hdr;
+	FILE				*fp;
+	int32_t				status;
+
+
+	csp = tdp->td_csp;
+	if ((csp == NULL) || (csp->cs_filename == NULL) || (csp->cs_sums == NULL) || (csp->cs_blocks_recorded == 0))
+		return(0);
+	fp = fopen(csp->cs_filename, "wb");
+	if (fp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_checksum_save: ERROR: Cannot open checksum file '%s' for target %d\n",
+			xgp->progname, csp->cs_filename, tdp->td_target_number);
+		perror("Reason");
+		return(-1);
+	}
+	memset(&hdr, 0, sizeof(hdr));
+	hdr.csf_magic = XDD_CHECKSUM_FILE_MAGIC;
+	hdr.csf_version = XDD_CHECKSUM_FILE_VERSION;
+	hdr.csf_algorithm = csp->cs_algorithm;
+	hdr.csf_block_size = tdp->td_block_size;
+	hdr.csf_target_number = tdp->td_target_number;
+	hdr.csf_first_block = csp->cs_first_block;
+	hdr.csf_num_blocks = csp->cs_num_blocks;
+	status = 0;
+	if ((fwrite(&hdr, sizeof(hdr), 1, fp) != 1) ||
+		(fwrite(csp->cs_sums, sizeof(uint64_t), csp->cs_num_blocks, fp) != (size_t)csp->cs_num_blocks) ||
+		(fwrite(csp->cs_valid, 1, csp->cs_num_blocks, fp) != (size_t)csp->cs_num_blocks)) {
+		fprintf(xgp->errout,"%s: xdd_checksum_save: ERROR: Cannot write checksum file '%s' for target %d\n",
+			xgp->progname, csp->cs_filename, tdp->td_target_number);
+		perror("Reason");
+		status = -1;
+	}
+	if (fclose(fp) != 0)
+		status = -1;
+	return(status);
+} // End of xdd_checksum_save()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_checksum_free() - Free the checksum table of a target and the name of
+ * its checksum table file. This is called by the Target Thread at the end of
+ * the run after the table has been saved. The counters are kept.
+ */
+void
+xdd_checksum_free(target_data_t *tdp) {
+	xint_checksum_t		*csp;
+
+
+	csp = tdp->td_csp;
+	if (csp == NULL)
+		return;
+	free(csp->cs_sums);
+	csp->cs_sums = NULL;
+	free(csp->cs_valid);
+	csp->cs_valid = NULL;
+	free(csp->cs_filename);
+	csp->cs_filename = NULL;
+} // End of xdd_checksum_free()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,302 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the compound ops used by
+ * -op rmw and -op writeverify.
+ * A read-modify-write op reads the blocks it is about to write into a
+ * scratch buffer of the Worker Thread and then writes the data pattern over
+ * them, the way a database updates a page. Nothing that was read goes into
+ * the write - only the cost of the read is added to the op.
+ * A write-verify op is a normal write whose checksum is remembered by the
+ * Worker Thread. Once the target has done -readbackdelay more ops the blocks
+ * are read back and checked against it so that a write that was acknowledged
+ * but lost under load is caught.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_init() - Check that the compound ops of a target can be done.
+ * This is called before the seek list is built so that a target that cannot
+ * do them gets plain writes instead.
+ */
+void
+xdd_compound_init(target_data_t *tdp) {
+	xint_compound_t	*cop;
+
+
+	cop = tdp->td_cop;
+	if ((cop == NULL) || (cop->co_op == 0))
+		return;
+	if (tdp->td_target_options & (TO_ENDTOEND | TO_SGIO)) {
+		fprintf(xgp->errout,"%s: xdd_compound_init: Target %d: WARNING: Compound ops are not supported with E2E or SGIO - doing plain writes\n",
+			xgp->progname, tdp->td_target_number);
+		cop->co_op = 0;
+	}
+} // End of xdd_compound_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_get_worker() - Return the compound op state of a Worker
+ * Thread, allocating it the first time. The scratch buffer is the same size
+ * as the I/O buffer of the Worker Thread.
+ */
+static xint_compound_worker_t *
+xdd_compound_get_worker(worker_data_t *wdp) {
+	target_data_t			*tdp;
+	xint_compound_worker_t	*cwp;
+
+
+	if (wdp->wd_cwp)
+		return(wdp->wd_cwp);
+	tdp = wdp->wd_tdp;
+	cwp = (xint_compound_worker_t *)calloc(1, sizeof(xint_compound_worker_t));
+	if (cwp == NULL)
+		return(NULL);
+	if (posix_memalign((void **)&cwp->cw_bufp, getpagesize(), wdp->wd_buf_size) != 0)
+		cwp->cw_bufp = NULL;
+	if (tdp->td_cop->co_op == SO_OP_WRITE_VERIFY) {
+		cwp->cw_ring_size = tdp->td_cop->co_readback_delay + 1;
+		cwp->cw_ring = (xint_readback_t *)calloc(cwp->cw_ring_size, sizeof(xint_readback_t));
+	}
+	if ((cwp->cw_bufp == NULL) || ((tdp->td_cop->co_op == SO_OP_WRITE_VERIFY) && (cwp->cw_ring == NULL))) {
+		fprintf(xgp->errout,"%s: xdd_compound_get_worker: Target %d Worker Thread %d: ERROR: Cannot allocate memory for the compound ops\n",
+			xgp->progname, tdp->td_target_number, wdp->wd_worker_number);
+		free(cwp->cw_bufp);
+		free(cwp->cw_ring);
+		free(cwp);
+		return(NULL);
+	}
+	wdp->wd_cwp = cwp;
+	return(cwp);
+} // End of xdd_compound_get_worker()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_rmw_read() - Do the read of a read-modify-write op.
+ * This is called by xdd_io_for_os() between the start and the end of the op
+ * so that the time of the op covers both the read and the write. The rest
+ * of the time of the op is counted as the time of the write.
+ * Return values: 0 if the write may go ahead, -1 if the read failed in
+ *                which case task_io_status has the status of the read
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+int32_t
+xdd_compound_rmw_read(worker_data_t *wdp) {
+	xint_compound_worker_t	*cwp;
+	ssize_t					status;
+	nclk_t					start_time;
+	nclk_t					end_time;
+
+
+	cwp = xdd_compound_get_worker(wdp);
+	if (cwp == NULL) {
+		wdp->wd_task.task_io_status = -1;
+		return(-1);
+	}
+	nclk_now(&start_time);
+	status = pread(wdp->wd_task.task_file_desc, cwp->cw_bufp, wdp->wd_task.task_xfer_size, wdp->wd_task.task_byte_offset);
+	nclk_now(&end_time);
+	cwp->cw_read_time = end_time - start_time;
+	if (status != (ssize_t)wdp->wd_task.task_xfer_size) {
+		wdp->wd_task.task_io_status = status;
+		wdp->wd_task.task_op_string = "RMW READ";
+		return(-1);
+	}
+	return(0);
+} // End of xdd_compound_rmw_read()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_readback() - Read back a write and check it.
+ * This is called by the Worker Thread that did the write or, for the writes
+ * still waiting at the end of a pass, by the Target Thread.
+ */
+static void
+xdd_compound_readback(target_data_t *tdp, xint_compound_worker_t *cwp, xint_readback_t *rbp, int fd) {
+	xint_compound_t	*cop;
+	ssize_t			status;
+	uint64_t		checksum;
+	nclk_t			start_time;
+	nclk_t			end_time;
+
+
+	cop = tdp->td_cop;
+	nclk_now(&start_time);
+	status = pread(fd, cwp->cw_bufp, rbp->rb_xfer_size, rbp->rb_byte_offset);
+	nclk_now(&end_time);
+	if (status != (ssize_t)rbp->rb_xfer_size) {
+		fprintf(xgp->errout,"%s: xdd_compound_readback: Target %d: ERROR: Readback of op %lld at byte offset %lld returned %lld instead of %llu\n",
+			xgp->progname, tdp->td_target_number, (long long int)rbp->rb_op_number,
+			(long long int)rbp->rb_byte_offset, (long long int)status, (unsigned long long)rbp->rb_xfer_size);
+		pthread_mutex_lock(&tdp->td_counters_mutex);
+		cop->co_readback_io_errors++;
+		pthread_mutex_unlock(&tdp->td_counters_mutex);
+		return;
+	}
+	checksum = xdd_checksum_block(XDD_CHECKSUM_CRC32C, cwp->cw_bufp, rbp->rb_xfer_size);
+	pthread_mutex_lock(&tdp->td_counters_mutex);
+	cop->co_readback_ops++;
+	cop->co_readback_write_time += rbp->rb_write_time;
+	cop->co_readback_read_time += (end_time - start_time);
+	cop->co_readback_time += rbp->rb_write_time + (end_time - start_time);
+	if (checksum != rbp->rb_checksum) {
+		cop->co_readback_errors++;
+		if ((uint64_t)cop->co_readback_errors <= xgp->max_errors_to_print)
+			fprintf(xgp->errout,"%s: xdd_compound_readback: Target %d: ERROR: LOST WRITE: The %llu bytes written by op %lld at byte offset %lld read back different\n",
+				xgp->progname, tdp->td_target_number, (unsigned long long)rbp->rb_xfer_size,
+				(long long int)rbp->rb_op_number, (long long int)rbp->rb_byte_offset);
+	}
+	pthread_mutex_unlock(&tdp->td_counters_mutex);
+} // End of xdd_compound_readback()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_after_io_op() - Account for a read-modify-write op, remember
+ * a write-verify op, and read back the writes of this Worker Thread that the
+ * target has since done enough ops for.
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_compound_after_io_op(worker_data_t *wdp) {
+	target_data_t			*tdp;
+	xint_compound_t			*cop;
+	xint_compound_worker_t	*cwp;
+	xint_readback_t			*rbp;
+	nclk_t					read_time;
+
+
+	tdp = wdp->wd_tdp;
+	cop = tdp->td_cop;
+	if ((cop == NULL) || (cop->co_op == 0))
+		return;
+	if (tdp->td_target_options & TO_NULL_TARGET)
+		return;
+	cwp = wdp->wd_cwp;
+	if ((wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) &&
+		(wdp->wd_task.task_io_status == (ssize_t)wdp->wd_task.task_xfer_size)) {
+		if ((wdp->wd_task.task_compound == TASK_COMPOUND_RMW) && cwp) {
+			read_time = cwp->cw_read_time;
+			pthread_mutex_lock(&tdp->td_counters_mutex);
+			cop->co_rmw_ops++;
+			cop->co_rmw_time += wdp->wd_counters.tc_current_op_elapsed_time;
+			cop->co_rmw_read_time += read_time;
+			cop->co_rmw_write_time += wdp->wd_counters.tc_current_op_elapsed_time - read_time;
+			pthread_mutex_unlock(&tdp->td_counters_mutex);
+		} else if (wdp->wd_task.task_compound == TASK_COMPOUND_READBACK) {
+			cwp = xdd_compound_get_worker(wdp);
+			if (cwp == NULL)
+				return;
+			if (cwp->cw_count == cwp->cw_ring_size) { // No room - read back the oldest write early
+				xdd_compound_readback(tdp, cwp, &cwp->cw_ring[cwp->cw_head], wdp->wd_task.task_file_desc);
+				cwp->cw_head = (cwp->cw_head + 1) % cwp->cw_ring_size;
+				cwp->cw_count--;
+			}
+			rbp = &cwp->cw_ring[(cwp->cw_head + cwp->cw_count) % cwp->cw_ring_size];
+			rbp->rb_op_number = wdp->wd_task.task_op_number;
+			rbp->rb_byte_offset = wdp->wd_task.task_byte_offset;
+			rbp->rb_xfer_size = wdp->wd_task.task_xfer_size;
+			rbp->rb_checksum = xdd_checksum_block(XDD_CHECKSUM_CRC32C, wdp->wd_task.task_datap, wdp->wd_task.task_xfer_size);
+			rbp->rb_write_time = wdp->wd_counters.tc_current_op_elapsed_time;
+			cwp->cw_count++;
+		}
+	}
+
+	// Read back the writes that are now far enough behind
+	if ((cwp == NULL) || (cwp->cw_ring == NULL))
+		return;
+	while (cwp->cw_count > 0) {
+		rbp = &cwp->cw_ring[cwp->cw_head];
+		if (((int64_t)wdp->wd_task.task_op_number - rbp->rb_op_number) < cop->co_readback_delay)
+			break;
+		xdd_compound_readback(tdp, cwp, rbp, wdp->wd_task.task_file_desc);
+		cwp->cw_head = (cwp->cw_head + 1) % cwp->cw_ring_size;
+		cwp->cw_count--;
+	}
+} // End of xdd_compound_after_io_op()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_drain() - Read back all the writes that are still waiting at
+ * the end of a pass. The Worker Threads are idle at this point.
+ */
+void
+xdd_compound_drain(target_data_t *tdp) {
+	worker_data_t			*wdp;
+	xint_compound_worker_t	*cwp;
+
+
+	if ((tdp->td_cop == NULL) || (tdp->td_cop->co_op != SO_OP_WRITE_VERIFY))
+		return;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		cwp = wdp->wd_cwp;
+		if (cwp == NULL)
+			continue;
+		while (cwp->cw_count > 0) {
+			xdd_compound_readback(tdp, cwp, &cwp->cw_ring[cwp->cw_head], tdp->td_file_desc);
+			cwp->cw_head = (cwp->cw_head + 1) % cwp->cw_ring_size;
+			cwp->cw_count--;
+		}
+	}
+} // End of xdd_compound_drain()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_destroy() - Free the compound op state of the Worker Threads
+ * of a target. This is called by the Target Thread at the end of the run
+ * after the last pass has been drained.
+ */
+void
+xdd_compound_destroy(target_data_t *tdp) {
+	worker_data_t			*wdp;
+	xint_compound_worker_t	*cwp;
+
+
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		cwp = wdp->wd_cwp;
+		if (cwp == NULL)
+			continue;
+		free(cwp->cw_bufp);
+		free(cwp->cw_ring);
+		free(cwp);
+		wdp->wd_cwp = NULL;
+	}
+} // End of xdd_compound_destroy()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_compound_display() - Display the compound ops of a target over the run
+ * and how their time was split between their reads and their writes
+ * Called by xdd_process_run_results()
+ */
+void
+xdd_compound_display(FILE *out, target_data_t *tdp) {
+	xint_compound_t	*cop;
+
+
+	cop = tdp->td_cop;
+	if (cop->co_op == SO_OP_READ_MODIFY_WRITE)
+		fprintf(out,"Target %d read-modify-write, %llu, ops, %.3f, seconds, %.3f, seconds reading, %.3f, seconds writing\n",
+			tdp->td_target_number, (unsigned long long)cop->co_rmw_ops, (double)cop->co_rmw_time / FLOAT_BILLION,
+			(double)cop->co_rmw_read_time / FLOAT_BILLION, (double)cop->co_rmw_write_time / FLOAT_BILLION);
+	else if (cop->co_op == SO_OP_WRITE_VERIFY)
+		fprintf(out,"Target %d write-verify, %llu, ops, %.3f, seconds, %.3f, seconds writing, %.3f, seconds reading back, %lld, lost writes, %lld, readback errors\n",
+			tdp->td_target_number, (unsigned long long)cop->co_readback_ops, (double)cop->co_readback_time / FLOAT_BILLION,
+			(double)cop->co_readback_write_time / FLOAT_BILLION, (double)cop->co_readback_read_time / FLOAT_BILLION,
+			(long long int)cop->co_readback_errors, (long long int)cop->co_readback_io_errors);
+} // End of xdd_compound_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
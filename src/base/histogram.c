@@ -0,0 +1,509 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the latency histograms used by
+ * -histogram and by the percentile fields of -outputformat.
+ * Each Worker Thread records the time of each of its read and write ops in
+ * histograms of its own. At the end of each pass the Results Manager merges
+ * them into the histograms of the target for that pass, which are in turn
+ * merged into the target average and the combined results of the run.
+ */
+#include "xint.h"
+
+// The -outputformat fields that need the histograms
+static char *xdd_histogram_format_ids[] = {
+	"+P50LATENCY", "+P90LATENCY", "+P99LATENCY", "+P999LATENCY", "+P9999LATENCY", "+MAXLATENCY", NULL
+};
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_index() - Return the bucket an op time goes into
+ */
+static int
+xdd_histogram_index(nclk_t value) {
+	int		msb;	// Most significant bit of the value
+	int		shift;
+
+
+	if (value < (nclk_t)(2 * XINT_HISTOGRAM_HALF_COUNT))
+		return((int)value);
+	if (value >= ((nclk_t)1 << XINT_HISTOGRAM_MAX_BITS))
+		return(XINT_HISTOGRAM_BUCKETS - 1);
+#if defined(__GNUC__)
+	msb = 63 - __builtin_clzll((unsigned long long)value);
+#else
+	for (msb = XINT_HISTOGRAM_MAX_BITS - 1; !(value & ((nclk_t)1 << msb)); msb--)
+		;
+#endif
+	shift = msb - (XINT_HISTOGRAM_SUB_BUCKET_BITS - 1);
+	return((shift * XINT_HISTOGRAM_HALF_COUNT) + (int)(value >> shift));
+} // End of xdd_histogram_index()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_bucket_low() and xdd_histogram_bucket_high() - Return the
+ * lowest and the highest op time that go into a bucket
+ */
+nclk_t
+xdd_histogram_bucket_low(int index) {
+	int		shift;
+
+
+	if (index < 2 * XINT_HISTOGRAM_HALF_COUNT)
+		return((nclk_t)index);
+	shift = (index / XINT_HISTOGRAM_HALF_COUNT) - 1;
+	return((nclk_t)(index - (shift * XINT_HISTOGRAM_HALF_COUNT)) << shift);
+} // End of xdd_histogram_bucket_low()
+
+nclk_t
+xdd_histogram_bucket_high(int index) {
+	int		shift;
+
+
+	if (index < 2 * XINT_HISTOGRAM_HALF_COUNT)
+		return((nclk_t)index);
+	shift = (index / XINT_HISTOGRAM_HALF_COUNT) - 1;
+	return(((nclk_t)(index - (shift * XINT_HISTOGRAM_HALF_COUNT) + 1) << shift) - 1);
+} // End of xdd_histogram_bucket_high()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_reset() - Empty a set of histograms
+ */
+void
+xdd_histogram_reset(xint_histograms_t *hsp) {
+	int		i;
+
+
+	memset(hsp->hs_hist, 0, hsp->hs_count * sizeof(xint_histogram_t));
+	for (i = 0; i < hsp->hs_count; i++)
+		hsp->hs_hist[i].h_min = NCLK_MAX;
+} // End of xdd_histogram_reset()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_alloc() - Allocate an empty set of "count" histograms.
+ * Only the memory for those is allocated, so hs_hist[count] and above must
+ * not be touched.
+ * Return values: Pointer to the histograms or NULL if there is no memory
+ */
+xint_histograms_t *
+xdd_histogram_alloc(int32_t count) {
+	xint_histograms_t	*hsp;
+	size_t				size;
+
+
+	size = offsetof(xint_histograms_t, hs_hist) + (count * sizeof(xint_histogram_t));
+	hsp = (xint_histograms_t *)malloc(size);
+	if (hsp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_histogram_alloc: ERROR: Cannot allocate %d bytes of memory for the latency histograms\n",
+			xgp->progname, (int)size);
+		return(NULL);
+	}
+	hsp->hs_count = count;
+	xdd_histogram_reset(hsp);
+	return(hsp);
+} // End of xdd_histogram_alloc()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_format_check() - Turn the histograms on if the output
+ * format asks for a percentile.
+ * This is called after the options have been parsed.
+ */
+void
+xdd_histogram_format_check(xdd_plan_t *planp) {
+	int		i;
+
+
+	if (planp->format_string == NULL)
+		return;
+	for (i = 0; xdd_histogram_format_ids[i]; i++) {
+		if (strstr(planp->format_string, xdd_histogram_format_ids[i])) {
+			planp->plan_options |= PLAN_HISTOGRAM;
+			return;
+		}
+	}
+} // End of xdd_histogram_format_check()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_count() - Number of histograms in each set of a plan. The
+ * -dispatchstats ones are only kept with that option.
+ */
+static int32_t
+xdd_histogram_count(xdd_plan_t *planp) {
+	return((planp->plan_options & PLAN_DISPATCH_STATS) ? XINT_HISTOGRAMS : XINT_HISTOGRAMS_BASIC);
+} // End of xdd_histogram_count()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_worker_init() - Give a Worker Thread its histograms
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_histogram_worker_init(worker_data_t *wdp) {
+
+
+	if (!(wdp->wd_tdp->td_planp->plan_options & PLAN_HISTOGRAM))
+		return(0);
+	if (wdp->wd_hgp == NULL)
+		wdp->wd_hgp = xdd_histogram_alloc(xdd_histogram_count(wdp->wd_tdp->td_planp));
+	if (wdp->wd_hgp == NULL)
+		return(-1);
+	return(0);
+} // End of xdd_histogram_worker_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_record() - Add an op time to a histogram
+ */
+static void
+xdd_histogram_record(xint_histogram_t *hp, nclk_t value) {
+
+
+	hp->h_buckets[xdd_histogram_index(value)]++;
+	hp->h_count++;
+	hp->h_total += value;
+	if (value < hp->h_min)
+		hp->h_min = value;
+	if (value > hp->h_max)
+		hp->h_max = value;
+} // End of xdd_histogram_record()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_after_io_op() - Record the time of the op just done and, for
+ * -dispatchstats, how long it took to be handed over and issued
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_histogram_after_io_op(worker_data_t *wdp) {
+	xint_histograms_t	*hsp;
+
+
+	hsp = wdp->wd_hgp;
+	if (hsp == NULL)
+		return;
+	if (wdp->wd_task.task_io_status != (ssize_t)wdp->wd_task.task_xfer_size)
+		return;
+	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_READ)
+		xdd_histogram_record(&hsp->hs_hist[XINT_HISTOGRAM_READ], wdp->wd_counters.tc_current_op_elapsed_time);
+	else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE)
+		xdd_histogram_record(&hsp->hs_hist[XINT_HISTOGRAM_WRITE], wdp->wd_counters.tc_current_op_elapsed_time);
+	else return;
+	xdd_histogram_record(&hsp->hs_hist[XINT_HISTOGRAM_ALL], wdp->wd_counters.tc_current_op_elapsed_time);
+	if ((wdp->wd_tdp->td_planp->plan_options & PLAN_DISPATCH_STATS) && wdp->wd_task.task_setup_time &&
+		(wdp->wd_counters.tc_current_op_start_time >= wdp->wd_task.task_wakeup_time) &&
+		(wdp->wd_task.task_wakeup_time >= wdp->wd_task.task_setup_time)) {
+		xdd_histogram_record(&hsp->hs_hist[XINT_HISTOGRAM_HANDOFF], wdp->wd_task.task_wakeup_time - wdp->wd_task.task_setup_time);
+		xdd_histogram_record(&hsp->hs_hist[XINT_HISTOGRAM_PREISSUE], wdp->wd_counters.tc_current_op_start_time - wdp->wd_task.task_wakeup_time);
+		xdd_histogram_record(&hsp->hs_hist[XINT_HISTOGRAM_DISPATCH], wdp->wd_counters.tc_current_op_start_time - wdp->wd_task.task_setup_time);
+	}
+} // End of xdd_histogram_after_io_op()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_merge() - Add the histograms in "from" to those in "to"
+ */
+void
+xdd_histogram_merge(xint_histograms_t *to, xint_histograms_t *from) {
+	xint_histogram_t	*thp;
+	xint_histogram_t	*fhp;
+	int					i;
+	int					b;
+
+
+	for (i = 0; (i < to->hs_count) && (i < from->hs_count); i++) {
+		thp = &to->hs_hist[i];
+		fhp = &from->hs_hist[i];
+		if (fhp->h_count == 0)
+			continue;
+		for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++)
+			thp->h_buckets[b] += fhp->h_buckets[b];
+		thp->h_count += fhp->h_count;
+		thp->h_total += fhp->h_total;
+		if (fhp->h_min < thp->h_min)
+			thp->h_min = fhp->h_min;
+		if (fhp->h_max > thp->h_max)
+			thp->h_max = fhp->h_max;
+	}
+} // End of xdd_histogram_merge()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_target_pass() - Merge the histograms of the Worker Threads
+ * of a target into the histograms of the target for the pass just done and
+ * empty them for the next pass. If there is a -histogram file each Worker
+ * Thread also keeps its histograms over the run for it.
+ * This is called by the Results Manager while the Worker Threads are idle.
+ * Return values: Pointer to the histograms of the target or NULL if there are none
+ */
+xint_histograms_t *
+xdd_histogram_target_pass(target_data_t *tdp) {
+	worker_data_t	*wdp;
+
+
+	if (!(tdp->td_planp->plan_options & PLAN_HISTOGRAM))
+		return(NULL);
+	if (tdp->td_hgp == NULL)
+		tdp->td_hgp = xdd_histogram_alloc(xdd_histogram_count(tdp->td_planp));
+	if (tdp->td_hgp == NULL)
+		return(NULL);
+	xdd_histogram_reset(tdp->td_hgp);
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		if (wdp->wd_hgp == NULL)
+			continue;
+		xdd_histogram_merge(tdp->td_hgp, wdp->wd_hgp);
+		if (tdp->td_planp->histogram_filename) {
+			if (wdp->wd_run_hgp == NULL)
+				wdp->wd_run_hgp = xdd_histogram_alloc(wdp->wd_hgp->hs_count);
+			if (wdp->wd_run_hgp)
+				xdd_histogram_merge(wdp->wd_run_hgp, wdp->wd_hgp);
+		}
+		xdd_histogram_reset(wdp->wd_hgp);
+	}
+	return(tdp->td_hgp);
+} // End of xdd_histogram_target_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_target_interval() - Put the op times of a target since the
+ * last look into ihp and remember the totals in php for the next look.
+ * Only the ALL histograms are looked at. The longest op of the interval is
+ * only known to within a bucket.
+ */
+static void
+xdd_histogram_target_interval(target_data_t *tdp, xint_histogram_t *ihp, xint_histogram_t *php) {
+	xint_histogram_t	*whp;
+	worker_data_t		*wdp;
+	uint64_t			count;
+	uint64_t			total;
+	int					top;	// Highest bucket with op times of this interval
+	int					b;
+
+
+	memset(ihp, 0, sizeof(*ihp));
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		if (wdp->wd_hgp == NULL)
+			continue;
+		whp = &wdp->wd_hgp->hs_hist[XINT_HISTOGRAM_ALL];
+		for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++)
+			ihp->h_buckets[b] += whp->h_buckets[b];
+		ihp->h_count += whp->h_count;
+		ihp->h_total += whp->h_total;
+		if (whp->h_max > ihp->h_max)
+			ihp->h_max = whp->h_max;
+	}
+	// The histograms of the Worker Threads are emptied at the end of each pass
+	if (ihp->h_count < php->h_count)
+		memset(php, 0, sizeof(*php));
+
+	// Turn the totals into the difference from the last look
+	count = 0;
+	top = -1;
+	for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++) {
+		total = ihp->h_buckets[b];
+		ihp->h_buckets[b] = (total >= php->h_buckets[b]) ? (total - php->h_buckets[b]) : 0;
+		php->h_buckets[b] = total;
+		if (ihp->h_buckets[b]) {
+			count += ihp->h_buckets[b];
+			top = b;
+		}
+	}
+	total = ihp->h_total;
+	ihp->h_total = (total >= php->h_total) ? (total - php->h_total) : 0;
+	php->h_total = total;
+	php->h_count = ihp->h_count;
+	ihp->h_count = count;
+	// The longest op of the interval is somewhere in the highest bucket used
+	if ((top >= 0) && (xdd_histogram_bucket_high(top) < ihp->h_max))
+		ihp->h_max = xdd_histogram_bucket_high(top);
+} // End of xdd_histogram_target_interval()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_target_look() - Put the bytes and ops of a target since the
+ * last look into *bytesp and *opsp and, if ihp is not NULL, its op times into
+ * ihp. lkp has what the last look saw and is updated for the next one.
+ * This is used by the threads that report on a run while it goes on, so the
+ * counters and the histograms of the Worker Threads are read without locking
+ * them.
+ * Both start over with each pass. The Results Manager has the last look of a
+ * pass done with pass_end set before it empties the histograms. The counters
+ * then stay put until the next pass starts them over, so a look that finds
+ * them unchanged since the end of a pass has nothing new. Comparing them with
+ * the last look alone is not enough: a pass that spans a whole interval can
+ * get further than the pass before it did, and its ops would be lost.
+ */
+void
+xdd_histogram_target_look(target_data_t *tdp, xint_histogram_look_t *lkp, int pass_end, int64_t *bytesp, int64_t *opsp, xint_histogram_t *ihp) {
+	int64_t		bytes;
+	int64_t		ops;
+	int			restarted;
+
+
+	bytes = tdp->td_counters.tc_accumulated_bytes_xfered;
+	ops = tdp->td_counters.tc_accumulated_op_count;
+	if (lkp->hl_pass_done) {
+		if (!pass_end && !((tdp->td_counters.tc_pass_elapsed_time == 0) && ((bytes != lkp->hl_bytes) || (ops != lkp->hl_ops)))) {
+			*bytesp = 0;
+			*opsp = 0;
+			if (ihp)
+				memset(ihp, 0, sizeof(*ihp));
+			return;
+		}
+		restarted = 1;
+	} else restarted = ((bytes < lkp->hl_bytes) || (ops < lkp->hl_ops));
+	if (restarted) {
+		lkp->hl_bytes = 0;
+		lkp->hl_ops = 0;
+		memset(&lkp->hl_hist, 0, sizeof(lkp->hl_hist));
+	}
+	lkp->hl_pass_done = pass_end;
+	*bytesp = bytes - lkp->hl_bytes;
+	*opsp = ops - lkp->hl_ops;
+	lkp->hl_bytes = bytes;
+	lkp->hl_ops = ops;
+	if (ihp)
+		xdd_histogram_target_interval(tdp, ihp, &lkp->hl_hist);
+} // End of xdd_histogram_target_look()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_percentile() - Return the op time that the given percent of
+ * the op times are at or below. The answer is the top of the bucket it falls
+ * in, but never more than the longest op time.
+ * Return values: Op time in nanoseconds or 0 if there are no op times
+ */
+nclk_t
+xdd_histogram_percentile(xint_histogram_t *hp, double percent) {
+	uint64_t	rank;		// Number of op times that have to be at or below the answer
+	uint64_t	seen;		// Number of op times in the buckets looked at so far
+	nclk_t		high;
+	int			b;
+
+
+	if (hp->h_count == 0)
+		return(0);
+	if (percent >= 100.0)
+		return(hp->h_max);
+	rank = (uint64_t)ceil((percent / 100.0) * (double)hp->h_count);
+	if (rank == 0)
+		rank = 1;
+	seen = 0;
+	for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++) {
+		seen += hp->h_buckets[b];
+		if (seen >= rank) {
+			high = xdd_histogram_bucket_high(b);
+			return((high < hp->h_max) ? high : hp->h_max);
+		}
+	}
+	return(hp->h_max);
+} // End of xdd_histogram_percentile()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_display() - Display the percentiles of the op times of a
+ * target over the run
+ */
+void
+xdd_histogram_display(FILE *out, target_data_t *tdp, xint_histograms_t *hsp) {
+	static char		*names[XINT_HISTOGRAMS] = {"read", "write", "all", "handoff", "preissue", "dispatch"};
+	xint_histogram_t	*hp;
+	int				i;
+
+
+	for (i = 0; i < hsp->hs_count; i++) {
+		hp = &hsp->hs_hist[i];
+		if (hp->h_count == 0)
+			continue;
+		fprintf(out,"Target %d latency %s, %llu, ops, %.4f, mean, %.4f, p50, %.4f, p90, %.4f, p99, %.4f, p99.9, %.4f, p99.99, %.4f, max, milliseconds\n",
+			tdp->td_target_number, names[i], (unsigned long long)hp->h_count,
+			((double)hp->h_total / (double)hp->h_count) / FLOAT_MILLION,
+			(double)xdd_histogram_percentile(hp, 50.0) / FLOAT_MILLION,
+			(double)xdd_histogram_percentile(hp, 90.0) / FLOAT_MILLION,
+			(double)xdd_histogram_percentile(hp, 99.0) / FLOAT_MILLION,
+			(double)xdd_histogram_percentile(hp, 99.9) / FLOAT_MILLION,
+			(double)xdd_histogram_percentile(hp, 99.99) / FLOAT_MILLION,
+			(double)hp->h_max / FLOAT_MILLION);
+	}
+} // End of xdd_histogram_display()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_write_buckets() - Write the buckets in use of a set of
+ * histograms to the -histogram file, one per line. The Worker Thread is
+ * "all" for the histograms of the whole target.
+ */
+static void
+xdd_histogram_write_buckets(FILE *fp, xdd_plan_t *planp, int target_number, char *worker, xint_histograms_t *hsp) {
+	static char		*names[XINT_HISTOGRAMS] = {"read", "write", "all", "handoff", "preissue", "dispatch"};
+	xint_histogram_t	*hp;
+	int				i;
+	int				b;
+
+
+	for (i = 0; i < hsp->hs_count; i++) {
+		hp = &hsp->hs_hist[i];
+		for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++) {
+			if (hp->h_buckets[b] == 0)
+				continue;
+			fprintf(fp,"%s,%d,%s,%s,%llu,%llu,%llu\n",
+				planp->hostname.nodename, target_number, worker, names[i],
+				(unsigned long long)xdd_histogram_bucket_low(b),
+				(unsigned long long)xdd_histogram_bucket_high(b),
+				(unsigned long long)hp->h_buckets[b]);
+		}
+	}
+} // End of xdd_histogram_write_buckets()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_histogram_write() - Write the buckets of the histograms of each target
+ * and each of its Worker Threads over the run to the -histogram file.
+ * Only the buckets in use are written, one per line, so that the files of
+ * several hosts can be merged by adding up the counts of equal buckets.
+ */
+void
+xdd_histogram_write(xdd_plan_t *planp) {
+	FILE			*fp;
+	results_t		*tarp;
+	target_data_t	*tdp;
+	worker_data_t	*wdp;
+	char			worker[16];
+	int				target_number;
+
+
+	if ((planp->histogram_filename == NULL) || !(planp->plan_options & PLAN_HISTOGRAM))
+		return;
+	fp = fopen(planp->histogram_filename, "w");
+	if (fp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_histogram_write: ERROR: Cannot open histogram file '%s'\n",
+			xgp->progname, planp->histogram_filename);
+		perror("Reason");
+		return;
+	}
+	fprintf(fp,"# xdd latency histograms, host %s, %d sub-buckets per power of two, op times in nanoseconds\n",
+		planp->hostname.nodename, XINT_HISTOGRAM_HALF_COUNT);
+	fprintf(fp,"Host,Target,Worker,Op,Low,High,Count\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tarp = planp->target_average_resultsp[target_number];
+		if ((tarp == NULL) || (tarp->hgp == NULL))
+			continue;
+		xdd_histogram_write_buckets(fp, planp, target_number, "all", tarp->hgp);
+		tdp = planp->target_datap[target_number];
+		for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+			if (wdp->wd_run_hgp == NULL)
+				continue;
+			sprintf(worker, "%d", wdp->wd_worker_number);
+			xdd_histogram_write_buckets(fp, planp, target_number, worker, wdp->wd_run_hgp);
+		}
+	}
+	fclose(fp);
+} // End of xdd_histogram_write()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
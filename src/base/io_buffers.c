@@ -20,81 +20,28 @@
 #endif
 
 /*----------------------------------------------------------------------------*/
-/* xdd_init_io_buffers() - set up the I/O buffers
- * This routine will allocate the memory used as the I/O buffer for a Worker
- * Thread. The pointer to the buffer (wd_bufp) and the size of the buffer 
- * (wd_buf_size) are set in the Worker Data Struct.
- *
- * This routine will return the pointer to the buffer upon success. If for
- * some reason the buffer cannot be allocated then NULL is returned. 
- *
+/* xdd_io_buffer_alloc() - Allocate "buffer_size" bytes of memory for an I/O 
+ * buffer of a target and lock it in memory.
  * For some operating systems, you can use a shared memory segment instead of 
  * a normal malloc/valloc memory chunk. This is done using the "-sharedmemory"
- * command line option.
- *
- * The size of the buffer depends on whether it is being used for network
- * I/O as in an End-to-end operation. For End-to-End operations, the size
- * of the buffer is 1 page larger than for non-End-to-End operations.
+ * command line option. The segment is marked for removal as soon as it is 
+ * attached so that it goes away when it is detached or xdd exits.
+ * This is used for the I/O buffers of the Worker Threads and for the spare
+ * buffers of the -verifythreads pool so that they all are the same kind.
  *
- * For normal (non-E2E operations) the buffer pointers are as follows:
- *                   |<----------- wd_buf_size = N Pages ----------------->|
- *	                 +-----------------------------------------------------+
- *	                 |  data buffer                                        |
- *	                 |  transfer size (td_xfer_size) rounded up to N pages |
- *	                 |<-wd_bufp                                            |
- *	                 |<-task_datap                                         |
- *	                 +-----------------------------------------------------+
- *
- * For End-to-End operations, the buffer pointers are as follows:
- *  |<------------------- wd_buf_size = N+1 Pages ------------------------>|
- *	+----------------+-----------------------------------------------------+
- *	|<----1 page---->|  transfer size (td_xfer_size) rounded up to N pages |
- *	|<-wd_bufp       |<-task_datap                                         |
- *	|     |   E2E    |      E2E                                            |
- *	|     |<-Header->|   data buffer                                       |
- *	+-----*----------*-----------------------------------------------------+
- *	      ^          ^
- *	      ^          +-e2e_datap     
- *	      +-e2e_hdrp 
+ * This routine will return the pointer to the buffer upon success. If for
+ * some reason the buffer cannot be allocated then NULL is returned. 
  */
 unsigned char *
-xdd_init_io_buffers(worker_data_t *wdp) {
-	target_data_t		*tdp;			// Pointer to Target Data
+xdd_io_buffer_alloc(target_data_t *tdp, int buffer_size) {
 	unsigned char 		*bufp;			// Generic Buffer Pointer
 	void 				*shmat_status;	// Status of shmat()
 	int 				buf_shmid;		// Shared Memory ID
-	int					buffer_size;	// Size of buffer in bytes
-	int					page_size;		// Size of a page of memory
-	int					pages;			// Size of buffer in pages
 #ifdef WIN32
 	LPVOID lpMsgBuf; /* Used for the error messages */
 #endif
 
-	tdp = wdp->wd_tdp;
-	wdp->wd_bufp = NULL;
-	wdp->wd_buf_size = 0;
-
-	// Calaculate the number of pages needed for a buffer
-	page_size = getpagesize();
-	pages = tdp->td_xfer_size / page_size;
-	if (tdp->td_xfer_size % page_size)
-		pages++; // Round up to page size
-	if ((tdp->td_target_options & TO_ENDTOEND)) {
-		// Add one page for the e2e header
-		pages++; 
-
-		// If its XNI, add another page for XNI, better would be for XNI to
-		// pack all of the header data (and do the hton, ntoh calls)
-		xdd_plan_t *planp = tdp->td_planp;
-		if (PLAN_ENABLE_XNI & planp->plan_options) {
-			pages++;
-		}
-	}
-
-	
-	// This is the actual size of the I/O buffer
-	buffer_size = pages * page_size;
-
+	bufp = NULL;
 	/* Check to see if we want to use a shared memory segment and allocate it using shmget() and shmat().
 	 * NOTE: This is not supported by all operating systems. 
 	 */
@@ -118,9 +65,9 @@ xdd_init_io_buffers(worker_data_t *wdp) {
 				fprintf(xgp->errout,"%s: Cannot attach to shared memory segment\n",xgp->progname);
 				perror("Reason");
 				bufp = 0;
-				buf_shmid = -1;
 			}
 			else bufp = (unsigned char *)shmat_status;
+			shmctl(buf_shmid, IPC_RMID, NULL);
 		}
 		if (xgp->global_options & GO_REALLYVERBOSE)
 				fprintf(xgp->output,"Shared Memory ID allocated and attached, shmid=%d\n",buf_shmid);
@@ -136,7 +83,8 @@ xdd_init_io_buffers(worker_data_t *wdp) {
 #endif 
 	} else { /* Allocate memory the normal way */
 #if (AIX || LINUX)
-		posix_memalign((void **)&bufp, sysconf(_SC_PAGESIZE), buffer_size);
+		if (posix_memalign((void **)&bufp, sysconf(_SC_PAGESIZE), buffer_size) != 0)
+			bufp = NULL;
 #elif (IRIX || SOLARIS || LINUX || DARWIN || FREEBSD)
 		bufp = valloc(buffer_size);
 #else
@@ -171,6 +119,102 @@ xdd_init_io_buffers(worker_data_t *wdp) {
 	/* Lock all pages in memory */
 	xdd_lock_memory(bufp, buffer_size, "RW BUFFER");
 
+	return(bufp);
+} /* end of xdd_io_buffer_alloc() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_io_buffer_free() - Release an I/O buffer of a target that was
+ * allocated by xdd_io_buffer_alloc()
+ */
+void
+xdd_io_buffer_free(target_data_t *tdp, unsigned char *bufp, int buffer_size) {
+	if (bufp == NULL)
+		return;
+	xdd_unlock_memory(bufp, buffer_size, "RW BUFFER");
+	if (tdp->td_target_options & TO_SHARED_MEMORY) {
+#if (AIX || LINUX || SOLARIS || DARWIN || FREEBSD)
+		shmdt(bufp);
+#endif
+	} else free(bufp);
+} /* end of xdd_io_buffer_free() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_init_io_buffers() - set up the I/O buffers
+ * This routine will allocate the memory used as the I/O buffer for a Worker
+ * Thread. The pointer to the buffer (wd_bufp) and the size of the buffer 
+ * (wd_buf_size) are set in the Worker Data Struct.
+ *
+ * This routine will return the pointer to the buffer upon success. If for
+ * some reason the buffer cannot be allocated then NULL is returned. 
+ *
+ * The memory comes from xdd_io_buffer_alloc().
+ *
+ * The size of the buffer depends on whether it is being used for network
+ * I/O as in an End-to-end operation. For End-to-End operations, the size
+ * of the buffer is 1 page larger than for non-End-to-End operations.
+ *
+ * For normal (non-E2E operations) the buffer pointers are as follows:
+ *                   |<----------- wd_buf_size = N Pages ----------------->|
+ *	                 +-----------------------------------------------------+
+ *	                 |  data buffer                                        |
+ *	                 |  transfer size (td_xfer_size) rounded up to N pages |
+ *	                 |<-wd_bufp                                            |
+ *	                 |<-task_datap                                         |
+ *	                 +-----------------------------------------------------+
+ *
+ * For End-to-End operations, the buffer pointers are as follows:
+ *  |<------------------- wd_buf_size = N+1 Pages ------------------------>|
+ *	+----------------+-----------------------------------------------------+
+ *	|<----1 page---->|  transfer size (td_xfer_size) rounded up to N pages |
+ *	|<-wd_bufp       |<-task_datap                                         |
+ *	|     |   E2E    |      E2E                                            |
+ *	|     |<-Header->|   data buffer                                       |
+ *	+-----*----------*-----------------------------------------------------+
+ *	      ^          ^
+ *	      ^          +-e2e_datap     
+ *	      +-e2e_hdrp 
+ */
+unsigned char *
+xdd_init_io_buffers(worker_data_t *wdp) {
+	target_data_t		*tdp;			// Pointer to Target Data
+	unsigned char 		*bufp;			// Generic Buffer Pointer
+	int					buffer_size;	// Size of buffer in bytes
+	int					page_size;		// Size of a page of memory
+	int					pages;			// Size of buffer in pages
+
+	tdp = wdp->wd_tdp;
+	wdp->wd_bufp = NULL;
+	wdp->wd_buf_size = 0;
+
+	// Calaculate the number of pages needed for a buffer
+	// When request sizes vary the buffer has to hold the largest request in the seek list
+	page_size = getpagesize();
+	buffer_size = tdp->td_xfer_size;
+	if ((tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) && (tdp->td_seekhdr.seek_iosize > (uint32_t)buffer_size))
+		buffer_size = tdp->td_seekhdr.seek_iosize;
+	pages = buffer_size / page_size;
+	if (buffer_size % page_size)
+		pages++; // Round up to page size
+	if ((tdp->td_target_options & TO_ENDTOEND)) {
+		// Add one page for the e2e header
+		pages++; 
+
+		// If its XNI, add another page for XNI, better would be for XNI to
+		// pack all of the header data (and do the hton, ntoh calls)
+		xdd_plan_t *planp = tdp->td_planp;
+		if (PLAN_ENABLE_XNI & planp->plan_options) {
+			pages++;
+		}
+	}
+
+	
+	// This is the actual size of the I/O buffer
+	buffer_size = pages * page_size;
+
+	bufp = xdd_io_buffer_alloc(tdp, buffer_size);
+	if (bufp == NULL)
+		return(NULL);
+
 	wdp->wd_bufp = bufp;
 	wdp->wd_buf_size = buffer_size;
 
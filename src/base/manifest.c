@@ -0,0 +1,478 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the write manifest used by the
+ * -manifest option.
+ * A write run appends a record for every completed write to the manifest
+ * file: the blocks written, the run (generation) and pass that wrote them,
+ * and the checksum of each block. Before records are appended the target
+ * itself is flushed, so the manifest never lists a write that is not on
+ * stable storage. The records are flushed when the buffer fills, at least
+ * every XDD_MANIFEST_SYNC_INTERVAL while writes complete, and at the end of
+ * every pass so that they survive a power cycle or a failover along with the data.
+ * There are two record buffers so that the Worker Threads can go on adding
+ * records to one while the other one is being flushed.
+ * A later run verifies its reads against the newest record of each block no
+ * matter what data pattern, request size, or seek pattern wrote the blocks.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_read_header() - Read and check the header of a manifest file
+ * Return values: 0 if the header is good, -1 if not
+ */
+static int32_t
+xdd_manifest_read_header(target_data_t *tdp, int fd, xint_manifest_file_header_t *hdrp) {
+	xint_manifest_t		*mfp;
+
+
+	mfp = tdp->td_mfp;
+	if (pread(fd, hdrp, sizeof(*hdrp), 0) != (ssize_t)sizeof(*hdrp)) {
+		fprintf(xgp->errout,"%s: xdd_manifest_read_header: ERROR: Cannot read the header of manifest '%s' for target %d\n",
+			xgp->progname, mfp->mf_filename, tdp->td_target_number);
+		return(-1);
+	}
+	if ((hdrp->mfh_magic != XDD_MANIFEST_FILE_MAGIC) || (hdrp->mfh_version != XDD_MANIFEST_FILE_VERSION)) {
+		fprintf(xgp->errout,"%s: xdd_manifest_read_header: ERROR: File '%s' is not an xdd manifest of version %d\n",
+			xgp->progname, mfp->mf_filename, XDD_MANIFEST_FILE_VERSION);
+		return(-1);
+	}
+	if (hdrp->mfh_block_size != (uint32_t)tdp->td_block_size) {
+		fprintf(xgp->errout,"%s: xdd_manifest_read_header: ERROR: Manifest '%s' has a block size of %u but target %d uses a block size of %d\n",
+			xgp->progname, mfp->mf_filename, hdrp->mfh_block_size, tdp->td_target_number, tdp->td_block_size);
+		return(-1);
+	}
+	return(0);
+} // End of xdd_manifest_read_header()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_scan() - Go through the records of a manifest file.
+ * The highest generation in the file is returned in "generationp". If the
+ * checksum table "csp" is given then the checksum of every block in the
+ * range of the table is put into it, newer records replacing older ones.
+ * Return values: 0 is good, -1 if the file is damaged
+ */
+static int32_t
+xdd_manifest_scan(target_data_t *tdp, int fd, xint_checksum_t *csp, uint32_t *generationp) {
+	xint_manifest_t			*mfp;
+	xint_manifest_record_t	rec;
+	FILE					*fp;
+	struct stat				statbuf;
+	uint64_t				*sums;
+	size_t					max_blocks;
+	int64_t					block;
+	uint32_t				i;
+	int32_t					status;
+
+
+	mfp = tdp->td_mfp;
+	fp = fdopen(dup(fd), "rb");
+	if (fp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_manifest_scan: ERROR: Cannot read manifest '%s' for target %d\n",
+			xgp->progname, mfp->mf_filename, tdp->td_target_number);
+		return(-1);
+	}
+	*generationp = 0;
+	max_blocks = 0;
+	sums = NULL;
+	status = 0;
+	if ((fstat(fd, &statbuf) < 0) || (fseeko(fp, sizeof(xint_manifest_file_header_t), SEEK_SET) != 0))
+		status = -1;
+	while ((status == 0) && (fread(&rec, sizeof(rec), 1, fp) == 1)) {
+		// A record can be no larger than the record buffer of the run that wrote it or the rest of the file
+		if ((rec.mr_num_blocks > XDD_MANIFEST_MAX_BLOCKS) ||
+			((off_t)(rec.mr_num_blocks * sizeof(uint64_t)) > (statbuf.st_size - ftello(fp)))) {
+			fprintf(xgp->errout,"%s: xdd_manifest_scan: WARNING: Manifest '%s' has a damaged record of %u blocks at offset %lld - ignoring the rest of it\n",
+				xgp->progname, mfp->mf_filename, rec.mr_num_blocks, (long long)(ftello(fp) - sizeof(rec)));
+			break;
+		}
+		if (rec.mr_num_blocks > max_blocks) {
+			free(sums);
+			max_blocks = rec.mr_num_blocks;
+			sums = (uint64_t *)malloc(max_blocks * sizeof(uint64_t));
+			if (sums == NULL) {
+				fprintf(xgp->errout,"%s: xdd_manifest_scan: ERROR: Cannot allocate memory for %u checksums of manifest '%s'\n",
+					xgp->progname, rec.mr_num_blocks, mfp->mf_filename);
+				status = -1;
+				break;
+			}
+		}
+		if (fread(sums, sizeof(uint64_t), rec.mr_num_blocks, fp) != rec.mr_num_blocks) {
+			fprintf(xgp->errout,"%s: xdd_manifest_scan: WARNING: Manifest '%s' ends in a partial record - ignoring it\n",
+				xgp->progname, mfp->mf_filename);
+			break;
+		}
+		if (rec.mr_generation > *generationp)
+			*generationp = rec.mr_generation;
+		if (csp == NULL)
+			continue;
+		for (i = 0; i < rec.mr_num_blocks; i++) {
+			block = rec.mr_first_block + i - csp->cs_first_block;
+			if ((block < 0) || (block >= csp->cs_num_blocks))
+				continue;
+			csp->cs_sums[block] = sums[i];
+			csp->cs_valid[block] = 1;
+		}
+		mfp->mf_records++;
+		mfp->mf_blocks += rec.mr_num_blocks;
+	}
+	free(sums);
+	fclose(fp);
+	return(status);
+} // End of xdd_manifest_scan()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_init() - Open the manifest of a target.
+ * For -manifest write the file is created with a header or, if it already
+ * exists, the records of this run are appended as the next generation.
+ * For -manifest verify the records are loaded into the checksum table of
+ * the target that -verify checksum uses; this has to be called after
+ * xdd_checksum_init() has sized the table.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_manifest_init(target_data_t *tdp) {
+	xint_manifest_t				*mfp;
+	xint_manifest_file_header_t	hdr;
+	xint_checksum_t				*csp;
+	int32_t						algorithm;
+	int							fd;
+	struct stat					statbuf;
+
+
+	mfp = tdp->td_mfp;
+	if (mfp == NULL)
+		return(0);
+	mfp->mf_fd = -1;
+	mfp->mf_records = 0;
+	mfp->mf_blocks = 0;
+	csp = tdp->td_csp;
+	if (mfp->mf_mode == XDD_MANIFEST_VERIFY) {
+		fd = open(mfp->mf_filename, O_RDONLY);
+		if (fd < 0) {
+			fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: Cannot open manifest '%s' for target %d\n",
+				xgp->progname, mfp->mf_filename, tdp->td_target_number);
+			perror("Reason");
+			return(-1);
+		}
+		if ((csp == NULL) || (csp->cs_sums == NULL)) {
+			fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: -manifest verify needs -verify checksum for target %d\n",
+				xgp->progname, tdp->td_target_number);
+			close(fd);
+			return(-1);
+		}
+		if (xdd_manifest_read_header(tdp, fd, &hdr) < 0) {
+			close(fd);
+			return(-1);
+		}
+		if (csp->cs_filename && (hdr.mfh_algorithm != (uint32_t)csp->cs_algorithm)) {
+			fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: Manifest '%s' uses %s but the checksum table of target %d uses %s\n",
+				xgp->progname, mfp->mf_filename, xdd_checksum_name(hdr.mfh_algorithm),
+				tdp->td_target_number, xdd_checksum_name(csp->cs_algorithm));
+			close(fd);
+			return(-1);
+		}
+		csp->cs_algorithm = hdr.mfh_algorithm;
+		if (xdd_manifest_scan(tdp, fd, csp, &mfp->mf_generation) < 0) {
+			close(fd);
+			return(-1);
+		}
+		close(fd);
+		if (xgp->global_options & GO_VERBOSE)
+			fprintf(xgp->output,"%s: Target %d loaded %llu records of %llu blocks from manifest '%s'\n",
+				xgp->progname, tdp->td_target_number,
+				(unsigned long long)mfp->mf_records, (unsigned long long)mfp->mf_blocks, mfp->mf_filename);
+		return(0);
+	}
+
+	// XDD_MANIFEST_WRITE
+	algorithm = (csp) ? csp->cs_algorithm : XDD_CHECKSUM_CRC32C;
+	fd = open(mfp->mf_filename, O_RDWR | O_CREAT | O_APPEND, 0666);
+	if ((fd < 0) || (fstat(fd, &statbuf) < 0)) {
+		fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: Cannot open manifest '%s' for target %d\n",
+			xgp->progname, mfp->mf_filename, tdp->td_target_number);
+		perror("Reason");
+		return(-1);
+	}
+	if (statbuf.st_size == 0) { // A new manifest
+		memset(&hdr, 0, sizeof(hdr));
+		hdr.mfh_magic = XDD_MANIFEST_FILE_MAGIC;
+		hdr.mfh_version = XDD_MANIFEST_FILE_VERSION;
+		hdr.mfh_algorithm = algorithm;
+		hdr.mfh_block_size = tdp->td_block_size;
+		hdr.mfh_target_number = tdp->td_target_number;
+		hdr.mfh_pattern_options = tdp->td_dpp->data_pattern_options;
+		hdr.mfh_pattern_seed = tdp->td_dpp->data_pattern_seed;
+		if (write(fd, &hdr, sizeof(hdr)) != (ssize_t)sizeof(hdr)) {
+			fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: Cannot write the header of manifest '%s' for target %d\n",
+				xgp->progname, mfp->mf_filename, tdp->td_target_number);
+			close(fd);
+			return(-1);
+		}
+		mfp->mf_generation = 1;
+	} else { // Append to an existing manifest as the next generation
+		if (xdd_manifest_read_header(tdp, fd, &hdr) < 0) {
+			close(fd);
+			return(-1);
+		}
+		if (hdr.mfh_algorithm != (uint32_t)algorithm) {
+			fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: Manifest '%s' uses %s but target %d uses %s\n",
+				xgp->progname, mfp->mf_filename, xdd_checksum_name(hdr.mfh_algorithm),
+				tdp->td_target_number, xdd_checksum_name(algorithm));
+			close(fd);
+			return(-1);
+		}
+		if (xdd_manifest_scan(tdp, fd, NULL, &mfp->mf_generation) < 0) {
+			close(fd);
+			return(-1);
+		}
+		mfp->mf_generation++;
+		mfp->mf_records = 0;
+		mfp->mf_blocks = 0;
+	}
+	mfp->mf_bufp = (unsigned char *)malloc(XDD_MANIFEST_BUFFER_SIZE);
+	mfp->mf_flush_bufp = (unsigned char *)malloc(XDD_MANIFEST_BUFFER_SIZE);
+	if ((mfp->mf_bufp == NULL) || (mfp->mf_flush_bufp == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_manifest_init: ERROR: Cannot allocate 2 x %d bytes of memory for the manifest buffers of target %d\n",
+			xgp->progname, XDD_MANIFEST_BUFFER_SIZE, tdp->td_target_number);
+		free(mfp->mf_bufp);
+		free(mfp->mf_flush_bufp);
+		mfp->mf_bufp = NULL;
+		mfp->mf_flush_bufp = NULL;
+		close(fd);
+		return(-1);
+	}
+	mfp->mf_buf_used = 0;
+	mfp->mf_errors = 0;
+	mfp->mf_fd = fd;
+	pthread_mutex_init(&mfp->mf_mutex, 0);
+	pthread_mutex_init(&mfp->mf_flush_mutex, 0);
+	return(0);
+} // End of xdd_manifest_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_flush() - Swap the record buffers, flush the data of the
+ * target to stable storage, then append the records to the manifest file and
+ * flush that too. The records only describe writes that have completed, so
+ * once the target is flushed every one of them is on stable storage before it
+ * is in the manifest. Only the swap is done under mf_mutex, so other Worker
+ * Threads can add records while the target and the manifest are flushed.
+ * If "room" is not zero the records are only flushed when the buffer has no
+ * room for that many more bytes, which another flush may have made already.
+ * The caller holds mf_flush_mutex but not mf_mutex.
+ */
+static void
+xdd_manifest_flush(target_data_t *tdp, size_t room) {
+	xint_manifest_t	*mfp;
+	unsigned char	*bufp;
+	size_t			used;
+	ssize_t			status;
+
+
+	mfp = tdp->td_mfp;
+	pthread_mutex_lock(&mfp->mf_mutex);
+	used = mfp->mf_buf_used;
+	if ((used == 0) || (room && ((used + room) <= XDD_MANIFEST_BUFFER_SIZE))) {
+		if (used == 0)
+			nclk_now(&mfp->mf_flush_time);
+		pthread_mutex_unlock(&mfp->mf_mutex);
+		return;
+	}
+	bufp = mfp->mf_bufp;
+	mfp->mf_bufp = mfp->mf_flush_bufp;
+	mfp->mf_flush_bufp = bufp;
+	mfp->mf_buf_used = 0;
+	nclk_now(&mfp->mf_flush_time);
+	pthread_mutex_unlock(&mfp->mf_mutex);
+
+	if (!(tdp->td_target_options & TO_NULL_TARGET)) {
+#if (LINUX || AIX)
+		status = fdatasync(tdp->td_file_desc);
+#else
+		status = fsync(tdp->td_file_desc);
+#endif
+		if ((status < 0) && (mfp->mf_errors++ == 0)) {
+			fprintf(xgp->errout,"%s: xdd_manifest_flush: ERROR: Cannot flush target %d before appending to manifest '%s'\n",
+				xgp->progname, tdp->td_target_number, mfp->mf_filename);
+			perror("Reason");
+		}
+	}
+	status = write(mfp->mf_fd, bufp, used);
+	if (status != (ssize_t)used) {
+		if (mfp->mf_errors++ == 0) {
+			fprintf(xgp->errout,"%s: xdd_manifest_append: ERROR: Cannot append %zu bytes to manifest '%s' for target %d\n",
+				xgp->progname, used, mfp->mf_filename, tdp->td_target_number);
+			perror("Reason");
+		}
+	}
+#if (LINUX || AIX)
+	fdatasync(mfp->mf_fd);
+#else
+	fsync(mfp->mf_fd);
+#endif
+} // End of xdd_manifest_flush()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_record() - Add a record of the write that was just completed
+ * by this Worker Thread to the manifest. The checksums are computed outside
+ * of the lock into a scratch array of the Worker Thread that is sized for its
+ * I/O buffer the first time; only copying the record into the buffer is
+ * serialized.
+ * The records are flushed when the buffer is full or the oldest of them has
+ * waited XDD_MANIFEST_SYNC_INTERVAL. A Worker Thread that finds another one
+ * flushing for the interval does not wait for it.
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_manifest_record(worker_data_t *wdp) {
+	target_data_t			*tdp;
+	xint_manifest_t			*mfp;
+	xint_manifest_record_t	*recp;
+	unsigned char			*bufp;
+	uint64_t				*sums;
+	uint32_t				blocks, i;
+	int32_t					algorithm;
+	size_t					length;
+	nclk_t					now;
+	int						flush;
+
+
+	tdp = wdp->wd_tdp;
+	mfp = tdp->td_mfp;
+	if ((mfp == NULL) || (mfp->mf_mode != XDD_MANIFEST_WRITE) || (mfp->mf_fd < 0))
+		return;
+	blocks = wdp->wd_task.task_xfer_size / tdp->td_block_size;
+	if (blocks == 0)
+		return;
+	length = sizeof(xint_manifest_record_t) + (blocks * sizeof(uint64_t));
+	if ((length > XDD_MANIFEST_BUFFER_SIZE) || (blocks > (uint32_t)(wdp->wd_buf_size / tdp->td_block_size))) {
+		if (mfp->mf_errors == 0)
+			fprintf(xgp->errout,"%s: xdd_manifest_record: ERROR: A request of %u blocks is too large for the manifest of target %d\n",
+				xgp->progname, blocks, tdp->td_target_number);
+		mfp->mf_errors++;
+		return;
+	}
+	if (wdp->wd_manifest_sums == NULL) {
+		wdp->wd_manifest_sums = (uint64_t *)malloc((wdp->wd_buf_size / tdp->td_block_size) * sizeof(uint64_t));
+		if (wdp->wd_manifest_sums == NULL) {
+			fprintf(xgp->errout,"%s: xdd_manifest_record: ERROR: Cannot allocate memory for the checksums of Worker Thread %d of target %d\n",
+				xgp->progname, wdp->wd_worker_number, tdp->td_target_number);
+			return;
+		}
+	}
+	sums = wdp->wd_manifest_sums;
+	algorithm = (tdp->td_csp) ? tdp->td_csp->cs_algorithm : XDD_CHECKSUM_CRC32C;
+	bufp = (unsigned char *)wdp->wd_task.task_datap;
+	for (i = 0; i < blocks; i++)
+		sums[i] = xdd_checksum_block(algorithm, &bufp[(size_t)i * tdp->td_block_size], tdp->td_block_size);
+
+	pthread_mutex_lock(&mfp->mf_mutex);
+	while ((mfp->mf_buf_used + length) > XDD_MANIFEST_BUFFER_SIZE) {
+		pthread_mutex_unlock(&mfp->mf_mutex);
+		pthread_mutex_lock(&mfp->mf_flush_mutex);
+		xdd_manifest_flush(tdp, length);
+		pthread_mutex_unlock(&mfp->mf_flush_mutex);
+		pthread_mutex_lock(&mfp->mf_mutex);
+	}
+	if (mfp->mf_buf_used == 0) // The first record since the last flush starts the interval
+		nclk_now(&mfp->mf_flush_time);
+	recp = (xint_manifest_record_t *)(mfp->mf_bufp + mfp->mf_buf_used);
+	memset(recp, 0, sizeof(*recp));
+	recp->mr_first_block = wdp->wd_task.task_byte_offset / tdp->td_block_size;
+	recp->mr_num_blocks = blocks;
+	recp->mr_generation = mfp->mf_generation;
+	recp->mr_pass = tdp->td_counters.tc_pass_number;
+	memcpy(recp + 1, sums, blocks * sizeof(uint64_t));
+	mfp->mf_buf_used += length;
+	mfp->mf_records++;
+	mfp->mf_blocks += blocks;
+	nclk_now(&now);
+	flush = ((now - mfp->mf_flush_time) >= XDD_MANIFEST_SYNC_INTERVAL);
+	pthread_mutex_unlock(&mfp->mf_mutex);
+	if (flush && (pthread_mutex_trylock(&mfp->mf_flush_mutex) == 0)) {
+		xdd_manifest_flush(tdp, 0);
+		pthread_mutex_unlock(&mfp->mf_flush_mutex);
+	}
+} // End of xdd_manifest_record()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_sync() - Flush the target and the buffered records of the
+ * manifest to stable storage. This is called at the end of every pass.
+ */
+void
+xdd_manifest_sync(target_data_t *tdp) {
+	xint_manifest_t	*mfp;
+
+
+	mfp = tdp->td_mfp;
+	if ((mfp == NULL) || (mfp->mf_mode != XDD_MANIFEST_WRITE) || (mfp->mf_fd < 0))
+		return;
+	pthread_mutex_lock(&mfp->mf_flush_mutex);
+	xdd_manifest_flush(tdp, 0);
+	pthread_mutex_unlock(&mfp->mf_flush_mutex);
+} // End of xdd_manifest_sync()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_close() - Sync and close the manifest of a target and free the
+ * checksum arrays of its Worker Threads
+ */
+void
+xdd_manifest_close(target_data_t *tdp) {
+	xint_manifest_t	*mfp;
+	worker_data_t	*wdp;
+
+
+	mfp = tdp->td_mfp;
+	if ((mfp == NULL) || (mfp->mf_fd < 0))
+		return;
+	xdd_manifest_sync(tdp);
+	close(mfp->mf_fd);
+	mfp->mf_fd = -1;
+	free(mfp->mf_bufp);
+	mfp->mf_bufp = NULL;
+	free(mfp->mf_flush_bufp);
+	mfp->mf_flush_bufp = NULL;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		free(wdp->wd_manifest_sums);
+		wdp->wd_manifest_sums = NULL;
+	}
+} // End of xdd_manifest_close()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_manifest_display() - Display how many records the run of a target
+ * wrote to or loaded from its manifest
+ * Called by xdd_process_run_results()
+ */
+void
+xdd_manifest_display(FILE *out, target_data_t *tdp) {
+	xint_manifest_t	*mfp;
+
+
+	mfp = tdp->td_mfp;
+	fprintf(out,"Target %d manifest %s, %s, generation, %u, %llu, records, %llu, blocks, %d, append errors\n",
+		tdp->td_target_number, (mfp->mf_mode == XDD_MANIFEST_WRITE) ? "write" : "verify",
+		mfp->mf_filename, mfp->mf_generation,
+		(unsigned long long)mfp->mf_records, (unsigned long long)mfp->mf_blocks, mfp->mf_errors);
+} // End of xdd_manifest_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
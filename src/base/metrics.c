@@ -0,0 +1,514 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of -metrics which answers HTTP requests
+ * with the live counters, op time histograms, and states of the targets and
+ * Worker Threads in the Prometheus text exposition format.
+ */
+#include "xint.h"
+
+#ifdef MSG_NOSIGNAL
+#define XINT_METRICS_SEND_FLAGS	MSG_NOSIGNAL	// A client that hangs up early must not kill xdd with SIGPIPE
+#else
+#define XINT_METRICS_SEND_FLAGS	0
+#endif
+
+// Upper bounds in seconds of the buckets of the op time histograms
+static double xdd_metrics_latency_buckets[] = {
+	0.00001, 0.000025, 0.00005, 0.0001, 0.00025, 0.0005,
+	0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+	0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 0.0
+};
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_observe() - Add what each target did since the last look to
+ * the totals of the run. The last look of each pass is done with pass_end set.
+ * The caller holds mx_mutex.
+ */
+static void
+xdd_metrics_observe(xint_metrics_t *mxp, int pass_end) {
+	xdd_plan_t				*planp;
+	target_data_t			*tdp;
+	xint_metrics_target_t	*mxtp;
+	xint_histogram_t		*hp;
+	int64_t					bytes;
+	int64_t					ops;
+	int						target_number;
+	int						b;
+
+
+	planp = mxp->mx_planp;
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		mxtp = &mxp->mx_targets[target_number];
+
+		xdd_histogram_target_look(tdp, &mxtp->mxt_look, pass_end, &bytes, &ops,
+			(planp->plan_options & PLAN_HISTOGRAM) ? &mxp->mx_hist : NULL);
+		mxtp->mxt_bytes_total += bytes;
+		mxtp->mxt_ops_total += ops;
+		if (!(planp->plan_options & PLAN_HISTOGRAM))
+			continue;
+		hp = &mxtp->mxt_hist_total;
+		for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++)
+			hp->h_buckets[b] += mxp->mx_hist.h_buckets[b];
+		hp->h_count += mxp->mx_hist.h_count;
+		hp->h_total += mxp->mx_hist.h_total;
+	}
+} // End of xdd_metrics_observe()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_labels() - Write the labels that name a target
+ * The path name is escaped the way the exposition format wants.
+ */
+static void
+xdd_metrics_labels(FILE *fp, target_data_t *tdp) {
+	char	*cp;
+
+
+	fprintf(fp, "target=\"%d\",path=\"", tdp->td_target_number);
+	for (cp = tdp->td_target_full_pathname; cp && *cp; cp++) {
+		if ((*cp == '\\') || (*cp == '"'))
+			fputc('\\', fp);
+		if (*cp == '\n')
+			fputs("\\n", fp);
+		else fputc(*cp, fp);
+	}
+	fputc('"', fp);
+} // End of xdd_metrics_labels()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_format() - Write all of the metrics. The caller holds mx_mutex.
+ */
+static void
+xdd_metrics_format(xint_metrics_t *mxp, FILE *fp) {
+	xdd_plan_t				*planp;
+	target_data_t			*tdp;
+	worker_data_t			*wdp;
+	xint_metrics_target_t	*mxtp;
+	xint_histogram_t		*hp;
+	nclk_t					now;
+	uint64_t				count;
+	int						target_number;
+	int						b;
+	int						i;
+
+
+	planp = mxp->mx_planp;
+	nclk_now(&now);
+	fprintf(fp, "# HELP xdd_info Information about this xdd process.\n# TYPE xdd_info gauge\n");
+	fprintf(fp, "xdd_info{version=\"%s\",host=\"%s\",pid=\"%d\"} 1\n",
+		PACKAGE_VERSION, planp->hostname.nodename, (int)getpid());
+	fprintf(fp, "# HELP xdd_run_elapsed_seconds Time since the targets started their first pass.\n# TYPE xdd_run_elapsed_seconds gauge\n");
+	fprintf(fp, "xdd_run_elapsed_seconds %.6f\n",
+		(planp->run_start_time && (now > planp->run_start_time)) ? ((double)(now - planp->run_start_time) / FLOAT_BILLION) : 0.0);
+	fprintf(fp, "# HELP xdd_passes Number of passes of the run.\n# TYPE xdd_passes gauge\n");
+	fprintf(fp, "xdd_passes %d\n", planp->passes);
+
+	fprintf(fp, "# HELP xdd_target_pass Current pass of the target.\n# TYPE xdd_target_pass gauge\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		fprintf(fp, "xdd_target_pass{");
+		xdd_metrics_labels(fp, tdp);
+		fprintf(fp, "} %d\n", tdp->td_counters.tc_pass_number);
+	}
+	fprintf(fp, "# HELP xdd_target_state Current state bits of the Target Thread - see TARGET_CURRENT_STATE_*.\n# TYPE xdd_target_state gauge\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		fprintf(fp, "xdd_target_state{");
+		xdd_metrics_labels(fp, tdp);
+		fprintf(fp, "} %d\n", tdp->td_current_state);
+	}
+	fprintf(fp, "# HELP xdd_target_bytes_total Bytes transferred by the target this run.\n# TYPE xdd_target_bytes_total counter\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		fprintf(fp, "xdd_target_bytes_total{");
+		xdd_metrics_labels(fp, planp->target_datap[target_number]);
+		fprintf(fp, "} %llu\n", (unsigned long long)mxp->mx_targets[target_number].mxt_bytes_total);
+	}
+	fprintf(fp, "# HELP xdd_target_ops_total Ops done by the target this run.\n# TYPE xdd_target_ops_total counter\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		fprintf(fp, "xdd_target_ops_total{");
+		xdd_metrics_labels(fp, planp->target_datap[target_number]);
+		fprintf(fp, "} %llu\n", (unsigned long long)mxp->mx_targets[target_number].mxt_ops_total);
+	}
+
+	if (planp->plan_options & PLAN_HISTOGRAM) {
+		// A bucket of the latency histogram only counts toward a bound that none of its op times exceed
+		fprintf(fp, "# HELP xdd_target_op_latency_seconds Time of each read and write op of the target this run.\n# TYPE xdd_target_op_latency_seconds histogram\n");
+		for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+			tdp = planp->target_datap[target_number];
+			mxtp = &mxp->mx_targets[target_number];
+			hp = &mxtp->mxt_hist_total;
+			count = 0;
+			b = 0;
+			for (i = 0; xdd_metrics_latency_buckets[i] > 0.0; i++) {
+				for (; b < XINT_HISTOGRAM_BUCKETS; b++) {
+					if ((double)xdd_histogram_bucket_high(b) > xdd_metrics_latency_buckets[i] * FLOAT_BILLION)
+						break;
+					count += hp->h_buckets[b];
+				}
+				fprintf(fp, "xdd_target_op_latency_seconds_bucket{");
+				xdd_metrics_labels(fp, tdp);
+				fprintf(fp, ",le=\"%g\"} %llu\n", xdd_metrics_latency_buckets[i], (unsigned long long)count);
+			}
+			fprintf(fp, "xdd_target_op_latency_seconds_bucket{");
+			xdd_metrics_labels(fp, tdp);
+			fprintf(fp, ",le=\"+Inf\"} %llu\n", (unsigned long long)hp->h_count);
+			fprintf(fp, "xdd_target_op_latency_seconds_sum{");
+			xdd_metrics_labels(fp, tdp);
+			fprintf(fp, "} %.9f\n", (double)hp->h_total / FLOAT_BILLION);
+			fprintf(fp, "xdd_target_op_latency_seconds_count{");
+			xdd_metrics_labels(fp, tdp);
+			fprintf(fp, "} %llu\n", (unsigned long long)hp->h_count);
+		}
+	}
+
+	fprintf(fp, "# HELP xdd_worker_state Current state bits of the Worker Thread - see WORKER_CURRENT_STATE_*.\n# TYPE xdd_worker_state gauge\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+			fprintf(fp, "xdd_worker_state{");
+			xdd_metrics_labels(fp, tdp);
+			fprintf(fp, ",worker=\"%d\"} %u\n", wdp->wd_worker_number, wdp->wd_current_state);
+		}
+	}
+	fprintf(fp, "# HELP xdd_worker_pass_ops Ops done by the Worker Thread so far this pass.\n# TYPE xdd_worker_pass_ops gauge\n");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+			fprintf(fp, "xdd_worker_pass_ops{");
+			xdd_metrics_labels(fp, tdp);
+			fprintf(fp, ",worker=\"%d\"} %llu\n", wdp->wd_worker_number,
+				(unsigned long long)wdp->wd_counters.tc_accumulated_op_count);
+		}
+	}
+} // End of xdd_metrics_format()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_send() - Send all of a buffer to a client
+ * Return values: 0 is good, -1 if the client went away
+ */
+static int
+xdd_metrics_send(int fd, char *bufp, size_t len) {
+	ssize_t	sent;
+
+
+	while (len > 0) {
+		sent = send(fd, bufp, len, XINT_METRICS_SEND_FLAGS);
+		if (sent <= 0) {
+			if ((sent < 0) && (errno == EINTR))
+				continue;
+			return(-1);
+		}
+		bufp += sent;
+		len -= sent;
+	}
+	return(0);
+} // End of xdd_metrics_send()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_answer() - Read the request of a client and answer it
+ * Any GET of / or /metrics gets the metrics.
+ */
+static void
+xdd_metrics_answer(xint_metrics_t *mxp, int fd) {
+	char			request[XINT_METRICS_REQUEST_SIZE];
+	char			header[256];
+	char			*bodyp;
+	size_t			body_size;
+	size_t			len;
+	ssize_t			got;
+	struct timeval	timeout;
+	FILE			*fp;
+
+
+	timeout.tv_sec = XINT_METRICS_TIMEOUT;
+	timeout.tv_usec = 0;
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+	// Only the request line matters but the whole header is read before answering
+	len = 0;
+	while (len < sizeof(request) - 1) {
+		got = recv(fd, request + len, sizeof(request) - 1 - len, 0);
+		if (got <= 0)
+			break;
+		len += got;
+		request[len] = '\0';
+		if (strstr(request, "\r\n\r\n") || strstr(request, "\n\n"))
+			break;
+	}
+	request[len] = '\0';
+	if (strncmp(request, "GET ", 4) != 0) {
+		snprintf(header, sizeof(header), "HTTP/1.0 405 Method Not Allowed\r\nAllow: GET\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+		xdd_metrics_send(fd, header, strlen(header));
+		return;
+	}
+	if ((strncmp(request + 4, "/ ", 2) != 0) && (strncmp(request + 4, "/metrics", 8) != 0)) {
+		snprintf(header, sizeof(header), "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+		xdd_metrics_send(fd, header, strlen(header));
+		return;
+	}
+
+	bodyp = NULL;
+	body_size = 0;
+	fp = open_memstream(&bodyp, &body_size);
+	if (fp == NULL) {
+		snprintf(header, sizeof(header), "HTTP/1.0 500 Internal Server Error\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+		xdd_metrics_send(fd, header, strlen(header));
+		return;
+	}
+	pthread_mutex_lock(&mxp->mx_mutex);
+	xdd_metrics_observe(mxp, 0);
+	xdd_metrics_format(mxp, fp);
+	pthread_mutex_unlock(&mxp->mx_mutex);
+	fclose(fp);
+
+	snprintf(header, sizeof(header), "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: %llu\r\nConnection: close\r\n\r\n",
+		(unsigned long long)body_size);
+	if (xdd_metrics_send(fd, header, strlen(header)) == 0)
+		xdd_metrics_send(fd, bodyp, body_size);
+	free(bodyp);
+} // End of xdd_metrics_answer()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_thread() - Answer requests until told to exit
+ */
+static void *
+xdd_metrics_thread(void *data) {
+	xint_metrics_t	*mxp;
+	fd_set			readset;
+	struct timeval	timeout;
+	int				fd;
+	int				shutdown;
+
+
+	mxp = (xint_metrics_t *)data;
+#if (LINUX)
+	// Stay out of the way of the Target and Worker Threads
+	setpriority(PRIO_PROCESS, syscall(SYS_gettid), 19);
+#endif
+	shutdown = 0;
+	while (!shutdown) {
+		FD_ZERO(&readset);
+		FD_SET(mxp->mx_listen_fd, &readset);
+		timeout.tv_sec = 0;
+		timeout.tv_usec = XINT_METRICS_POLL_INTERVAL;
+		if (select(mxp->mx_listen_fd + 1, &readset, NULL, NULL, &timeout) > 0) {
+			fd = accept(mxp->mx_listen_fd, NULL, NULL);
+			if (fd >= 0) {
+				xdd_metrics_answer(mxp, fd);
+				close(fd);
+			}
+		}
+		pthread_mutex_lock(&mxp->mx_mutex);
+		shutdown = mxp->mx_shutdown;
+		pthread_mutex_unlock(&mxp->mx_mutex);
+	}
+	return(0);
+} // End of xdd_metrics_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_listen() - Open the socket the requests come in on.
+ * An address with a '/' in it is the path name of a UNIX socket, otherwise
+ * it is [address:]port with 127.0.0.1 as the default address.
+ * Return values: The socket or -1 if it cannot be opened
+ */
+static int
+xdd_metrics_listen(xint_metrics_t *mxp, char *addressp) {
+	struct sockaddr_in	sin;
+	struct sockaddr_un	sun;
+	struct stat			statbuf;
+	char				host[64];
+	char				*portp;
+	int					fd;
+	int					on;
+
+
+	if (strchr(addressp, '/')) {
+		if (strlen(addressp) >= sizeof(sun.sun_path)) {
+			fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: UNIX socket path name '%s' is too long\n",
+				xgp->progname, addressp);
+			return(-1);
+		}
+		memset(&sun, 0, sizeof(sun));
+		sun.sun_family = AF_UNIX;
+		strcpy(sun.sun_path, addressp);
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd < 0)
+			return(-1);
+		// A socket left behind by an earlier run is in the way, but nothing else is removed
+		if (lstat(addressp, &statbuf) == 0) {
+			if (!S_ISSOCK(statbuf.st_mode)) {
+				fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: '%s' already exists and is not a socket\n",
+					xgp->progname, addressp);
+				close(fd);
+				return(-1);
+			}
+			unlink(addressp);
+		}
+		if ((bind(fd, (struct sockaddr *)&sun, sizeof(sun)) < 0) || (listen(fd, 8) < 0)) {
+			close(fd);
+			return(-1);
+		}
+		mxp->mx_unix_path = addressp;
+		return(fd);
+	}
+
+	memset(&sin, 0, sizeof(sin));
+	sin.sin_family = AF_INET;
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	portp = strrchr(addressp, ':');
+	if (portp) {
+		if ((size_t)(portp - addressp) >= sizeof(host)) {
+			fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: Address '%s' is too long\n",
+				xgp->progname, addressp);
+			return(-1);
+		}
+		memcpy(host, addressp, portp - addressp);
+		host[portp - addressp] = '\0';
+		portp++;
+		if (inet_pton(AF_INET, host, &sin.sin_addr) != 1) {
+			fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: '%s' is not an IPv4 address\n",
+				xgp->progname, host);
+			return(-1);
+		}
+	} else portp = addressp;
+	if ((atoi(portp) <= 0) || (atoi(portp) > 65535)) {
+		fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: '%s' is not a port number\n",
+			xgp->progname, portp);
+		return(-1);
+	}
+	sin.sin_port = htons(atoi(portp));
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0)
+		return(-1);
+	on = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	if ((bind(fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) || (listen(fd, 8) < 0)) {
+		close(fd);
+		return(-1);
+	}
+	return(fd);
+} // End of xdd_metrics_listen()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_start() - Open the socket and start the server thread.
+ * The server thread always runs with the normal time sharing policy so that
+ * it does not inherit a real time priority given to xdd.
+ * This is called by xdd_start_plan() once the Target Threads are up.
+ * If something goes wrong this displays an ERROR and the run goes on without
+ * the metrics.
+ */
+void
+xdd_metrics_start(xdd_plan_t *planp) {
+	xint_metrics_t		*mxp;
+	pthread_attr_t		attr;
+	struct sched_param	param;
+	int32_t				status;
+
+
+	if (!(planp->plan_options & PLAN_METRICS))
+		return;
+	mxp = (xint_metrics_t *)calloc(1, sizeof(xint_metrics_t));
+	if (mxp)
+		mxp->mx_targets = (xint_metrics_target_t *)calloc(planp->number_of_targets, sizeof(xint_metrics_target_t));
+	if ((mxp == NULL) || (mxp->mx_targets == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: Cannot allocate memory for the metrics of %d targets\n",
+			xgp->progname, planp->number_of_targets);
+		free(mxp);
+		return;
+	}
+	mxp->mx_planp = planp;
+	mxp->mx_listen_fd = xdd_metrics_listen(mxp, planp->metrics_address);
+	if (mxp->mx_listen_fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: Cannot listen for metrics requests on '%s'\n",
+			xgp->progname, planp->metrics_address);
+		perror("Reason");
+		free(mxp->mx_targets);
+		free(mxp);
+		return;
+	}
+
+	pthread_mutex_init(&mxp->mx_mutex, 0);
+	pthread_attr_init(&attr);
+	memset(&param, 0, sizeof(param));
+	pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+	pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+	pthread_attr_setschedparam(&attr, &param);
+	status = pthread_create(&mxp->mx_thread, &attr, xdd_metrics_thread, mxp);
+	pthread_attr_destroy(&attr);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_metrics_start: ERROR: Cannot create the metrics thread\n",
+			xgp->progname);
+		close(mxp->mx_listen_fd);
+		if (mxp->mx_unix_path)
+			unlink(mxp->mx_unix_path);
+		free(mxp->mx_targets);
+		free(mxp);
+		return;
+	}
+	planp->metricsp = mxp;
+} // End of xdd_metrics_start()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_pass_end() - Add the last ops of the pass to the totals of the
+ * run before the counters and histograms are emptied.
+ * This is called by the Results Manager at the end of each pass.
+ */
+void
+xdd_metrics_pass_end(xdd_plan_t *planp) {
+	xint_metrics_t	*mxp;
+
+
+	mxp = planp->metricsp;
+	if (mxp == NULL)
+		return;
+	pthread_mutex_lock(&mxp->mx_mutex);
+	xdd_metrics_observe(mxp, 1);
+	pthread_mutex_unlock(&mxp->mx_mutex);
+} // End of xdd_metrics_pass_end()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_metrics_stop() - Stop the server thread and close the socket
+ * This is called by the Results Manager at the end of the run.
+ */
+void
+xdd_metrics_stop(xdd_plan_t *planp) {
+	xint_metrics_t	*mxp;
+
+
+	mxp = planp->metricsp;
+	if (mxp == NULL)
+		return;
+	pthread_mutex_lock(&mxp->mx_mutex);
+	mxp->mx_shutdown = 1;
+	pthread_mutex_unlock(&mxp->mx_mutex);
+	pthread_join(mxp->mx_thread, NULL);
+	close(mxp->mx_listen_fd);
+	if (mxp->mx_unix_path)
+		unlink(mxp->mx_unix_path);
+	free(mxp->mx_targets);
+	free(mxp);
+	planp->metricsp = NULL;
+} // End of xdd_metrics_stop()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -3,11 +3,18 @@
 #
 DIR := src/base
 
-BASE_SRC := $(DIR)/heartbeat.c \
+BASE_SRC := $(DIR)/checksum.c \
+	$(DIR)/compound.c \
+	$(DIR)/heartbeat.c \
+	$(DIR)/histogram.c \
 	$(DIR)/io_buffers.c \
 	$(DIR)/lockstep.c \
+	$(DIR)/manifest.c \
+	$(DIR)/metrics.c \
+	$(DIR)/prefill.c \
 	$(DIR)/restart.c \
 	$(DIR)/schedule.c \
+	$(DIR)/shmstats.c \
 	$(DIR)/target_cleanup.c \
 	$(DIR)/target_init.c \
 	$(DIR)/target_offset_table.c \
@@ -19,7 +26,12 @@ BASE_SRC := $(DIR)/heartbeat.c \
 	$(DIR)/target_ttd_after_pass.c \
 	$(DIR)/target_ttd_before_io_op.c \
 	$(DIR)/target_ttd_before_pass.c \
+	$(DIR)/timeseries.c \
+	$(DIR)/timestamp_sample.c \
+	$(DIR)/timestamp_stream.c \
 	$(DIR)/verify.c \
+	$(DIR)/verify_pool.c \
+	$(DIR)/worker_state.c \
 	$(DIR)/worker_thread.c \
 	$(DIR)/worker_thread_cleanup.c \
 	$(DIR)/worker_thread_init.c \
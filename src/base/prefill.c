@@ -0,0 +1,326 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the write buffer prefill ring used
+ * by the -prefill option.
+ * For data patterns that change from op to op (sequenced and random by offset)
+ * a prefill thread walks the seek list ahead of the Worker Threads and fills
+ * a ring of buffers with the data of the next write ops. A Worker Thread that
+ * is about to write trades its buffer for the filled buffer of its op, which
+ * takes the pattern generation off the I/O path. Op N always uses slot N
+ * modulo the number of slots so the prefill thread can never get more than
+ * one ring ahead of the Worker Threads.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_thread() - The main loop of the prefill thread of a target.
+ * While a pass is running the ops of the seek list are looked at in order.
+ * Write ops get their data put into the slot of the op as soon as that slot
+ * is free. Other ops are skipped.
+ */
+void *
+xdd_prefill_thread(void *data) {
+	xint_prefill_t		*pfp;
+	xint_prefill_slot_t	*psp;
+	target_data_t		*tdp;
+	int64_t				op;
+	uint64_t			byte_offset;
+	size_t				xfer_size;
+	seek_t				*sp;
+	nclk_t				start_time;
+	nclk_t				end_time;
+
+
+	pfp = (xint_prefill_t *)data;
+	tdp = pfp->pf_tdp;
+	pthread_mutex_lock(&pfp->pf_mutex);
+	for (;;) {
+		while (!pfp->pf_shutdown &&
+			(!pfp->pf_active ||
+			 (pfp->pf_next_op >= tdp->td_seekhdr.seek_total_ops) ||
+			 (pfp->pf_slots[pfp->pf_next_op % pfp->pf_buffers].ps_state != XDD_PREFILL_SLOT_FREE)))
+			pthread_cond_wait(&pfp->pf_cond, &pfp->pf_mutex);
+		if (pfp->pf_shutdown)
+			break;
+		op = pfp->pf_next_op++;
+		sp = &tdp->td_seekhdr.seeks[op];
+		if ((sp->operation != SO_OP_WRITE) && (sp->operation != SO_OP_READ_MODIFY_WRITE) && (sp->operation != SO_OP_WRITE_VERIFY))
+			continue;
+
+		// Same location and size as xdd_target_ttd_before_io_op() and xdd_target_pass_task_setup() will use
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_NONE)
+			sp = &tdp->td_seekhdr.seeks[0];
+		byte_offset = (uint64_t)((tdp->td_target_number * tdp->td_planp->target_offset) + sp->block_location) * tdp->td_block_size;
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE)
+			xfer_size = (size_t)tdp->td_seekhdr.seeks[op].reqsize * tdp->td_block_size;
+		else xfer_size = tdp->td_xfer_size;
+		if (xfer_size > (size_t)pfp->pf_buf_size)
+			continue; // Cannot happen but the Worker Thread will simply fill its own buffer
+
+		psp = &pfp->pf_slots[op % pfp->pf_buffers];
+		psp->ps_state = XDD_PREFILL_SLOT_FILLING;
+		pthread_mutex_unlock(&pfp->pf_mutex);
+
+		nclk_now(&start_time);
+		xdd_datapattern_fill_buffer(tdp, psp->ps_bufp, byte_offset, xfer_size);
+		nclk_now(&end_time);
+
+		pthread_mutex_lock(&pfp->pf_mutex);
+		pfp->pf_fill_time += (end_time - start_time);
+		if (pfp->pf_active) {
+			psp->ps_op_number = op;
+			psp->ps_byte_offset = byte_offset;
+			psp->ps_xfer_size = xfer_size;
+			psp->ps_state = XDD_PREFILL_SLOT_READY;
+		} else psp->ps_state = XDD_PREFILL_SLOT_FREE; // The pass ended while filling
+		pthread_cond_broadcast(&pfp->pf_cond);
+	}
+	pthread_mutex_unlock(&pfp->pf_mutex);
+	return(0);
+} // End of xdd_prefill_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_init() - Allocate the prefill ring of a target and start its
+ * prefill thread. The ring is only used for data patterns that change from
+ * op to op, and not for E2E targets where the data comes from the network.
+ * The buffers are the same size as the I/O buffers of the Worker Threads.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_prefill_init(target_data_t *tdp) {
+	xint_prefill_t	*pfp;
+	int32_t			i;
+	int				status;
+
+
+	pfp = tdp->td_pfp;
+	if ((pfp == NULL) || (pfp->pf_buffers <= 0))
+		return(0);
+	if (!(tdp->td_dpp->data_pattern_options & (DP_SEQUENCED_PATTERN | DP_RANDOM_BY_OFFSET_PATTERN)) ||
+		(tdp->td_target_options & TO_ENDTOEND) || (tdp->td_rwratio >= 1.0)) {
+		free(pfp);
+		tdp->td_pfp = NULL;
+		return(0);
+	}
+	pfp->pf_tdp = tdp;
+	pfp->pf_buf_size = tdp->td_xfer_size;
+	if ((tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) && (tdp->td_seekhdr.seek_iosize > (uint32_t)pfp->pf_buf_size))
+		pfp->pf_buf_size = tdp->td_seekhdr.seek_iosize;
+	pfp->pf_buf_size = ((pfp->pf_buf_size + getpagesize() - 1) / getpagesize()) * getpagesize();
+	pfp->pf_slots = (xint_prefill_slot_t *)calloc(pfp->pf_buffers, sizeof(xint_prefill_slot_t));
+	if (pfp->pf_slots == NULL) {
+		fprintf(xgp->errout,"%s: xdd_prefill_init: Target %d: ERROR: Cannot allocate memory for %d prefill slots\n",
+			xgp->progname, tdp->td_target_number, pfp->pf_buffers);
+		return(-1);
+	}
+	// The buffers are traded with the Worker Threads so they have to be the same kind as theirs
+	for (i = 0; i < pfp->pf_buffers; i++) {
+		pfp->pf_slots[i].ps_bufp = xdd_io_buffer_alloc(tdp, pfp->pf_buf_size);
+		if (pfp->pf_slots[i].ps_bufp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_prefill_init: Target %d: ERROR: Cannot allocate %d bytes of memory for prefill buffer %d\n",
+				xgp->progname, tdp->td_target_number, pfp->pf_buf_size, i);
+			return(-1);
+		}
+	}
+	pthread_mutex_init(&pfp->pf_mutex, 0);
+	pthread_cond_init(&pfp->pf_cond, 0);
+	pfp->pf_active = 0;
+	pfp->pf_shutdown = 0;
+	status = pthread_create(&pfp->pf_thread, NULL, xdd_prefill_thread, pfp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_prefill_init: Target %d: ERROR: Cannot create the prefill thread\n",
+			xgp->progname, tdp->td_target_number);
+		perror("Reason");
+		return(-1);
+	}
+	pfp->pf_started = 1;
+	return(0);
+} // End of xdd_prefill_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_start_pass() - Let the prefill thread go through the seek list
+ * of the pass that is about to start.
+ */
+void
+xdd_prefill_start_pass(target_data_t *tdp) {
+	xint_prefill_t	*pfp;
+	int32_t			i;
+
+
+	pfp = tdp->td_pfp;
+	if ((pfp == NULL) || !pfp->pf_started)
+		return;
+	pthread_mutex_lock(&pfp->pf_mutex);
+	for (i = 0; i < pfp->pf_buffers; i++)
+		pfp->pf_slots[i].ps_state = XDD_PREFILL_SLOT_FREE;
+	pfp->pf_next_op = 0;
+	pfp->pf_active = 1;
+	pthread_cond_broadcast(&pfp->pf_cond);
+	pthread_mutex_unlock(&pfp->pf_mutex);
+} // End of xdd_prefill_start_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_end_pass() - Stop the prefill thread at the end of a pass and
+ * wait for it to finish the buffer it may be filling. The seek list may be
+ * changed for the next pass after this.
+ */
+void
+xdd_prefill_end_pass(target_data_t *tdp) {
+	xint_prefill_t	*pfp;
+	int32_t			i;
+
+
+	pfp = tdp->td_pfp;
+	if ((pfp == NULL) || !pfp->pf_started)
+		return;
+	pthread_mutex_lock(&pfp->pf_mutex);
+	pfp->pf_active = 0;
+	pthread_cond_broadcast(&pfp->pf_cond);
+	for (i = 0; i < pfp->pf_buffers; i++) {
+		while (pfp->pf_slots[i].ps_state == XDD_PREFILL_SLOT_FILLING)
+			pthread_cond_wait(&pfp->pf_cond, &pfp->pf_mutex);
+	}
+	pthread_mutex_unlock(&pfp->pf_mutex);
+} // End of xdd_prefill_end_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_take() - Trade the buffer of this Worker Thread for the
+ * prefilled buffer of its write op. If the prefill thread has not got to
+ * this op yet then this waits for it. A slot still held by an older op that
+ * was not taken is given back to the prefill thread; that op will fill its
+ * own buffer if it ever gets here.
+ * Return values: 0 if the buffer now holds the data of the op, -1 if the
+ *                caller has to fill the buffer itself.
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+int32_t
+xdd_prefill_take(worker_data_t *wdp) {
+	xint_prefill_t		*pfp;
+	xint_prefill_slot_t	*psp;
+	unsigned char		*bufp;
+	int64_t				op;
+	int32_t				waited;
+	nclk_t				wait_start;
+	nclk_t				wait_end;
+
+
+	pfp = wdp->wd_tdp->td_pfp;
+	op = (int64_t)wdp->wd_task.task_op_number;
+	psp = &pfp->pf_slots[op % pfp->pf_buffers];
+	waited = 0;
+	wait_start = 0;
+	pthread_mutex_lock(&pfp->pf_mutex);
+	while (pfp->pf_active) {
+		if ((psp->ps_state == XDD_PREFILL_SLOT_READY) && (psp->ps_op_number >= op))
+			break;
+		if ((psp->ps_state == XDD_PREFILL_SLOT_READY) && (psp->ps_op_number < op)) {
+			// An older op never took this slot - give it back to the prefill thread
+			psp->ps_state = XDD_PREFILL_SLOT_FREE;
+			pthread_cond_broadcast(&pfp->pf_cond);
+		}
+		if ((psp->ps_state == XDD_PREFILL_SLOT_FREE) && (pfp->pf_next_op > op)) // The prefill thread has gone past this op
+			break;
+		if (!waited) {
+			waited = 1;
+			pfp->pf_waits++;
+			nclk_now(&wait_start);
+		}
+		pthread_cond_wait(&pfp->pf_cond, &pfp->pf_mutex);
+	}
+	if (waited) {
+		nclk_now(&wait_end);
+		pfp->pf_wait_time += (wait_end - wait_start);
+	}
+	if (!pfp->pf_active || (psp->ps_state != XDD_PREFILL_SLOT_READY) || (psp->ps_op_number != op) ||
+		(psp->ps_byte_offset != (uint64_t)wdp->wd_task.task_byte_offset) || (psp->ps_xfer_size < wdp->wd_task.task_xfer_size)) {
+		pfp->pf_inline++;
+		pthread_mutex_unlock(&pfp->pf_mutex);
+		return(-1);
+	}
+	// Trade buffers - the buffer of the Worker Thread is filled for a later op
+	bufp = psp->ps_bufp;
+	psp->ps_bufp = wdp->wd_bufp;
+	psp->ps_state = XDD_PREFILL_SLOT_FREE;
+	pfp->pf_prefilled++;
+	pthread_cond_broadcast(&pfp->pf_cond);
+	pthread_mutex_unlock(&pfp->pf_mutex);
+	wdp->wd_bufp = bufp;
+	wdp->wd_task.task_datap = bufp;
+	return(0);
+} // End of xdd_prefill_take()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_destroy() - Stop the prefill thread, wait for it to exit, and
+ * free the ring. Some of the buffers in the slots may have started out as
+ * buffers of the Worker Threads but each trade leaves as many buffers in the
+ * ring as were allocated for it, and all of them are the same kind.
+ */
+void
+xdd_prefill_destroy(target_data_t *tdp) {
+	xint_prefill_t	*pfp;
+	int32_t			i;
+
+
+	pfp = tdp->td_pfp;
+	if (pfp == NULL)
+		return;
+	if (pfp->pf_started) {
+		pthread_mutex_lock(&pfp->pf_mutex);
+		pfp->pf_active = 0;
+		pfp->pf_shutdown = 1;
+		pthread_cond_broadcast(&pfp->pf_cond);
+		pthread_mutex_unlock(&pfp->pf_mutex);
+		pthread_join(pfp->pf_thread, NULL);
+		pthread_mutex_destroy(&pfp->pf_mutex);
+		pthread_cond_destroy(&pfp->pf_cond);
+		pfp->pf_started = 0;
+	}
+	if (pfp->pf_slots) {
+		for (i = 0; i < pfp->pf_buffers; i++)
+			xdd_io_buffer_free(tdp, pfp->pf_slots[i].ps_bufp, pfp->pf_buf_size);
+		free(pfp->pf_slots);
+	}
+	free(pfp);
+	tdp->td_pfp = NULL;
+} // End of xdd_prefill_destroy()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_prefill_display() - Display how many write buffers of a target came
+ * prefilled over the run and how long the prefill thread and the Worker
+ * Threads spent on them
+ * Called by xdd_process_run_results()
+ */
+void
+xdd_prefill_display(FILE *out, target_data_t *tdp) {
+	xint_prefill_t	*pfp;
+
+
+	pfp = tdp->td_pfp;
+	fprintf(out,"Target %d prefill, %llu, buffers prefilled, %llu, buffers filled inline, %.3f, seconds filling, %llu, waits for a buffer, %.3f, seconds waiting\n",
+		tdp->td_target_number, (unsigned long long)pfp->pf_prefilled, (unsigned long long)pfp->pf_inline,
+		(double)pfp->pf_fill_time / FLOAT_BILLION,
+		(unsigned long long)pfp->pf_waits, (double)pfp->pf_wait_time / FLOAT_BILLION);
+} // End of xdd_prefill_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
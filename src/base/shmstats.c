@@ -0,0 +1,297 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of -shmstats which keeps the counters
+ * and current state of every target and Worker Thread in a POSIX shared
+ * memory segment that other programs can read while the run goes on.
+ * See xint_shmstats.h for the layout of the segment.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_shmstats_barrier_name() - Copy the name of the barrier a thread is in.
+ * The barrier pointer is read once since the thread can leave the barrier
+ * at any time.
+ */
+static void
+xdd_shmstats_barrier_name(char *namep, xdd_barrier_t *bp) {
+	if (bp == NULL) {
+		namep[0] = '\0';
+		return;
+	}
+	memcpy(namep, bp->name, XDD_BARRIER_MAX_NAME_LENGTH);
+	namep[XDD_BARRIER_MAX_NAME_LENGTH - 1] = '\0';
+} // End of xdd_shmstats_barrier_name()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_shmstats_update() - Copy the counters and state of every target and
+ * Worker Thread into the segment. The Target and Worker Data are read without
+ * locking them. The sequence number is odd while the copy is under way so that
+ * a reader can tell when it has to read again.
+ */
+static void
+xdd_shmstats_update(xint_shmstats_t *shmp, int32_t run_state) {
+	xdd_plan_t				*planp;
+	xint_shmstats_header_t	*hdrp;
+	xint_shmstats_target_t	*stp;
+	xint_shmstats_worker_t	*swp;
+	target_data_t			*tdp;
+	worker_data_t			*wdp;
+	nclk_t					now;
+	int						target_number;
+	int						w;
+
+
+	planp = shmp->shm_planp;
+	hdrp = shmp->shm_hdrp;
+	nclk_now(&now);
+	hdrp->shh_sequence++;
+	__sync_synchronize();
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		stp = &shmp->shm_targets[target_number];
+		stp->shs_pass_number = tdp->td_counters.tc_pass_number;
+		stp->shs_current_state = tdp->td_current_state;
+		stp->shs_bytes = tdp->td_counters.tc_accumulated_bytes_xfered;
+		stp->shs_ops = tdp->td_counters.tc_accumulated_op_count;
+		stp->shs_pass_start_time = (tdp->td_counters.tc_pass_start_time > planp->run_start_time) ?
+			(tdp->td_counters.tc_pass_start_time - planp->run_start_time) : 0;
+		xdd_shmstats_barrier_name(stp->shs_barrier, tdp->td_current_barrier);
+
+		swp = &shmp->shm_workers[stp->shs_first_worker];
+		for (w = 0, wdp = tdp->td_next_wdp; wdp && (w < stp->shs_number_of_workers); w++, wdp = wdp->wd_next_wdp, swp++) {
+			swp->shw_worker_number = wdp->wd_worker_number;
+			swp->shw_thread_id = wdp->wd_thread_id;
+			swp->shw_current_state = wdp->wd_current_state;
+			swp->shw_bytes = wdp->wd_counters.tc_accumulated_bytes_xfered;
+			swp->shw_ops = wdp->wd_counters.tc_accumulated_op_count;
+			swp->shw_op_number = wdp->wd_task.task_op_number;
+			swp->shw_byte_offset = wdp->wd_task.task_byte_offset;
+			xdd_shmstats_barrier_name(swp->shw_barrier, wdp->wd_current_barrier);
+		}
+	}
+	if ((run_state == XINT_SHMSTATS_RUN_STARTING) && planp->run_start_time)
+		run_state = XINT_SHMSTATS_RUN_RUNNING;
+	hdrp->shh_run_state = run_state;
+	hdrp->shh_update_time = (planp->run_start_time && (now > planp->run_start_time)) ? (now - planp->run_start_time) : 0;
+	hdrp->shh_update_count++;
+	__sync_synchronize();
+	hdrp->shh_sequence++;
+} // End of xdd_shmstats_update()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_shmstats_thread() - Update the segment every XINT_SHMSTATS_INTERVAL
+ * until told to exit
+ */
+static void *
+xdd_shmstats_thread(void *data) {
+	xint_shmstats_t		*shmp;
+	struct timespec		wakeup;
+	int					shutdown;
+
+
+	shmp = (xint_shmstats_t *)data;
+	clock_gettime(CLOCK_REALTIME, &wakeup);
+	shutdown = 0;
+	while (!shutdown) {
+		wakeup.tv_nsec += XINT_SHMSTATS_INTERVAL % BILLION;
+		wakeup.tv_sec += (XINT_SHMSTATS_INTERVAL / BILLION) + (wakeup.tv_nsec / BILLION);
+		wakeup.tv_nsec %= BILLION;
+		pthread_mutex_lock(&shmp->shm_mutex);
+		while (!shmp->shm_shutdown) {
+			if (pthread_cond_timedwait(&shmp->shm_cond, &shmp->shm_mutex, &wakeup) == ETIMEDOUT)
+				break;
+		}
+		shutdown = shmp->shm_shutdown;
+		if (!shutdown)
+			xdd_shmstats_update(shmp, XINT_SHMSTATS_RUN_STARTING);
+		pthread_mutex_unlock(&shmp->shm_mutex);
+	}
+	return(0);
+} // End of xdd_shmstats_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_shmstats_start() - Create the segment, fill in what does not change
+ * during the run, and start the updater thread.
+ * This is called by xdd_start_plan() once the Target Threads are up.
+ * If something goes wrong this displays an ERROR and the run goes on without
+ * the segment.
+ */
+void
+xdd_shmstats_start(xdd_plan_t *planp) {
+	xint_shmstats_t			*shmp;
+	xint_shmstats_header_t	*hdrp;
+	xint_shmstats_target_t	*stp;
+	xint_shmstats_worker_t	*swp;
+	target_data_t			*tdp;
+	worker_data_t			*wdp;
+	char					*namep;
+	size_t					len;
+	int32_t					number_of_workers;
+	int32_t					status;
+	int						fd;
+	int						target_number;
+	int						w;
+
+
+	if (!(planp->plan_options & PLAN_SHMSTATS))
+		return;
+	shmp = (xint_shmstats_t *)calloc(1, sizeof(xint_shmstats_t));
+	if (shmp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_shmstats_start: ERROR: Cannot allocate memory for the live statistics\n",
+			xgp->progname);
+		return;
+	}
+	shmp->shm_planp = planp;
+	if (planp->shmstats_name)
+		snprintf(shmp->shm_name, sizeof(shmp->shm_name), "%s%s",
+			(planp->shmstats_name[0] == '/') ? "" : "/", planp->shmstats_name);
+	else snprintf(shmp->shm_name, sizeof(shmp->shm_name), "/xdd.%d", (int)getpid());
+
+	number_of_workers = 0;
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++)
+		number_of_workers += planp->target_datap[target_number]->td_queue_depth;
+	shmp->shm_size = sizeof(xint_shmstats_header_t) +
+		(planp->number_of_targets * sizeof(xint_shmstats_target_t)) +
+		(number_of_workers * sizeof(xint_shmstats_worker_t));
+
+	// Never take over a segment that another run or program is using
+	fd = shm_open(shmp->shm_name, O_CREAT|O_EXCL|O_RDWR, 0644);
+	if (fd < 0) {
+		if (errno == EEXIST)
+			fprintf(xgp->errout,"%s: xdd_shmstats_start: ERROR: Shared memory segment '%s' already exists - remove it or give -shmstats another name\n",
+				xgp->progname, shmp->shm_name);
+		else {
+			fprintf(xgp->errout,"%s: xdd_shmstats_start: ERROR: Cannot create shared memory segment '%s'\n",
+				xgp->progname, shmp->shm_name);
+			perror("Reason");
+		}
+		free(shmp);
+		return;
+	}
+	if (ftruncate(fd, shmp->shm_size) < 0) {
+		fprintf(xgp->errout,"%s: xdd_shmstats_start: ERROR: Cannot make shared memory segment '%s' %lld bytes long\n",
+			xgp->progname, shmp->shm_name, (long long int)shmp->shm_size);
+		perror("Reason");
+		close(fd);
+		shm_unlink(shmp->shm_name);
+		free(shmp);
+		return;
+	}
+	shmp->shm_hdrp = (xint_shmstats_header_t *)mmap(NULL, shmp->shm_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (shmp->shm_hdrp == MAP_FAILED) {
+		fprintf(xgp->errout,"%s: xdd_shmstats_start: ERROR: Cannot map shared memory segment '%s'\n",
+			xgp->progname, shmp->shm_name);
+		perror("Reason");
+		shm_unlink(shmp->shm_name);
+		free(shmp);
+		return;
+	}
+	shmp->shm_targets = (xint_shmstats_target_t *)(shmp->shm_hdrp + 1);
+	shmp->shm_workers = (xint_shmstats_worker_t *)(shmp->shm_targets + planp->number_of_targets);
+
+	// Fill in what does not change during the run - ftruncate() zeroed the rest
+	hdrp = shmp->shm_hdrp;
+	hdrp->shh_version = XINT_SHMSTATS_VERSION;
+	hdrp->shh_header_size = sizeof(xint_shmstats_header_t);
+	hdrp->shh_target_size = sizeof(xint_shmstats_target_t);
+	hdrp->shh_worker_size = sizeof(xint_shmstats_worker_t);
+	hdrp->shh_number_of_targets = planp->number_of_targets;
+	hdrp->shh_number_of_workers = number_of_workers;
+	hdrp->shh_pid = (int32_t)getpid();
+	hdrp->shh_interval = XINT_SHMSTATS_INTERVAL;
+	hdrp->shh_run_state = XINT_SHMSTATS_RUN_STARTING;
+	hdrp->shh_passes = planp->passes;
+	strncpy(hdrp->shh_hostname, planp->hostname.nodename, XINT_SHMSTATS_NAME_LENGTH - 1);
+	number_of_workers = 0;
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		stp = &shmp->shm_targets[target_number];
+		stp->shs_target_number = target_number;
+		stp->shs_queue_depth = tdp->td_queue_depth;
+		stp->shs_first_worker = number_of_workers;
+		stp->shs_number_of_workers = tdp->td_queue_depth;
+		stp->shs_target_ops = tdp->td_target_ops;
+		// Keep the end of a long path name since that is the part that differs
+		namep = (tdp->td_target_full_pathname) ? tdp->td_target_full_pathname : "";
+		len = strlen(namep);
+		if (len >= XINT_SHMSTATS_NAME_LENGTH)
+			namep += len - (XINT_SHMSTATS_NAME_LENGTH - 1);
+		strncpy(stp->shs_target_name, namep, XINT_SHMSTATS_NAME_LENGTH - 1);
+		swp = &shmp->shm_workers[number_of_workers];
+		for (w = 0, wdp = tdp->td_next_wdp; w < tdp->td_queue_depth; w++, swp++) {
+			swp->shw_target_number = target_number;
+			swp->shw_worker_number = (wdp) ? wdp->wd_worker_number : w;
+			if (wdp)
+				wdp = wdp->wd_next_wdp;
+		}
+		number_of_workers += tdp->td_queue_depth;
+	}
+	xdd_shmstats_update(shmp, XINT_SHMSTATS_RUN_STARTING);
+	// Readers check the magic number last so it goes in once the rest is there
+	__sync_synchronize();
+	hdrp->shh_magic = XINT_SHMSTATS_MAGIC;
+
+	pthread_mutex_init(&shmp->shm_mutex, 0);
+	pthread_cond_init(&shmp->shm_cond, 0);
+	status = pthread_create(&shmp->shm_thread, NULL, xdd_shmstats_thread, shmp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_shmstats_start: ERROR: Cannot create the live statistics thread\n",
+			xgp->progname);
+		munmap(shmp->shm_hdrp, shmp->shm_size);
+		shm_unlink(shmp->shm_name);
+		free(shmp);
+		return;
+	}
+	planp->shmstatsp = shmp;
+} // End of xdd_shmstats_start()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_shmstats_stop() - Stop the updater thread, make the last update, and
+ * remove the segment.
+ * The name is removed right after the RUN_DONE update. A reader that has the
+ * segment mapped keeps it and sees RUN_DONE; one that has not mapped it yet
+ * finds no segment, which also means the run is over.
+ * This is called by the Results Manager at the end of the run.
+ */
+void
+xdd_shmstats_stop(xdd_plan_t *planp) {
+	xint_shmstats_t	*shmp;
+
+
+	shmp = planp->shmstatsp;
+	if (shmp == NULL)
+		return;
+	pthread_mutex_lock(&shmp->shm_mutex);
+	shmp->shm_shutdown = 1;
+	pthread_cond_broadcast(&shmp->shm_cond);
+	pthread_mutex_unlock(&shmp->shm_mutex);
+	pthread_join(shmp->shm_thread, NULL);
+	xdd_shmstats_update(shmp, XINT_SHMSTATS_RUN_DONE);
+	munmap(shmp->shm_hdrp, shmp->shm_size);
+	shm_unlink(shmp->shm_name);
+	free(shmp);
+	planp->shmstatsp = NULL;
+} // End of xdd_shmstats_stop()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
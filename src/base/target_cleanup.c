@@ -35,6 +35,18 @@ xdd_target_thread_cleanup(target_data_t *tdp) {
 		// get the next Worker in this chain
 		wdp = wdp->wd_next_wdp;
 	}
+	// Stop the verifier threads - the last pass has already been drained
+	xdd_verify_pool_destroy(tdp);
+	xdd_prefill_destroy(tdp);
+	xdd_compound_destroy(tdp);
+	xdd_manifest_close(tdp);
+	xdd_extent_map_free(tdp);
+
+	// Save the block checksums for a later -verify checksum run
+	if (tdp->td_target_options & TO_VERIFY_CHECKSUM)
+		xdd_checksum_save(tdp);
+	xdd_checksum_free(tdp);
+
 	if (tdp->td_target_options & TO_DELETEFILE) {
 #ifdef WIN32
 		DeleteFile(tdp->td_target_full_pathname);
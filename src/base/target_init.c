@@ -78,8 +78,31 @@ xint_target_init(target_data_t *tdp) {
 		return(-1);
 	}
 
+	// Targets that cannot do compound ops get plain writes in the seek list
+	xdd_compound_init(tdp);
+
 	xdd_init_seek_list(tdp);
 
+	// The checksum table covers the blocks of the seek list
+	status = xdd_checksum_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Open the write manifest or load it into the checksum table for -manifest
+	status = xdd_manifest_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Start the verifier threads used by -verifythreads
+	status = xdd_verify_pool_init(tdp);
+	if (status) 
+		return(-1);
+
+	// Start the prefill thread used by -prefill - it walks the seek list
+	status = xdd_prefill_init(tdp);
+	if (status) 
+		return(-1);
+
 	// Set up the timestamp table - Note: This must be done *after* the seek list is initialized
 	xdd_ts_setup(tdp); 
 
@@ -136,6 +159,11 @@ xint_target_init(target_data_t *tdp) {
 	if (status) 
 		return(-1);
 
+	// Start the timestamp writer used by -ts stream - it needs the Worker Threads
+	status = xdd_ts_stream_start(tdp);
+	if (status) 
+		return(-1);
+
 	// If this is XNI, perform the connection here
 	xdd_plan_t *planp = tdp->td_planp;
 	if (PLAN_ENABLE_XNI & planp->plan_options) {
@@ -296,7 +296,7 @@ if (xgp->global_options & GO_DEBUG_OPEN) fprintf(stderr,"DEBUG_OPEN: %lld: xdd_t
 			xdd_sg_set_reserved_size(tdp,tdp->td_file_desc);
 			xdd_sg_get_version(tdp,tdp->td_file_desc);
 		} else {
-			tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|O_WRONLY, 0666); /* write only */
+			tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|((tdp->td_cop && tdp->td_cop->co_op)?O_RDWR:O_WRONLY), 0666); /* write only - compound ops read too */
 if (xgp->global_options & GO_DEBUG_OPEN) fprintf(stderr,"DEBUG_OPEN: %lld: xdd_target_open_for_os: Target: %d: Worker: %d: WRITE ONLY: file_desc: %d\n ", (long long int)pclk_now(),tdp->td_target_number,tdp->td_queue_depth,tdp->td_file_desc);
 		}
 	} else if (tdp->td_rwratio == 1.0) { /* read only */
@@ -334,7 +334,7 @@ xdd_target_open_for_os(target_data_t *tdp) {
 
         /* open the target */
         if (tdp->td_rwratio == 0.0) {
-                tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|O_WRONLY, 0666); /* write only */
+                tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|((tdp->td_cop && tdp->td_cop->co_op)?O_RDWR:O_WRONLY), 0666); /* write only - compound ops read too */
         } else if (tdp->td_rwratio == 1.0) { /* read only */
                 tdp->td_open_flags &= ~O_CREAT;
                 tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|O_RDONLY, 0777); /* Read only */
@@ -355,7 +355,7 @@ int32_t
 xdd_target_open_for_os(target_data_t *tdp) {
         /* open the target */
     if (tdp->td_rwratio == 0.0) {
-	tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|O_WRONLY, 0666); /* write only */
+	tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|((tdp->td_cop && tdp->td_cop->co_op)?O_RDWR:O_WRONLY), 0666); /* write only - compound ops read too */
     } else if (tdp->td_rwratio == 1.0) { /* read only */
 	tdp->td_open_flags &= ~O_CREAT;
 	tdp->td_file_desc = open(tdp->td_target_full_pathname,tdp->td_open_flags|O_RDONLY, 0777); /* Read only */
@@ -406,7 +406,7 @@ xdd_target_open_for_os(target_data_t *tdp) {
 	} /* end of IF stmnt that opens with DIO */
 	// Generic 64-bit UNIX open stuff - for Solaris, AIX, FREEBSD, and Darwin
 	if (tdp->td_rwratio == 0.0) {
-		fd = open64(target_full_pathname,flags|O_WRONLY, 0666); /* write only */
+		fd = open64(target_full_pathname,flags|((tdp->td_cop && tdp->td_cop->co_op)?O_RDWR:O_WRONLY), 0666); /* write only - compound ops read too */
 	} else if (tdp->td_rwratio == 1.0) { /* read only */
 		flags &= ~O_CREAT;
 		fd = open64(target_full_pathname,flags|O_RDONLY, 0777); /* Read only */
@@ -182,6 +182,7 @@ void
 xdd_target_pass_task_setup(worker_data_t *wdp) {
 	target_data_t	*tdp;
 	xdd_ts_tte_t	*ttep;
+	uint64_t		xfer_size;	// Size of this request in bytes
 
 	tdp = wdp->wd_tdp;
 	// Assign an IO task to this worker thread
@@ -197,15 +198,31 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ) { // READ Operation
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_READ;
 		wdp->wd_task.task_op_string = "READ";
+	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ_MODIFY_WRITE) { // Read-Modify-Write Operation
+		wdp->wd_task.task_op_type = TASK_OP_TYPE_WRITE;
+		wdp->wd_task.task_op_string = "RMW";
+	} else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE_VERIFY) { // Write with a later readback
+		wdp->wd_task.task_op_type = TASK_OP_TYPE_WRITE;
+		wdp->wd_task.task_op_string = "WRITEVERIFY";
 	} else { 
 		wdp->wd_task.task_op_type = TASK_OP_TYPE_NOOP;
 		wdp->wd_task.task_op_string = "NOOP";
 	}
+	if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_READ_MODIFY_WRITE)
+		wdp->wd_task.task_compound = TASK_COMPOUND_RMW;
+	else if (tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].operation == SO_OP_WRITE_VERIFY)
+		wdp->wd_task.task_compound = TASK_COMPOUND_READBACK;
+	else wdp->wd_task.task_compound = TASK_COMPOUND_NONE;
 	 
 	// Figure out the transfer size to use for this I/O
-	if (tdp->td_current_bytes_remaining < (uint64_t)tdp->td_xfer_size)
+	// When request sizes vary or are cut short at the end of an extent the size comes from the seek list entry for this op
+	if (tdp->td_seekhdr.seek_options & (SO_SEEK_VARSIZE | SO_SEEK_EXTENTS))
+		xfer_size = (uint64_t)tdp->td_seekhdr.seeks[tdp->td_counters.tc_current_op_number].reqsize * tdp->td_block_size;
+	else xfer_size = (uint64_t)tdp->td_xfer_size;
+	if (tdp->td_current_bytes_remaining < xfer_size)
 		wdp->wd_task.task_xfer_size = tdp->td_current_bytes_remaining;
-	else wdp->wd_task.task_xfer_size = tdp->td_xfer_size;
+	else wdp->wd_task.task_xfer_size = xfer_size;
+	wdp->wd_task.task_hole = 0; // Set by the read if it finds a hole
 
 	// Set the location to seek to 
 	wdp->wd_task.task_byte_offset = tdp->td_counters.tc_current_byte_offset;
@@ -215,15 +232,7 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 
    	// If time stamping is on then assign a time stamp entry to this Worker Thread
    	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-		tdp->td_ts_table.ts_current_entry++;
-		if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-			if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-				tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-		} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-			tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-		}
+		ttep = xdd_ts_assign_entry(wdp);
 		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 		ttep->tte_worker_thread_number = wdp->wd_worker_number;
 		ttep->tte_thread_id = wdp->wd_thread_id;
@@ -231,6 +240,7 @@ xdd_target_pass_task_setup(worker_data_t *wdp) {
 		ttep->tte_op_number = wdp->wd_task.task_op_number;
 		ttep->tte_byte_offset = wdp->wd_task.task_byte_offset;
 	}
+	xdd_worker_state_task_setup(wdp);
 if (xgp->global_options & GO_DEBUG_TASK) fprintf(stderr,"DEBUG_TASK: %lld: xdd_target_pass_task_setup_src: Target: %d: Worker: %d: task_request: 0x%x: file_desc: %d: datap: %p: op_type: %d, op_string: %s: op_number: %lld: xfer_size: %d, byte_offset: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_request,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,wdp->wd_task.task_op_type,wdp->wd_task.task_op_string,(unsigned long long int)wdp->wd_task.task_op_number,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset);
 	// Update the pointers/counters in the Target Data Struct to get 
 	// ready for the next I/O operation
@@ -74,21 +74,14 @@ xdd_targetpass_e2e_loop_dst(xdd_plan_t* planp, target_data_t *tdp) {
 		wdp->wd_task.task_xfer_size = -1; 	// To be filled in after data received
 		wdp->wd_task.task_io_status = -1; 	// To be filled in after data received
 		wdp->wd_task.task_errno = 0; 		// To be filled in after data received
+		wdp->wd_task.task_hole = 0; 		// To be filled in after data received
 //		if (tdp->td_counters.tc_current_op_number == 0) {
 //			nclk_now(&tdp->td_counters.tc_time_first_op_issued_this_pass);
 //		}
 
    		// If time stamping is on then assign a time stamp entry to this Worker Thread
    		if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-			wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-			ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-			tdp->td_ts_table.ts_current_entry++;
-			if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-				if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-					tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-			} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-				tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-			}
+			ttep = xdd_ts_assign_entry(wdp);
 			ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 			ttep->tte_worker_thread_number = wdp->wd_worker_number;
 			ttep->tte_thread_id     = wdp->wd_thread_id;
@@ -241,6 +234,7 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 	else wdp->wd_task.task_xfer_size = tdp->td_xfer_size;
 	wdp->wd_task.task_io_status = 0;
 	wdp->wd_task.task_errno = 0;
+	wdp->wd_task.task_hole = 0; // Set by the read if it finds a hole
 
 	// Set the location to seek to 
 	wdp->wd_task.task_byte_offset = tdp->td_counters.tc_current_byte_offset;
@@ -256,15 +250,7 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 
    	// If time stamping is on then assign a time stamp entry to this Worker Thread
    	if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-		wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-		ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-		tdp->td_ts_table.ts_current_entry++;
-		if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-			if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-				tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-		} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-			tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-		}
+		ttep = xdd_ts_assign_entry(wdp);
 		ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 		ttep->tte_worker_thread_number = wdp->wd_worker_number;
 		ttep->tte_thread_id = wdp->wd_thread_id;
@@ -272,6 +258,7 @@ xdd_targetpass_e2e_task_setup_src(worker_data_t *wdp) {
 		ttep->tte_op_number = wdp->wd_task.task_op_number;
 		ttep->tte_byte_offset = wdp->wd_task.task_byte_offset;
 	}
+	xdd_worker_state_task_setup(wdp);
 if (xgp->global_options & GO_DEBUG_TASK) fprintf(stderr,"DEBUG_TASK: %lld: xdd_targetpass_e2e_task_setup_src: Target: %d: Worker: %d: task_request: 0x%x: file_desc: %d: datap: %p: op_type: %d, op_string: %s: op_number: %lld: xfer_size: %d, byte_offset: %lld: e2e_sequence_number: %lld\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,wdp->wd_task.task_request,wdp->wd_task.task_file_desc,wdp->wd_task.task_datap,wdp->wd_task.task_op_type,wdp->wd_task.task_op_string,(unsigned long long int)wdp->wd_task.task_op_number,(int)wdp->wd_task.task_xfer_size,(long long int)wdp->wd_task.task_byte_offset,(unsigned long long int)wdp->wd_task.task_e2e_sequence_number);
 	// Update the pointers/counters in the Target Data Struct to get ready for the next I/O operation
 	tdp->td_counters.tc_current_byte_offset += wdp->wd_task.task_xfer_size;
@@ -311,15 +298,7 @@ xdd_targetpass_e2e_eof_src(target_data_t *tdp) {
 
    		// If time stamping is on then assign a time stamp entry to this Worker Thread
    		if ((tdp->td_ts_table.ts_options & (TS_ON|TS_TRIGGERED))) {
-			wdp->wd_ts_entry = tdp->td_ts_table.ts_current_entry;	
-			ttep = & tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
-			tdp->td_ts_table.ts_current_entry++;
-			if (tdp->td_ts_table.ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
-				if (tdp->td_ts_table.ts_current_entry == tdp->td_ts_table.ts_size)
-					tdp->td_ts_table.ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
-			} else if (tdp->td_ts_table.ts_options & TS_WRAP) {
-				tdp->td_ts_table.ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
-			}
+			ttep = xdd_ts_assign_entry(wdp);
 			ttep->tte_pass_number = tdp->td_counters.tc_pass_number;
 			ttep->tte_worker_thread_number = wdp->wd_worker_number;
 			ttep->tte_thread_id = wdp->wd_thread_id;
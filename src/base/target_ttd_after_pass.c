@@ -26,9 +26,38 @@ int32_t
 xdd_target_ttd_after_pass(target_data_t *tdp) {
 	int32_t  status;
 	worker_data_t	*wdp;
+	nclk_t			flush_start;	// Start of the collective flush
+	nclk_t			flush_end;		// End of the collective flush
+	struct stat		statbuf;		// Used to find the size of a sparse destination file
 
 
 	status = 0;
+	// Stop the prefill thread before the seek list can change for the next pass
+	xdd_prefill_end_pass(tdp);
+
+	// The compare errors of this pass are not complete until the verifier threads are done
+	xdd_verify_pool_drain(tdp);
+
+	// Read back the writes of -op writeverify that are still waiting
+	xdd_compound_drain(tdp);
+
+	// The manifest has to be on stable storage along with the data of this pass
+	xdd_manifest_sync(tdp);
+
+	// A sparse file that ends in a hole has to be extended to its full size on the E2E destination
+	// The source decides where the holes are so this does not depend on -sparse on this side
+	if ((tdp->td_target_options & TO_E2E_DESTINATION) && (tdp->td_hole_end > 0)) {
+		if ((fstat(tdp->td_file_desc, &statbuf) == 0) && ((uint64_t)statbuf.st_size < tdp->td_hole_end)) {
+			if (ftruncate(tdp->td_file_desc, (off_t)tdp->td_hole_end) < 0) {
+				fprintf(xgp->errout,"%s: xdd_target_ttd_after_pass: Target %d: WARNING: Cannot extend '%s' to %llu bytes to recreate the hole at its end\n",
+					xgp->progname,
+					tdp->td_target_number,
+					tdp->td_target_full_pathname,
+					(unsigned long long)tdp->td_hole_end);
+				perror("Reason");
+			}
+		}
+	}
 	// Issue an fdatasync() to flush all the write buffers to disk for this file if the -syncwrite option was specified
 	if (tdp->td_target_options & TO_SYNCWRITE) {
 #if (LINUX || AIX)
@@ -37,6 +66,19 @@ xdd_target_ttd_after_pass(target_data_t *tdp) {
             status = fsync(tdp->td_file_desc);
 #endif
         }
+	// All targets sharing a file flush it together so that the pass ends when the whole file is stable
+	if (tdp->td_planp->plan_options & PLAN_SHARED_FILE_FLUSH) {
+		xdd_barrier(&tdp->td_planp->main_targets_sharedfile_barrier,&tdp->td_occupant,0);
+		nclk_now(&flush_start);
+#if (LINUX || AIX)
+		status = fdatasync(tdp->td_file_desc);
+#else
+		status = fsync(tdp->td_file_desc);
+#endif
+		xdd_barrier(&tdp->td_planp->main_targets_sharedfile_barrier,&tdp->td_occupant,0);
+		nclk_now(&flush_end);
+		tdp->td_counters.tc_accumulated_flush_time += (flush_end - flush_start);
+	}
 	/* Get the ending time stamp */
 	nclk_now(&tdp->td_counters.tc_pass_end_time);
 	tdp->td_counters.tc_pass_elapsed_time = tdp->td_counters.tc_pass_end_time - tdp->td_counters.tc_pass_start_time;
@@ -241,11 +241,25 @@ xdd_init_target_data_before_pass(target_data_t *tdp) {
 	} 
 
 	wdp = tdp->td_next_wdp;
-	while (wdp) { // Set up the pass_start_times for all the Worker Threads 
+	while (wdp) { // Set up the pass_start_times and counters for all the Worker Threads 
 		wdp->wd_counters.tc_pass_start_time = tdp->td_counters.tc_pass_start_time;
 		if (tdp->td_counters.tc_pass_number == 1) 
 			times(&wdp->wd_counters.tc_starting_cpu_times_this_run);
 		times(&wdp->wd_counters.tc_starting_cpu_times_this_pass);
+		wdp->wd_counters.tc_accumulated_op_count = 0;
+		wdp->wd_counters.tc_accumulated_read_op_count = 0;
+		wdp->wd_counters.tc_accumulated_write_op_count = 0;
+		wdp->wd_counters.tc_accumulated_noop_op_count = 0;
+		wdp->wd_counters.tc_accumulated_bytes_xfered = 0;
+		wdp->wd_counters.tc_accumulated_bytes_read = 0;
+		wdp->wd_counters.tc_accumulated_bytes_written = 0;
+		wdp->wd_counters.tc_accumulated_bytes_noop = 0;
+		wdp->wd_counters.tc_accumulated_op_time = 0;
+		wdp->wd_counters.tc_accumulated_read_op_time = 0;
+		wdp->wd_counters.tc_accumulated_write_op_time = 0;
+		wdp->wd_counters.tc_accumulated_noop_op_time = 0;
+		wdp->wd_counters.tc_accumulated_pattern_fill_time = 0;
+		xdd_worker_state_before_pass(wdp);
 		wdp = wdp->wd_next_wdp;
 	}
 	
@@ -285,6 +299,9 @@ xdd_target_ttd_before_pass(target_data_t *tdp) {
 
 	xdd_init_target_data_before_pass(tdp);
 
+	// Let the prefill thread work ahead on the seek list of this pass
+	xdd_prefill_start_pass(tdp);
+
 	return(0);
 		
 } // End of xdd_target_ttd_before_pass()
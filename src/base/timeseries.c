@@ -0,0 +1,223 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of -timeseries which writes the bytes,
+ * ops, and latency percentiles of each target for every interval of the run
+ * to a file.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_timeseries_sample() - Write what each target did since the last look
+ * The last look of each pass is done with pass_end set.
+ */
+static void
+xdd_timeseries_sample(xint_timeseries_t *tswp, int pass_end) {
+	xdd_plan_t					*planp;
+	target_data_t				*tdp;
+	xint_timeseries_target_t	*tstp;
+	xint_timeseries_record_t	rec;
+	nclk_t						now;
+	double						seconds;
+	int							target_number;
+
+
+	planp = tswp->tsw_planp;
+	nclk_now(&now);
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		tstp = &tswp->tsw_targets[target_number];
+		memset(&rec, 0, sizeof(rec));
+		rec.tsr_time = now - planp->run_start_time;
+		rec.tsr_interval = now - tswp->tsw_last_time;
+		rec.tsr_target_number = target_number;
+		rec.tsr_pass_number = tdp->td_counters.tc_pass_number;
+
+		xdd_histogram_target_look(tdp, &tstp->tst_look, pass_end, &rec.tsr_bytes, &rec.tsr_ops, &tswp->tsw_hist);
+		rec.tsr_latency_count = tswp->tsw_hist.h_count;
+		if (tswp->tsw_hist.h_count) {
+			rec.tsr_latency_mean = tswp->tsw_hist.h_total / tswp->tsw_hist.h_count;
+			rec.tsr_latency_max = xdd_histogram_percentile(&tswp->tsw_hist, 100.0);
+			rec.tsr_latency_p50 = xdd_histogram_percentile(&tswp->tsw_hist, 50.0);
+			rec.tsr_latency_p90 = xdd_histogram_percentile(&tswp->tsw_hist, 90.0);
+			rec.tsr_latency_p99 = xdd_histogram_percentile(&tswp->tsw_hist, 99.0);
+			rec.tsr_latency_p999 = xdd_histogram_percentile(&tswp->tsw_hist, 99.9);
+		}
+
+		if (planp->plan_options & PLAN_TIMESERIES_BINARY) {
+			fwrite(&rec, sizeof(rec), 1, tswp->tsw_fp);
+			continue;
+		}
+		seconds = (rec.tsr_interval > 0) ? ((double)rec.tsr_interval / FLOAT_BILLION) : 1.0;
+		fprintf(tswp->tsw_fp,"%.3f,%d,%d,%lld,%lld,%.3f,%.1f,%lld,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+			(double)rec.tsr_time / FLOAT_BILLION, rec.tsr_target_number, rec.tsr_pass_number,
+			(long long int)rec.tsr_bytes, (long long int)rec.tsr_ops,
+			((double)rec.tsr_bytes / seconds) / FLOAT_MILLION, (double)rec.tsr_ops / seconds,
+			(long long int)rec.tsr_latency_count,
+			(double)rec.tsr_latency_mean / FLOAT_MILLION,
+			(double)rec.tsr_latency_p50 / FLOAT_MILLION,
+			(double)rec.tsr_latency_p90 / FLOAT_MILLION,
+			(double)rec.tsr_latency_p99 / FLOAT_MILLION,
+			(double)rec.tsr_latency_p999 / FLOAT_MILLION,
+			(double)rec.tsr_latency_max / FLOAT_MILLION);
+	}
+	fflush(tswp->tsw_fp);
+	tswp->tsw_last_time = now;
+} // End of xdd_timeseries_sample()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_timeseries_thread() - Write a sample every interval until told to exit
+ */
+static void *
+xdd_timeseries_thread(void *data) {
+	xint_timeseries_t	*tswp;
+	struct timespec		wakeup;
+	int					shutdown;
+
+
+	tswp = (xint_timeseries_t *)data;
+	clock_gettime(CLOCK_REALTIME, &wakeup);
+	shutdown = 0;
+	while (!shutdown) {
+		// Keep to a fixed schedule however long a sample takes
+		wakeup.tv_nsec += tswp->tsw_planp->timeseries_interval % BILLION;
+		wakeup.tv_sec += (tswp->tsw_planp->timeseries_interval / BILLION) + (wakeup.tv_nsec / BILLION);
+		wakeup.tv_nsec %= BILLION;
+		pthread_mutex_lock(&tswp->tsw_mutex);
+		while (!tswp->tsw_shutdown) {
+			if (pthread_cond_timedwait(&tswp->tsw_cond, &tswp->tsw_mutex, &wakeup) == ETIMEDOUT)
+				break;
+		}
+		shutdown = tswp->tsw_shutdown;
+		if (!shutdown)
+			xdd_timeseries_sample(tswp, 0);
+		pthread_mutex_unlock(&tswp->tsw_mutex);
+	}
+	return(0);
+} // End of xdd_timeseries_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_timeseries_start() - Open the time series file and start the writer
+ * thread. This is called by xdd_start_plan() once the Target Threads are up.
+ * If something goes wrong this displays an ERROR and the run goes on without
+ * the time series.
+ */
+void
+xdd_timeseries_start(xdd_plan_t *planp) {
+	xint_timeseries_t			*tswp;
+	xint_timeseries_header_t	hdr;
+	int32_t						status;
+
+
+	if (!(planp->plan_options & PLAN_TIMESERIES))
+		return;
+	tswp = (xint_timeseries_t *)calloc(1, sizeof(xint_timeseries_t));
+	if (tswp)
+		tswp->tsw_targets = (xint_timeseries_target_t *)calloc(planp->number_of_targets, sizeof(xint_timeseries_target_t));
+	if ((tswp == NULL) || (tswp->tsw_targets == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_timeseries_start: ERROR: Cannot allocate memory for the time series of %d targets\n",
+			xgp->progname, planp->number_of_targets);
+		free(tswp);
+		return;
+	}
+	tswp->tsw_planp = planp;
+	tswp->tsw_fp = fopen(planp->timeseries_filename, (planp->plan_options & PLAN_TIMESERIES_BINARY) ? "wb" : "w");
+	if (tswp->tsw_fp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_timeseries_start: ERROR: Cannot open time series file '%s'\n",
+			xgp->progname, planp->timeseries_filename);
+		perror("Reason");
+		free(tswp->tsw_targets);
+		free(tswp);
+		return;
+	}
+	if (planp->plan_options & PLAN_TIMESERIES_BINARY) {
+		memset(&hdr, 0, sizeof(hdr));
+		hdr.tsh_magic = XINT_TIMESERIES_MAGIC;
+		hdr.tsh_version = XINT_TIMESERIES_VERSION;
+		hdr.tsh_number_of_targets = planp->number_of_targets;
+		hdr.tsh_record_size = sizeof(xint_timeseries_record_t);
+		hdr.tsh_interval = planp->timeseries_interval;
+		fwrite(&hdr, sizeof(hdr), 1, tswp->tsw_fp);
+	} else {
+		fprintf(tswp->tsw_fp,"Seconds,Target,Pass,Bytes,Ops,MBPerSecond,IOPS,LatencyOps,MeanMs,P50Ms,P90Ms,P99Ms,P999Ms,MaxMs\n");
+	}
+
+	nclk_now(&tswp->tsw_last_time);
+	pthread_mutex_init(&tswp->tsw_mutex, 0);
+	pthread_cond_init(&tswp->tsw_cond, 0);
+	status = pthread_create(&tswp->tsw_thread, NULL, xdd_timeseries_thread, tswp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_timeseries_start: ERROR: Cannot create the time series thread\n",
+			xgp->progname);
+		fclose(tswp->tsw_fp);
+		free(tswp->tsw_targets);
+		free(tswp);
+		return;
+	}
+	tswp->tsw_started = 1;
+	planp->timeseriesp = tswp;
+} // End of xdd_timeseries_start()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_timeseries_pass_end() - Write the interval that ends with the pass so
+ * that its last ops are counted before the histograms are emptied.
+ * This is called by the Results Manager at the end of each pass.
+ */
+void
+xdd_timeseries_pass_end(xdd_plan_t *planp) {
+	xint_timeseries_t	*tswp;
+
+
+	tswp = planp->timeseriesp;
+	if ((tswp == NULL) || !tswp->tsw_started)
+		return;
+	pthread_mutex_lock(&tswp->tsw_mutex);
+	xdd_timeseries_sample(tswp, 1);
+	pthread_mutex_unlock(&tswp->tsw_mutex);
+} // End of xdd_timeseries_pass_end()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_timeseries_stop() - Stop the writer thread and close the time series
+ * file. The last interval was written at the end of the last pass.
+ * This is called by the Results Manager at the end of the run.
+ */
+void
+xdd_timeseries_stop(xdd_plan_t *planp) {
+	xint_timeseries_t	*tswp;
+
+
+	tswp = planp->timeseriesp;
+	if ((tswp == NULL) || !tswp->tsw_started)
+		return;
+	pthread_mutex_lock(&tswp->tsw_mutex);
+	tswp->tsw_shutdown = 1;
+	pthread_cond_broadcast(&tswp->tsw_cond);
+	pthread_mutex_unlock(&tswp->tsw_mutex);
+	pthread_join(tswp->tsw_thread, NULL);
+	fclose(tswp->tsw_fp);
+	fprintf(xgp->output,"Time series written to %s\n", planp->timeseries_filename);
+	free(tswp->tsw_targets);
+	free(tswp);
+	planp->timeseriesp = NULL;
+} // End of xdd_timeseries_stop()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,138 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of -ts sample which only time stamps
+ * some of the ops: every Nth op, a random percentage of the ops, or the ops
+ * of a window of time that repeats periodically.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_sample_gap() - Return the number of ops up to and including the next
+ * op to time stamp for XDD_TS_SAMPLE_RANDOM. The gaps are spread evenly from
+ * 1 to twice their mean so that the ops sampled do not fall into step with a
+ * pattern of the workload.
+ */
+static int64_t
+xdd_ts_sample_gap(xint_timestamp_t *tsp) {
+	double	mean;	// Average number of ops from one sampled op to the next
+
+
+	mean = 100.0 / tsp->ts_sample_percent;
+	if (mean <= 1.0)
+		return(1);
+	return(1 + (int64_t)(erand48(tsp->ts_sample_xsubi) * ((2.0 * mean) - 1.0)));
+} // End of xdd_ts_sample_gap()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_sample_setup() - Get ready to sample the ops of a target.
+ * This is called by xdd_ts_setup() after the number of entries the time
+ * stamp table needs has been figured out and before it is allocated.
+ * Return values: Number of scratch entries to add to the time stamp table
+ */
+int64_t
+xdd_ts_sample_setup(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+
+
+	tsp = &tdp->td_ts_table;
+	if (tsp->ts_sample_mode == XDD_TS_SAMPLE_NONE)
+		return(0);
+	tsp->ts_sample_window_start = 0;
+	tsp->ts_sample_xsubi[0] = 0x330e;
+	tsp->ts_sample_xsubi[1] = (unsigned short)tdp->td_seekhdr.seek_seed;
+	tsp->ts_sample_xsubi[2] = (unsigned short)tdp->td_target_number;
+	switch (tsp->ts_sample_mode) {
+		case XDD_TS_SAMPLE_EVERY:
+			// Only one op in ts_sample_every needs an entry
+			tsp->ts_size = (((tdp->td_planp->passes * tdp->td_target_ops) + tsp->ts_sample_every - 1) / tsp->ts_sample_every) + tdp->td_queue_depth;
+			tsp->ts_sample_countdown = 1;
+			break;
+		case XDD_TS_SAMPLE_RANDOM:
+			tsp->ts_sample_countdown = xdd_ts_sample_gap(tsp);
+			break;
+		default:
+			tsp->ts_sample_countdown = 1;
+			break;
+	}
+	// With -ts stream the scratch entry of each Worker Thread is already there
+	if (tsp->ts_options & TS_STREAM)
+		return(0);
+	return(tdp->td_queue_depth);
+} // End of xdd_ts_sample_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_sample_op() - Decide whether the op about to be assigned is time
+ * stamped and when to decide again. This is only called when
+ * ts_sample_countdown has run out.
+ * This is called by the Target Thread when it assigns a task.
+ * Return values: 1 if the op is time stamped, 0 if it is not
+ */
+int32_t
+xdd_ts_sample_op(xint_timestamp_t *tsp) {
+	nclk_t	now;
+
+
+	switch (tsp->ts_sample_mode) {
+		case XDD_TS_SAMPLE_EVERY:
+			tsp->ts_sample_countdown = tsp->ts_sample_every;
+			return(1);
+		case XDD_TS_SAMPLE_RANDOM:
+			tsp->ts_sample_countdown = xdd_ts_sample_gap(tsp);
+			return(1);
+		case XDD_TS_SAMPLE_WINDOW:
+			// Check the time on every op
+			tsp->ts_sample_countdown = 1;
+			nclk_now(&now);
+			if (tsp->ts_sample_window_start == 0)
+				tsp->ts_sample_window_start = now;
+			if ((now - tsp->ts_sample_window_start) >= tsp->ts_sample_period)
+				tsp->ts_sample_window_start += ((now - tsp->ts_sample_window_start) / tsp->ts_sample_period) * tsp->ts_sample_period;
+			return((now - tsp->ts_sample_window_start) < tsp->ts_sample_window);
+		default:
+			tsp->ts_sample_countdown = 1;
+			return(1);
+	}
+} // End of xdd_ts_sample_op()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_sample_skip() - Give a Worker Thread its scratch entry for an op that
+ * is not time stamped
+ * Return values: Pointer to the cleared entry
+ */
+xdd_ts_tte_t *
+xdd_ts_sample_skip(worker_data_t *wdp) {
+	xint_timestamp_t	*tsp;
+	xdd_ts_tte_t		*ttep;
+
+
+	tsp = &wdp->wd_tdp->td_ts_table;
+	wdp->wd_ts_skip = 1;
+	if (tsp->ts_options & TS_STREAM)
+		return(xdd_ts_stream_assign(wdp));
+	wdp->wd_ts_entry = tsp->ts_scratch_entry + wdp->wd_worker_number;
+	ttep = &tsp->ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+	memset(ttep, 0, sizeof(*ttep));
+	return(ttep);
+} // End of xdd_ts_sample_skip()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
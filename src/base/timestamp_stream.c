@@ -0,0 +1,338 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of -ts stream which writes the time
+ * stamp entries of a target to its dump file while the run goes on.
+ * The dump file has the same layout as the one written by xdd_ts_write() so
+ * read_tsdumps can read it: the time stamp header followed by the entries,
+ * or by compact blocks of entries with -ts compact.
+ * The header is written again with the final number of entries when the
+ * file is closed.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_setup() - Check that a target can stream its time stamps.
+ * This is called by xdd_ts_setup() before the time stamp table is allocated.
+ * Return values: Number of entries the time stamp table needs, which is one
+ *                scratch entry for each Worker Thread, or 0 if the target
+ *                does not stream its time stamps
+ */
+int64_t
+xdd_ts_stream_setup(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+
+
+	tsp = &tdp->td_ts_table;
+	if (!(tsp->ts_options & TS_STREAM))
+		return(0);
+	if (!(tsp->ts_options & TS_DUMP) || (tdp->td_planp->ts_binary_filename_prefix == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_ts_setup: Target %d: WARNING: -ts stream needs -ts dump <filename> - keeping the time stamps in memory\n",
+			xgp->progname, tdp->td_target_number);
+		tsp->ts_options &= ~TS_STREAM;
+		return(0);
+	}
+	if (tsp->ts_options & (TS_SUMMARY | TS_DETAILED))
+		fprintf(xgp->errout,"%s: xdd_ts_setup: Target %d: NOTICE: The summary and detailed time stamp reports are not available with -ts stream\n",
+			xgp->progname, tdp->td_target_number);
+	tsp->ts_options &= ~(TS_WRAP | TS_ONESHOT);
+	if (tsp->ts_ring_size <= 0)
+		tsp->ts_ring_size = XDD_TS_STREAM_RING_ENTRIES;
+	return(tdp->td_queue_depth);
+} // End of xdd_ts_stream_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_assign() - Give a Worker Thread its scratch entry of the time
+ * stamp table for the op it is about to do.
+ * This is called by the Target Thread when it assigns a task.
+ * Return values: Pointer to the cleared entry
+ */
+xdd_ts_tte_t *
+xdd_ts_stream_assign(worker_data_t *wdp) {
+	xdd_ts_tte_t	*ttep;
+
+
+	wdp->wd_ts_entry = wdp->wd_worker_number;
+	ttep = &wdp->wd_tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+	memset(ttep, 0, sizeof(*ttep));
+	return(ttep);
+} // End of xdd_ts_stream_assign()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_after_io_op() - Put the entry of the op just done into the
+ * ring of the Worker Thread, or count it as dropped if the ring is full.
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_ts_stream_after_io_op(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	xint_ts_ring_t	*trp;
+
+
+	tdp = wdp->wd_tdp;
+	trp = wdp->wd_ts_ringp;
+	if ((trp == NULL) || !(tdp->td_ts_table.ts_options & TS_STREAM) ||
+		!(tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) || wdp->wd_ts_skip)
+		return;
+	if ((trp->tr_head - trp->tr_tail) >= trp->tr_size) {
+		trp->tr_dropped++;
+		return;
+	}
+	trp->tr_entries[trp->tr_head % trp->tr_size] = tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+#if defined(__GNUC__)
+	__sync_synchronize(); // The entry must be in memory before the writer can see it
+#endif
+	trp->tr_head++;
+} // End of xdd_ts_stream_after_io_op()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_drain() - Write the entries in the rings of all the Worker
+ * Threads of a target to the dump file.
+ * This is only ever called by one thread at a time.
+ */
+static void
+xdd_ts_stream_drain(xint_ts_stream_t *tswp) {
+	target_data_t	*tdp;
+	worker_data_t	*wdp;
+	xint_ts_ring_t	*trp;
+	int64_t			head;
+	int64_t			count;
+	int64_t			first;
+	ssize_t			status;
+	off_t			offset;
+
+
+	tdp = tswp->tsw_tdp;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		trp = wdp->wd_ts_ringp;
+		if (trp == NULL)
+			continue;
+		head = trp->tr_head;
+#if defined(__GNUC__)
+		__sync_synchronize(); // Read the entries only after reading the head
+#endif
+		while (trp->tr_tail < head) {
+			// Write up to the end of the ring at a time
+			first = trp->tr_tail % trp->tr_size;
+			count = head - trp->tr_tail;
+			if (count > (trp->tr_size - first))
+				count = trp->tr_size - first;
+			if (tswp->tsw_fields) {
+				// A compact block is written whole or not at all
+				offset = lseek(tswp->tsw_fd, 0, SEEK_CUR);
+				if (xdd_ts_compact_write_block(tswp->tsw_fd, &trp->tr_entries[first], count, tswp->tsw_fields) < 0) {
+					(void)lseek(tswp->tsw_fd, offset, SEEK_SET);
+					status = 0;
+				} else status = count * sizeof(xdd_ts_tte_t);
+			} else status = write(tswp->tsw_fd, &trp->tr_entries[first], count * sizeof(xdd_ts_tte_t));
+			if (status != (ssize_t)(count * sizeof(xdd_ts_tte_t))) {
+				if (tswp->tsw_write_errors++ == 0) {
+					fprintf(xgp->errout,"%s: xdd_ts_stream_drain: Target %d: ERROR: Cannot write to timestamp binary output file %s\n",
+						xgp->progname, tdp->td_target_number, tdp->td_ts_table.ts_binary_filename);
+					perror("Reason");
+				}
+				// Keep the file made of whole entries and count the rest as dropped
+				if (status < 0)
+					status = 0;
+				if (status % sizeof(xdd_ts_tte_t))
+					(void)lseek(tswp->tsw_fd, -(off_t)(status % sizeof(xdd_ts_tte_t)), SEEK_CUR);
+				tswp->tsw_entries += status / sizeof(xdd_ts_tte_t);
+				tswp->tsw_dropped += (head - trp->tr_tail) - (status / sizeof(xdd_ts_tte_t));
+				trp->tr_tail = head;
+				break;
+			}
+			tswp->tsw_entries += count;
+#if defined(__GNUC__)
+			__sync_synchronize(); // The entries must be written before the Worker Thread can reuse them
+#endif
+			trp->tr_tail += count;
+		}
+	}
+} // End of xdd_ts_stream_drain()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_thread() - Write the rings to the dump file every
+ * XDD_TS_STREAM_INTERVAL nanoseconds until told to exit
+ */
+static void *
+xdd_ts_stream_thread(void *data) {
+	xint_ts_stream_t	*tswp;
+	struct timespec		wakeup;
+	int					shutdown;
+
+
+	tswp = (xint_ts_stream_t *)data;
+	shutdown = 0;
+	while (!shutdown) {
+		clock_gettime(CLOCK_REALTIME, &wakeup);
+		wakeup.tv_nsec += XDD_TS_STREAM_INTERVAL;
+		wakeup.tv_sec += wakeup.tv_nsec / BILLION;
+		wakeup.tv_nsec %= BILLION;
+		pthread_mutex_lock(&tswp->tsw_mutex);
+		if (!tswp->tsw_shutdown)
+			pthread_cond_timedwait(&tswp->tsw_cond, &tswp->tsw_mutex, &wakeup);
+		shutdown = tswp->tsw_shutdown;
+		pthread_mutex_unlock(&tswp->tsw_mutex);
+		xdd_ts_stream_drain(tswp);
+	}
+	return(0);
+} // End of xdd_ts_stream_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_start() - Give each Worker Thread its ring, write the header
+ * to the dump file, and start the writer thread.
+ * This is called by the Target Thread after the Worker Threads have started
+ * and before the first pass.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_ts_stream_start(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tswp;
+	worker_data_t		*wdp;
+	xint_ts_ring_t		*trp;
+	int					status;
+
+
+	tsp = &tdp->td_ts_table;
+	if (!(tsp->ts_options & TS_ON) || !(tsp->ts_options & TS_STREAM))
+		return(0);
+	tswp = (xint_ts_stream_t *)calloc(1, sizeof(xint_ts_stream_t));
+	if (tswp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot allocate memory for the timestamp writer\n",
+			xgp->progname, tdp->td_target_number);
+		return(-1);
+	}
+	tswp->tsw_tdp = tdp;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		trp = (xint_ts_ring_t *)calloc(1, sizeof(xint_ts_ring_t));
+		if (trp)
+			trp->tr_entries = (xdd_ts_tte_t *)calloc(tsp->ts_ring_size, sizeof(xdd_ts_tte_t));
+		if ((trp == NULL) || (trp->tr_entries == NULL)) {
+			fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d Worker Thread %d: ERROR: Cannot allocate memory for %lld timestamp entries\n",
+				xgp->progname, tdp->td_target_number, wdp->wd_worker_number, (long long int)tsp->ts_ring_size);
+			free(trp);
+			return(-1);
+		}
+		trp->tr_size = tsp->ts_ring_size;
+		wdp->wd_ts_ringp = trp;
+	}
+
+	tswp->tsw_fd = open(tsp->ts_binary_filename, O_WRONLY|O_CREAT|O_TRUNC, 0666);
+	if (tswp->tsw_fd < 0) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot open timestamp binary output file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+		return(-1);
+	}
+	// The header says there are no entries until the file is closed
+	tsp->ts_hdrp->tsh_numents = 0;
+	tsp->ts_hdrp->tsh_tt_size = 0;
+	if (tsp->ts_options & TS_COMPACT) {
+		tsp->ts_hdrp->tsh_magic = XDD_TS_COMPACT_MAGIC;
+		tswp->tsw_fields = xdd_ts_compact_fields(tdp);
+	}
+	if (write(tswp->tsw_fd, tsp->ts_hdrp, XDD_TS_HEADER_SIZE) != (ssize_t)XDD_TS_HEADER_SIZE) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot write the header to timestamp binary output file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+		close(tswp->tsw_fd);
+		return(-1);
+	}
+
+	pthread_mutex_init(&tswp->tsw_mutex, 0);
+	pthread_cond_init(&tswp->tsw_cond, 0);
+	tswp->tsw_shutdown = 0;
+	status = pthread_create(&tswp->tsw_thread, NULL, xdd_ts_stream_thread, tswp);
+	if (status) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_start: Target %d: ERROR: Cannot create the timestamp writer thread\n",
+			xgp->progname, tdp->td_target_number);
+		perror("Reason");
+		close(tswp->tsw_fd);
+		return(-1);
+	}
+	tswp->tsw_started = 1;
+	tsp->ts_streamp = tswp;
+	return(0);
+} // End of xdd_ts_stream_start()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_stream_close() - Stop the writer thread, write what is left in the
+ * rings, and write the header again with the number of entries in the file.
+ * Then the rings and the writer are freed.
+ * This is called by the Results Manager at the end of the run while the
+ * Worker Threads are idle.
+ */
+void
+xdd_ts_stream_close(target_data_t *tdp) {
+	xint_timestamp_t	*tsp;
+	xint_ts_stream_t	*tswp;
+	worker_data_t		*wdp;
+	off_t				bytes;
+
+
+	tsp = &tdp->td_ts_table;
+	tswp = tsp->ts_streamp;
+	if ((tswp == NULL) || !tswp->tsw_started)
+		return;
+	pthread_mutex_lock(&tswp->tsw_mutex);
+	tswp->tsw_shutdown = 1;
+	pthread_cond_broadcast(&tswp->tsw_cond);
+	pthread_mutex_unlock(&tswp->tsw_mutex);
+	pthread_join(tswp->tsw_thread, NULL); // The writer empties the rings once more on its way out
+	tswp->tsw_started = 0;
+
+	// The rings are empty now and nothing puts entries into them any more
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		if (wdp->wd_ts_ringp == NULL)
+			continue;
+		tswp->tsw_dropped += wdp->wd_ts_ringp->tr_dropped;
+		free(wdp->wd_ts_ringp->tr_entries);
+		free(wdp->wd_ts_ringp);
+		wdp->wd_ts_ringp = NULL;
+	}
+	pthread_mutex_destroy(&tswp->tsw_mutex);
+	pthread_cond_destroy(&tswp->tsw_cond);
+	tsp->ts_hdrp->tsh_numents = tswp->tsw_entries;
+	tsp->ts_hdrp->tsh_tt_size = tswp->tsw_entries;
+	tsp->ts_hdrp->tsh_tt_bytes = XDD_TS_HEADER_SIZE + (tswp->tsw_entries * sizeof(xdd_ts_tte_t));
+	tsp->ts_hdrp->tsh_tte_indx = tswp->tsw_entries;
+	if (tswp->tsw_fields) // The compact file is however big its blocks are
+		tsp->ts_hdrp->tsh_tt_bytes = lseek(tswp->tsw_fd, 0, SEEK_END);
+	if (pwrite(tswp->tsw_fd, tsp->ts_hdrp, XDD_TS_HEADER_SIZE, 0) != (ssize_t)XDD_TS_HEADER_SIZE) {
+		fprintf(xgp->errout,"%s: xdd_ts_stream_close: Target %d: ERROR: Cannot write the header to timestamp binary output file %s\n",
+			xgp->progname, tdp->td_target_number, tsp->ts_binary_filename);
+		perror("Reason");
+	}
+	bytes = lseek(tswp->tsw_fd, 0, SEEK_END);
+	close(tswp->tsw_fd);
+	fprintf(xgp->output,"Timestamp entries streamed to %s - %lld entries, %lld dropped, %lld bytes\n",
+		tsp->ts_binary_filename, (long long int)tswp->tsw_entries, (long long int)tswp->tsw_dropped, (long long int)bytes);
+	if (tswp->tsw_dropped)
+		fprintf(xgp->errout,"%s: xdd_ts_stream_close: Target %d: WARNING: %lld timestamp entries were dropped because the writer fell behind - a larger -ts stream ring may help\n",
+			xgp->progname, tdp->td_target_number, (long long int)tswp->tsw_dropped);
+	free(tswp);
+	tsp->ts_streamp = NULL;
+} // End of xdd_ts_stream_close()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -18,13 +18,205 @@
 /*----------------------------------------------------------------------------*/
 /* xdd_verify_checksum() - Verify data checksum of the data buffer  
  * Returns the number of miscompare errors.
+ * The checksum of each block in the buffer is compared with the checksum that
+ * was recorded when the block was written, either earlier in this run or in
+ * a previous run that saved its checksum table to a file. Blocks that have
+ * no recorded checksum are counted but cannot be verified.
  */
 int32_t
 xdd_verify_checksum(worker_data_t *wdp, int64_t current_op) {
-	fprintf(xgp->errout, "%s: xdd_verify_checksum: ERROR: NOT IMPLEMENTED YET\n", xgp->progname);
-	return(0);
+	target_data_t	*tdp;
+	xint_checksum_t	*csp;
+	unsigned char	*bufp;
+	int64_t			block;			// Index of the current block in the checksum table
+	size_t			offset;			// Byte offset of the current block in the buffer
+	uint64_t		sum;
+	uint64_t		verified, unknown;
+	int32_t			errors;
+
+
+	tdp = wdp->wd_tdp;
+	csp = tdp->td_csp;
+	if ((csp == NULL) || (csp->cs_sums == NULL))
+		return(0);
+	bufp = (unsigned char *)wdp->wd_task.task_datap;
+	block = (wdp->wd_task.task_byte_offset / tdp->td_block_size) - csp->cs_first_block;
+	verified = 0;
+	unknown = 0;
+	errors = 0;
+	for (offset = 0; offset + tdp->td_block_size <= wdp->wd_task.task_xfer_size; offset += tdp->td_block_size, block++) {
+		if ((block < 0) || (block >= csp->cs_num_blocks) || (csp->cs_valid[block] == 0)) {
+			unknown++;
+			continue;
+		}
+		sum = xdd_checksum_block(csp->cs_algorithm, &bufp[offset], tdp->td_block_size);
+		if (sum == csp->cs_sums[block]) {
+			verified++;
+			continue;
+		}
+		if ((uint64_t)errors <= xgp->max_errors_to_print) 
+			fprintf(xgp->errout,"%s: xdd_verify_checksum: Target %d Worker Thread %d: ERROR: %s mismatch on op number %lld at %zu bytes into block %lld, expected 0x%016llx, got 0x%016llx\n",
+				xgp->progname, 
+				tdp->td_target_number, 
+				wdp->wd_worker_number, 
+				xdd_checksum_name(csp->cs_algorithm),
+				(long long int)current_op,
+				offset, 
+				(long long int)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
+				(unsigned long long)csp->cs_sums[block], 
+				(unsigned long long)sum);
+		errors++;
+	}
+	pthread_mutex_lock(&tdp->td_counters_mutex);
+	csp->cs_blocks_verified += verified;
+	csp->cs_blocks_unknown += unknown;
+	csp->cs_errors += errors;
+	pthread_mutex_unlock(&tdp->td_counters_mutex);
+	return(errors);
 } // end of xdd_verify_checksum()
 
+/*----------------------------------------------------------------------------*/
+/* Verify fast path
+ * The data buffer is compared a cache line (XDD_VERIFY_LINE_SIZE bytes) or 
+ * more at a time without any diagnostics. Only when a line does not match 
+ * are its individual words or bytes looked at again so that each miscompare 
+ * is reported exactly as before.
+ */
+#define XDD_VERIFY_LINE_SIZE		64		// Bytes in a cache line
+#define XDD_VERIFY_LINE_WORDS		(XDD_VERIFY_LINE_SIZE / sizeof(uint64_t))
+#define XDD_VERIFY_REFERENCE_SIZE	4096	// Maximum size of a replicated reference pattern
+
+typedef size_t (*xdd_verify_sequence_scan_t)(const uint64_t *uint64p, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse);
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_sequence_scan_scalar() - Find the first line of a sequenced data
+ * pattern that has a miscompare. 
+ * Returns the index of the first word of that line or "words" if all match.
+ */
+static size_t
+xdd_verify_sequence_scan_scalar(const uint64_t *uint64p, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse) {
+	size_t		j, k;
+	uint64_t	diff;
+
+	for (j = 0; j < words; j += XDD_VERIFY_LINE_WORDS) {
+		diff = 0;
+		for (k = j; (k < j + XDD_VERIFY_LINE_WORDS) && (k < words); k++) 
+			diff |= uint64p[k] ^ (((offset + (k * sizeof(uint64_t))) | prefix) ^ inverse);
+		if (diff)
+			return(j);
+	}
+	return(words);
+} // end of xdd_verify_sequence_scan_scalar()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define XDD_VERIFY_X86
+#include <immintrin.h>
+
+__attribute__((target("avx2"))) static size_t
+xdd_verify_sequence_scan_avx2(const uint64_t *uint64p, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse) {
+	__m256i	pos0, pos1, step, pfx, inv, diff;
+	size_t	j;
+
+	pos0 = _mm256_set_epi64x(offset + 24, offset + 16, offset + 8, offset);
+	pos1 = _mm256_add_epi64(pos0, _mm256_set1_epi64x(32));
+	step = _mm256_set1_epi64x(64);
+	pfx = _mm256_set1_epi64x(prefix);
+	inv = _mm256_set1_epi64x(inverse);
+	for (j = 0; j + XDD_VERIFY_LINE_WORDS <= words; j += XDD_VERIFY_LINE_WORDS) {
+		diff = _mm256_or_si256(
+			_mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&uint64p[j]), _mm256_xor_si256(_mm256_or_si256(pos0, pfx), inv)),
+			_mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&uint64p[j+4]), _mm256_xor_si256(_mm256_or_si256(pos1, pfx), inv)));
+		if (!_mm256_testz_si256(diff, diff))
+			return(j);
+		pos0 = _mm256_add_epi64(pos0, step);
+		pos1 = _mm256_add_epi64(pos1, step);
+	}
+	if (j < words)
+		return(j + xdd_verify_sequence_scan_scalar(&uint64p[j], words - j, offset + (j * sizeof(uint64_t)), prefix, inverse));
+	return(words);
+} // end of xdd_verify_sequence_scan_avx2()
+#endif
+
+static xdd_verify_sequence_scan_t	xdd_verify_sequence_scan = xdd_verify_sequence_scan_scalar;
+static pthread_once_t				xdd_verify_sequence_scan_once = PTHREAD_ONCE_INIT;
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_sequence_scan_select() - Pick the sequence scan this CPU can run.
+ */
+static void
+xdd_verify_sequence_scan_select(void) {
+#if defined(XDD_VERIFY_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		xdd_verify_sequence_scan = xdd_verify_sequence_scan_avx2;
+#endif
+} // end of xdd_verify_sequence_scan_select()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_reference() - Replicate a short data pattern into a reference 
+ * buffer whose length is a multiple of both the line size and the pattern
+ * length so that a replicated pattern can be compared with memcmp() in big
+ * pieces. Patterns of a line or more are used as they are.
+ * Returns the length of the reference or 0 if the pattern should be used.
+ */
+static size_t
+xdd_verify_reference(unsigned char *refp, const unsigned char *patternp, size_t pattern_length) {
+	size_t	a, b, t;
+	size_t	lcm;		// Least common multiple of the line size and pattern length
+	size_t	ref_length;
+	size_t	i;
+
+	if ((pattern_length == 0) || (pattern_length >= XDD_VERIFY_LINE_SIZE))
+		return(0);
+	a = XDD_VERIFY_LINE_SIZE;
+	b = pattern_length;
+	while (b) {
+		t = a % b;
+		a = b;
+		b = t;
+	}
+	lcm = (XDD_VERIFY_LINE_SIZE / a) * pattern_length;
+	ref_length = lcm * (XDD_VERIFY_REFERENCE_SIZE / lcm);
+	if (pattern_length == 1)
+		memset(refp, *patternp, ref_length);
+	else for (i = 0; i < ref_length; i += pattern_length)
+		memcpy(&refp[i], patternp, pattern_length);
+	return(ref_length);
+} // end of xdd_verify_reference()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_replicated_scan() - Find the first line at or after "start" of 
+ * a buffer holding a replicated pattern that has a miscompare. The reference
+ * is either the output of xdd_verify_reference() or the pattern itself.
+ * Returns the byte offset of that line or "length" if everything matches.
+ */
+static size_t
+xdd_verify_replicated_scan(const unsigned char *bufferp, size_t start, size_t length, const unsigned char *refp, size_t ref_length) {
+	size_t	pos;		// Current byte offset into the buffer
+	size_t	r;			// Matching byte offset into the reference
+	size_t	n;			// Number of bytes compared at a time
+	size_t	line, next;
+
+	pos = start;
+	while (pos < length) {
+		r = pos % ref_length;
+		n = ref_length - r;
+		if (n > (length - pos))
+			n = length - pos;
+		if (memcmp(&bufferp[pos], &refp[r], n) != 0) { // Narrow it down to the line
+			for (line = pos; line < pos + n; line = next) {
+				next = ((line / XDD_VERIFY_LINE_SIZE) + 1) * XDD_VERIFY_LINE_SIZE;
+				if (next > (pos + n))
+					next = pos + n;
+				if (memcmp(&bufferp[line], &refp[r + (line - pos)], next - line) != 0)
+					return((line / XDD_VERIFY_LINE_SIZE) * XDD_VERIFY_LINE_SIZE);
+			}
+		}
+		pos += n;
+	}
+	return(length);
+} // end of xdd_verify_replicated_scan()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_Verify_hex() - Verify hex data pattern in the data buffer  
  * Returns the number of miscompare errors.
@@ -37,45 +229,59 @@ xdd_verify_checksum(worker_data_t *wdp, int64_t current_op) {
  * of "DP_REPLICATE_PATTERN" was specified as well, then the data comparison is
  * made throughout the data buffer. Otherwise only the first N bytes are compared
  * against the data pattern where N is equal to tdp->td_dpp->data_pattern_length. Cool, huh?
+ * Whole lines are compared first; only a line with a miscompare is checked byte by byte.
  */
 int32_t
 xdd_verify_hex(worker_data_t *wdp, int64_t current_op) {
 	target_data_t	*tdp;
-	size_t i;
 	int32_t errors;
-	int32_t remaining;
-	int32_t offset;
-	unsigned char *patternp, *bufferp;
+	size_t length;			// Number of bytes to verify
+	size_t offset;
+	size_t line_end;
+	size_t ref_length;
+	unsigned char *patternp, *bufferp, *refp;
+	unsigned char reference[XDD_VERIFY_REFERENCE_SIZE];
 
 
 	tdp = wdp->wd_tdp;
+	if (tdp->td_dpp->data_pattern_length == 0)
+		return(0);
 
 	if (tdp->td_dpp->data_pattern_options & DP_REPLICATE_PATTERN) 
-		remaining = wdp->wd_task.task_xfer_size;
-	else remaining = tdp->td_dpp->data_pattern_length;
+		length = wdp->wd_task.task_xfer_size;
+	else length = tdp->td_dpp->data_pattern_length;
+	if (length > wdp->wd_task.task_xfer_size)
+		length = wdp->wd_task.task_xfer_size;
 
-	offset = 0;
+	patternp = tdp->td_dpp->data_pattern;
 	bufferp = wdp->wd_task.task_datap;
+	ref_length = xdd_verify_reference(reference, patternp, tdp->td_dpp->data_pattern_length);
+	if (ref_length) 
+		refp = reference;
+	else {
+		refp = patternp;
+		ref_length = tdp->td_dpp->data_pattern_length;
+	}
 	errors = 0;
-	while (remaining) {
-		patternp = tdp->td_dpp->data_pattern;
-		for (i=0; i<tdp->td_dpp->data_pattern_length; i++, patternp++, bufferp++) {
-			if (*patternp != *bufferp) {
+	offset = 0;
+	while ((offset = xdd_verify_replicated_scan(bufferp, offset, length, refp, ref_length)) < length) {
+		line_end = offset + XDD_VERIFY_LINE_SIZE;
+		if (line_end > length)
+			line_end = length;
+		for ( ; offset < line_end; offset++) {
+			if (patternp[offset % tdp->td_dpp->data_pattern_length] != bufferp[offset]) {
 				fprintf(xgp->errout,"%s: xdd_verify_hex: Target %d Worker Thread %d: ERROR: Content mismatch on op %lld at %d bytes into block %lld, expected 0x%02x, got 0x%02x\n",
 					xgp->progname, 
 					tdp->td_target_number, 
 					wdp->wd_worker_number, 
 					(long long int)current_op,
-					offset, 
+					(int)offset, 
 					(long long int)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
-					*patternp, 
-					*bufferp);
+					patternp[offset % tdp->td_dpp->data_pattern_length], 
+					bufferp[offset]);
 
 				errors++;
 			}
-			offset++;
-			remaining--;
-			if (remaining <= 0) break;
 		}
 	}
 	return(errors);
@@ -91,33 +297,124 @@ xdd_verify_hex(worker_data_t *wdp, int64_t current_op) {
  * For example, if the prefix is 0x0123 then the hex representation of the sequenced data pattern would look like so:
  *      0123000000000000 0123000000000008 0123000000000010 0123000000000018...
  * Keep in mind that this example is shown in BIG endian so as not to confuse myself.
+ * Whole lines are compared first; only a line with a miscompare is checked word by word.
  */
 int32_t
 xdd_verify_sequence(worker_data_t *wdp, int64_t current_op) {
 	target_data_t	*tdp;
 	size_t  		i,j;
+	size_t			words;			// Number of 8-byte words in the buffer
+	size_t			w, line_end;	// Current word and end of the current line
 	uint64_t	  		errors;
 	uint64_t 		expected_data;
+	uint64_t		prefix;
+	uint64_t		inverse;
 	uint64_t 		*uint64p;
 	unsigned char 	*ucp;        /* A temporary unsigned char pointer */
  
 
 	tdp = wdp->wd_tdp;
 
-	uint64p = (uint64_t *)wdp->wd_task.task_datap;
+	pthread_once(&xdd_verify_sequence_scan_once, xdd_verify_sequence_scan_select);
+	prefix = (tdp->td_dpp->data_pattern_options & DP_PATTERN_PREFIX) ? tdp->td_dpp->data_pattern_prefix_binary : 0; // OR-in the pattern prefix
+	inverse = (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN) ? 0xffffffffffffffffULL : 0; // 1's compliment of the expected data 
+	words = wdp->wd_task.task_xfer_size / sizeof(uint64_t);
+	errors = 0;
+	w = 0;
+	while ((w += xdd_verify_sequence_scan((uint64_t *)wdp->wd_task.task_datap + w, words - w, 
+			wdp->wd_task.task_byte_offset + (w * sizeof(uint64_t)), prefix, inverse)) < words) {
+		line_end = w + XDD_VERIFY_LINE_WORDS;
+		if (line_end > words)
+			line_end = words;
+		for ( ; w < line_end; w++) {
+			uint64p = (uint64_t *)wdp->wd_task.task_datap + w;
+			i = w * sizeof(uint64_t);
+			expected_data = ((wdp->wd_task.task_byte_offset + i) | prefix) ^ inverse;
+
+			if (*uint64p != expected_data) { // If the expected_data pattern is not what we think it should be then scream!
+				//Check how many errors we've had, if too many, then don't print data
+				if (errors <= xgp->max_errors_to_print) {
+					fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: Sequence mismatch on op number %lld at %zd bytes into block %lld\n",
+						xgp->progname, 
+						tdp->td_target_number, 
+						wdp->wd_worker_number, 
+						(long long int)current_op,
+						i, 
+						(long long int)(wdp->wd_task.task_byte_offset/tdp->td_block_size));
+
+					fprintf(xgp->errout, "expected 0x");
+					for (j=0, ucp=(unsigned char *)&expected_data; j<sizeof(uint64_t); j++, ucp++) {
+						fprintf(xgp->errout, "%02x",*ucp);
+					}
+					fprintf(xgp->errout, ", got 0x");
+					for (j=0, ucp=(unsigned char *)uint64p; j<sizeof(uint64_t); j++, ucp++) {
+						fprintf(xgp->errout, "%02x",*ucp);
+					}
+					fprintf(xgp->errout, "\n");
+				}
+				errors++;
+			}
+		}
+	} // end of WHILE loop that looks at all lines with a miscompare
+	//print out remaining error count if exceeded max
+    if (errors > xgp->max_errors_to_print) {
+		fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: ADDITIONAL Data Buffer Content mismatches = %lld\n",
+			    xgp->progname, 
+				tdp->td_target_number, 
+				wdp->wd_worker_number, 
+				(long long int)(errors - (xgp->max_errors_to_print)));
+	}
+	return(errors);
+} // end of xdd_verify_sequence() 
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_random_offset() - Verify data contents of the random by offset data pattern 
+ * Returns the number of miscompare errors. 
+ * Every 8-byte word of this pattern is a function of the seed, the target number, and 
+ * the byte offset of the word in the target, and the compress and dedupe ratios - see 
+ * xdd_random_offset_fill(). Hence the expected data is simply made again from the byte 
+ * offset of this task no matter what request size, seek pattern, or queue depth the 
+ * write pass used. The expected data is made a line at a time and whole lines are 
+ * compared; only a line with a miscompare is checked 8 bytes at a time. A partial
+ * word at the end of the buffer is checked as well.
+ */
+int32_t
+xdd_verify_random_offset(worker_data_t *wdp, int64_t current_op) {
+	target_data_t	*tdp;
+	size_t  		i,j,k;
+	size_t			b, bytes;		// Current byte and number of bytes in the buffer
+	size_t			line_bytes;		// Number of bytes in the current line
+	size_t			n;				// Number of bytes compared at a time
+	uint64_t	  		errors;
+	uint64_t 		expected[XDD_VERIFY_LINE_WORDS];
+	uint64_t		key;
+	unsigned char 	*datap;
+	unsigned char 	*ucp;        /* A temporary unsigned char pointer */
+ 
+
+	tdp = wdp->wd_tdp;
+
+	key = xdd_random_offset_key(tdp->td_dpp->data_pattern_seed, tdp->td_target_number);
+	bytes = wdp->wd_task.task_xfer_size;
+	datap = wdp->wd_task.task_datap;
 	errors = 0;
-	for (i = 0; i < wdp->wd_task.task_xfer_size; i+=(sizeof(wdp->wd_task.task_byte_offset))) {
-		expected_data = wdp->wd_task.task_byte_offset + i;
-		if (tdp->td_dpp->data_pattern_options & DP_PATTERN_PREFIX) { // OR-in the pattern prefix
-			expected_data |= tdp->td_dpp->data_pattern_prefix_binary;
-		} 
-		if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
-			expected_data ^= 0xffffffffffffffffLL; // 1's compliment of the expected data 
-
-		if (*uint64p != expected_data) { // If the expected_data pattern is not what we think it should be then scream!
-			//Check how many errors we've had, if too many, then don't print data
+	for (b = 0; b < bytes; b += line_bytes) {
+		line_bytes = bytes - b;
+		if (line_bytes > sizeof(expected))
+			line_bytes = sizeof(expected);
+		xdd_random_offset_fill_bytes(tdp->td_dpp, key, (unsigned char *)expected, 
+			(uint64_t)wdp->wd_task.task_byte_offset + b, line_bytes);
+		if (memcmp(&datap[b], expected, line_bytes) == 0)
+			continue;
+		for (k = 0; k < line_bytes; k += sizeof(uint64_t)) {
+			n = line_bytes - k;
+			if (n > sizeof(uint64_t))
+				n = sizeof(uint64_t);
+			if (memcmp(&datap[b+k], (unsigned char *)expected + k, n) == 0) 
+				continue;
+			i = b + k;
 			if (errors <= xgp->max_errors_to_print) {
-				fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: Sequence mismatch on op number %lld at %zd bytes into block %lld\n",
+				fprintf(xgp->errout,"%s: xdd_verify_random_offset: Target %d Worker Thread %d: ERROR: Content mismatch on op number %lld at %zu bytes into block %lld\n",
 					xgp->progname, 
 					tdp->td_target_number, 
 					wdp->wd_worker_number, 
@@ -126,29 +423,28 @@ xdd_verify_sequence(worker_data_t *wdp, int64_t current_op) {
 					(long long int)(wdp->wd_task.task_byte_offset/tdp->td_block_size));
 
 				fprintf(xgp->errout, "expected 0x");
-				for (j=0, ucp=(unsigned char *)&expected_data; j<sizeof(uint64_t); j++, ucp++) {
+				for (j=0, ucp=(unsigned char *)expected + k; j<n; j++, ucp++) {
 					fprintf(xgp->errout, "%02x",*ucp);
 				}
 				fprintf(xgp->errout, ", got 0x");
-				for (j=0, ucp=(unsigned char *)uint64p; j<sizeof(uint64_t); j++, ucp++) {
+				for (j=0, ucp=&datap[b+k]; j<n; j++, ucp++) {
 					fprintf(xgp->errout, "%02x",*ucp);
 				}
 				fprintf(xgp->errout, "\n");
 			}
 			errors++;
 		}
-		uint64p++;
-	} // end of FOR loop that looks at all locations 
+	} // end of FOR loop that looks at all lines
 	//print out remaining error count if exceeded max
     if (errors > xgp->max_errors_to_print) {
-		fprintf(xgp->errout,"%s: xdd_verify_sequence: Target %d Worker Thread %d: ERROR: ADDITIONAL Data Buffer Content mismatches = %lld\n",
+		fprintf(xgp->errout,"%s: xdd_verify_random_offset: Target %d Worker Thread %d: ERROR: ADDITIONAL Data Buffer Content mismatches = %lld\n",
 			    xgp->progname, 
 				tdp->td_target_number, 
 				wdp->wd_worker_number, 
 				(long long int)(errors - (xgp->max_errors_to_print)));
 	}
 	return(errors);
-} // end of xdd_verify_sequence() 
+} // end of xdd_verify_random_offset() 
 
 /*----------------------------------------------------------------------------*/
 /* xdd_verify_singlechar() - Verify data contents of a single character data pattern 
@@ -156,34 +452,44 @@ xdd_verify_sequence(worker_data_t *wdp, int64_t current_op) {
  * The single-byte data pattern is specified simply by giving the -datapattern a single character to write to the device. 
  * If that same character is specified for a read operation with the -verify option then that character will be compared with the
  * contents of the I/O buffer for every block read.
+ * Whole lines are compared first; only a line with a miscompare is checked byte by byte.
  */
 int32_t
 xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op) {
 	target_data_t	*tdp;
 	size_t  i;
+	size_t	line_end;
+	size_t	ref_length;
 	int32_t  errors;
 	unsigned char *ucp;
+	unsigned char reference[XDD_VERIFY_REFERENCE_SIZE];
  
 
 	tdp = wdp->wd_tdp;
 
 	ucp = wdp->wd_task.task_datap;
+	ref_length = xdd_verify_reference(reference, tdp->td_dpp->data_pattern, 1);
 	errors = 0;
-	for (i = 0; i < wdp->wd_task.task_xfer_size; i++) {
-		if (*ucp != *(tdp->td_dpp->data_pattern)) {
-			fprintf(xgp->errout,"%s: xdd_verify_singlechar: Target %d Worker Thread %d: ERROR: Content mismatch on op number %lld at %zd bytes into block %lld, expected 0x%02x, got 0x%02x\n",
-				xgp->progname, 
-				tdp->td_target_number, 
-				wdp->wd_worker_number, 
-				(long long int)current_op,
-				i, 
-				(unsigned long long)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
-				*(tdp->td_dpp->data_pattern), 
-				*ucp);
-		errors++;
-		} /* End printing error message */
-		ucp++;
-	} // end of FOR statement that looks at all bytes
+	i = 0;
+	while ((i = xdd_verify_replicated_scan(ucp, i, wdp->wd_task.task_xfer_size, reference, ref_length)) < wdp->wd_task.task_xfer_size) {
+		line_end = i + XDD_VERIFY_LINE_SIZE;
+		if (line_end > wdp->wd_task.task_xfer_size)
+			line_end = wdp->wd_task.task_xfer_size;
+		for ( ; i < line_end; i++) {
+			if (ucp[i] != *(tdp->td_dpp->data_pattern)) {
+				fprintf(xgp->errout,"%s: xdd_verify_singlechar: Target %d Worker Thread %d: ERROR: Content mismatch on op number %lld at %zd bytes into block %lld, expected 0x%02x, got 0x%02x\n",
+					xgp->progname, 
+					tdp->td_target_number, 
+					wdp->wd_worker_number, 
+					(long long int)current_op,
+					i, 
+					(unsigned long long)(wdp->wd_task.task_byte_offset/tdp->td_block_size), 
+					*(tdp->td_dpp->data_pattern), 
+					ucp[i]);
+				errors++;
+			} /* End printing error message */
+		}
+	} // end of WHILE statement that looks at all lines with a miscompare
 
 	return(errors);
 
@@ -195,7 +501,8 @@ xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op) {
  * There are various kinds of data patterns that xdd can read back for comparison. 
  * The user is responsible for using xdd to write the desired data pattern to the device 
  * and then request the proper verification / data pattern.
- * The  data patterns currently supported are: single byte data, hex digits, ascii strings, and 8-byte sequence numbers. 
+ * The  data patterns currently supported are: single byte data, hex digits, ascii strings, 8-byte sequence numbers,
+ * and random data keyed by byte offset. 
  * There is a separate subroutine in this file that handles the verification for each type of data pattern.
  * The subroutine names are obvious. If not, you should not be reading this.
  */
@@ -213,6 +520,11 @@ xdd_verify_contents(worker_data_t *wdp, int64_t current_op) {
 		return(errors);
 	}
 
+	if (tdp->td_dpp->data_pattern_options & DP_RANDOM_BY_OFFSET_PATTERN) { // Lets look at a random by offset data pattern
+		errors = xdd_verify_random_offset(wdp, current_op);
+		return(errors);
+	}
+
 	if (tdp->td_dpp->data_pattern_options & DP_HEX_PATTERN) { // Lets look at a HEX data pattern
 		errors = xdd_verify_hex(wdp, current_op);
 		return(errors);
@@ -235,8 +547,8 @@ xdd_verify_contents(worker_data_t *wdp, int64_t current_op) {
 /*----------------------------------------------------------------------------*/
 /* xdd_verify_location() - Verify data location 
  * This routine gets the current bytes location that is located in the first
- * 8-bytes of the rw buffer and compares it to the current byte location that
- * the calling routine specified in the worker_data_t->my_current_byte_location. If the
+ * 8-bytes of the rw buffer and compares it to the byte offset of the task
+ * that this Worker Thread just completed. If the
  * two do not match then we are not in Kansas anymore. Print an error message
  * and return a 1. Otherwise, everything is peachy, simply return a 0.
  * Returns the number of miscompare errors - 0 or 1 in this case.
@@ -251,14 +563,14 @@ xdd_verify_location(worker_data_t *wdp, int64_t current_op) {
 
 	errors = 0;
 	current_position = *(uint64_t *)wdp->wd_task.task_datap;
-	if (current_position != tdp->td_counters.tc_current_byte_offset) {
+	if (current_position != (uint64_t)wdp->wd_task.task_byte_offset) {
 		errors++;
 		fprintf(xgp->errout,"%s: xdd_verify_location: Target %d Worker Thread %d: ERROR: op number %lld: Data Buffer Sequence mismatch - expected %lld, got %lld\n",
 			xgp->progname, 
 			tdp->td_target_number, 
 			wdp->wd_worker_number, 
-			(long long int)tdp->td_counters.tc_current_op_number, 
-			(long long int)tdp->td_counters.tc_current_byte_offset, 
+			(long long int)current_op, 
+			(long long int)wdp->wd_task.task_byte_offset, 
 			(long long int)current_position);
 
 		fflush(xgp->errout);
@@ -282,8 +594,8 @@ xdd_verify(worker_data_t *wdp, int64_t current_op) {
 	* was specified. If so, then we need to verify that what we read has the correct 
 	* sequence number(s) in it.
 	*/
-	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION))) { // If we don't need to verify location or contents of the buffer, then just return.
-		fprintf(xgp->errout,"%s: xdd_verify: Target %d Worker Thread %d: ERROR: Data verification type <location or contents> not specified - No verification performed.\n",
+	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM))) { // If we don't need to verify location, contents, or checksums of the buffer, then just return.
+		fprintf(xgp->errout,"%s: xdd_verify: Target %d Worker Thread %d: ERROR: Data verification type <location, contents, or checksum> not specified - No verification performed.\n",
 			xgp->progname,
 			tdp->td_target_number,
 			wdp->wd_worker_number);
@@ -291,9 +603,15 @@ xdd_verify(worker_data_t *wdp, int64_t current_op) {
 	}
 
 	// Looks like we need to verify something...
+	errors = 0;
 	if (tdp->td_target_options & TO_VERIFY_LOCATION) /* Assumes that the data pattern was sequenced. If not, there will be LOTS o' errors. */
 		 errors = xdd_verify_location(wdp, current_op);
-	else errors = xdd_verify_contents(wdp, current_op);
+	else if (tdp->td_target_options & TO_VERIFY_CONTENTS)
+		errors = xdd_verify_contents(wdp, current_op);
+
+	// Block checksums work with any data pattern 
+	if (tdp->td_target_options & TO_VERIFY_CHECKSUM)
+		errors += xdd_verify_checksum(wdp, current_op);
 
 	return(errors);
 } /* End of xdd_verify() */
@@ -0,0 +1,292 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of the verifier thread pool used by
+ * the -verifythreads option.
+ * Rather than verifying a read buffer itself, a Worker Thread trades it for
+ * a spare I/O buffer of the pool and goes on with its next task while one of
+ * the verifier threads checks the data. The buffer becomes a spare again once
+ * it has been verified. When there is no spare buffer the Worker Thread waits
+ * for one so that the reads can never run away from the verification.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_pool_thread() - The main loop of a verifier thread.
+ * Jobs are taken off the work queue in the order they were queued and
+ * verified with xdd_verify() on a private copy of the Worker Data Struct
+ * that has the task of the job. Miscompares are added to the compare error
+ * count of the data pattern just like an inline verify does.
+ */
+void *
+xdd_verify_pool_thread(void *data) {
+	xint_verify_pool_t	*vpp;
+	xint_verify_job_t	*jobp;
+	target_data_t		*tdp;
+	worker_data_t		*wdp;		// Private Worker Data Struct of this verifier thread
+	int32_t				errors;
+
+
+	vpp = (xint_verify_pool_t *)data;
+	tdp = vpp->vp_tdp;
+	wdp = (worker_data_t *)calloc(1, sizeof(worker_data_t));
+	if (wdp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_verify_pool_thread: Target %d: ERROR: Cannot allocate %d bytes of memory for the verifier Worker Data Struct\n",
+			xgp->progname, tdp->td_target_number, (int)sizeof(worker_data_t));
+		return(0);
+	}
+	wdp->wd_tdp = tdp;
+
+	for (;;) {
+		pthread_mutex_lock(&vpp->vp_mutex);
+		while ((vpp->vp_headp == NULL) && !vpp->vp_shutdown)
+			pthread_cond_wait(&vpp->vp_work_cond, &vpp->vp_mutex);
+		jobp = vpp->vp_headp;
+		if (jobp == NULL) { // Shut down and nothing left to do
+			pthread_mutex_unlock(&vpp->vp_mutex);
+			break;
+		}
+		vpp->vp_headp = jobp->vj_nextp;
+		if (vpp->vp_headp == NULL)
+			vpp->vp_tailp = NULL;
+		pthread_mutex_unlock(&vpp->vp_mutex);
+
+		wdp->wd_task = jobp->vj_task;
+		wdp->wd_worker_number = jobp->vj_worker_number;
+		errors = xdd_verify(wdp, jobp->vj_task.task_op_number);
+		if (errors) {
+			pthread_mutex_lock(&tdp->td_counters_mutex);
+			tdp->td_dpp->data_pattern_compare_errors += errors;
+			pthread_mutex_unlock(&tdp->td_counters_mutex);
+		}
+
+		// The buffer is a spare again
+		pthread_mutex_lock(&vpp->vp_mutex);
+		jobp->vj_nextp = vpp->vp_freep;
+		vpp->vp_freep = jobp;
+		vpp->vp_pending--;
+		vpp->vp_verified++;
+		pthread_cond_broadcast(&vpp->vp_free_cond);
+		pthread_mutex_unlock(&vpp->vp_mutex);
+	}
+	free(wdp);
+	return(0);
+} // End of xdd_verify_pool_thread()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_pool_init() - Start the verifier threads of a target.
+ * The spare buffers are allocated by xdd_verify_pool_submit() the first time
+ * they are needed because only then is the size of the I/O buffers known.
+ * They come from xdd_io_buffer_alloc() just like the I/O buffers of the
+ * Worker Threads so -sharedmemory and memory locking apply to them too.
+ * An E2E target verifies inline because its buffers carry the E2E header.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_verify_pool_init(target_data_t *tdp) {
+	xint_verify_pool_t	*vpp;
+	int32_t				i;
+	int					status;
+
+
+	vpp = tdp->td_vpp;
+	if ((vpp == NULL) || (vpp->vp_threads <= 0))
+		return(0);
+	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM)) ||
+		(tdp->td_target_options & TO_ENDTOEND)) {
+		vpp->vp_threads = 0;
+		return(0);
+	}
+	if (vpp->vp_buffers <= 0)
+		vpp->vp_buffers = vpp->vp_threads * XDD_VERIFY_POOL_BUFFERS_PER_THREAD;
+	vpp->vp_tdp = tdp;
+	vpp->vp_freep = NULL;
+	vpp->vp_headp = NULL;
+	vpp->vp_tailp = NULL;
+	vpp->vp_pending = 0;
+	vpp->vp_shutdown = 0;
+	vpp->vp_jobs = (xint_verify_job_t *)calloc(vpp->vp_buffers, sizeof(xint_verify_job_t));
+	vpp->vp_threadp = (pthread_t *)calloc(vpp->vp_threads, sizeof(pthread_t));
+	if ((vpp->vp_jobs == NULL) || (vpp->vp_threadp == NULL)) {
+		fprintf(xgp->errout,"%s: xdd_verify_pool_init: Target %d: ERROR: Cannot allocate memory for %d verifier threads with %d buffers\n",
+			xgp->progname, tdp->td_target_number, vpp->vp_threads, vpp->vp_buffers);
+		return(-1);
+	}
+	for (i = 0; i < vpp->vp_buffers; i++) {
+		vpp->vp_jobs[i].vj_nextp = vpp->vp_freep;
+		vpp->vp_freep = &vpp->vp_jobs[i];
+	}
+	pthread_mutex_init(&vpp->vp_mutex, 0);
+	pthread_cond_init(&vpp->vp_work_cond, 0);
+	pthread_cond_init(&vpp->vp_free_cond, 0);
+	for (i = 0; i < vpp->vp_threads; i++) {
+		status = pthread_create(&vpp->vp_threadp[i], NULL, xdd_verify_pool_thread, vpp);
+		if (status) {
+			fprintf(xgp->errout,"%s: xdd_verify_pool_init: Target %d: ERROR: Cannot create verifier thread %d\n",
+				xgp->progname, tdp->td_target_number, i);
+			perror("Reason");
+			vpp->vp_threads = i;
+			xdd_verify_pool_destroy(tdp);
+			return(-1);
+		}
+	}
+	return(0);
+} // End of xdd_verify_pool_init()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_pool_submit() - Hand the buffer that was just read by this
+ * Worker Thread to the verifier threads and give the Worker Thread a spare
+ * buffer for its next task. If all the spare buffers are waiting to be
+ * verified then this waits for one to become free.
+ * Return values: 0 if the buffer was queued, -1 if it could not be and
+ *                the caller has to verify it inline.
+ *
+ * This subroutine is called within the context of a Worker Thread.
+ */
+int32_t
+xdd_verify_pool_submit(worker_data_t *wdp) {
+	xint_verify_pool_t	*vpp;
+	xint_verify_job_t	*jobp;
+	unsigned char		*sparep;
+	nclk_t				wait_start;
+	nclk_t				wait_end;
+
+
+	vpp = wdp->wd_tdp->td_vpp;
+	pthread_mutex_lock(&vpp->vp_mutex);
+	if (vpp->vp_freep == NULL) {
+		vpp->vp_waits++;
+		nclk_now(&wait_start);
+		while (vpp->vp_freep == NULL)
+			pthread_cond_wait(&vpp->vp_free_cond, &vpp->vp_mutex);
+		nclk_now(&wait_end);
+		vpp->vp_wait_time += (wait_end - wait_start);
+	}
+	jobp = vpp->vp_freep;
+	vpp->vp_freep = jobp->vj_nextp;
+	pthread_mutex_unlock(&vpp->vp_mutex);
+
+	if (jobp->vj_bufp == NULL) { // First use of this job - get a buffer like the one of the Worker Thread
+		jobp->vj_bufp = xdd_io_buffer_alloc(wdp->wd_tdp, wdp->wd_buf_size);
+		if (jobp->vj_bufp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_verify_pool_submit: Target %d Worker Thread %d: ERROR: Cannot allocate %d bytes of memory for a verify buffer - verifying inline\n",
+				xgp->progname, wdp->wd_tdp->td_target_number, wdp->wd_worker_number, wdp->wd_buf_size);
+			pthread_mutex_lock(&vpp->vp_mutex);
+			jobp->vj_nextp = vpp->vp_freep;
+			vpp->vp_freep = jobp;
+			pthread_cond_broadcast(&vpp->vp_free_cond);
+			pthread_mutex_unlock(&vpp->vp_mutex);
+			return(-1);
+		}
+		vpp->vp_buf_size = wdp->wd_buf_size;
+	}
+
+	// Trade the buffer that was just read for the spare buffer
+	sparep = jobp->vj_bufp;
+	jobp->vj_bufp = wdp->wd_bufp;
+	jobp->vj_task = wdp->wd_task;
+	jobp->vj_worker_number = wdp->wd_worker_number;
+	jobp->vj_nextp = NULL;
+	wdp->wd_bufp = sparep;
+	wdp->wd_task.task_datap = sparep;
+	wdp->wd_buf_pattern_stale = 1; // A write from this buffer needs the data pattern put back first
+
+	pthread_mutex_lock(&vpp->vp_mutex);
+	if (vpp->vp_tailp)
+		vpp->vp_tailp->vj_nextp = jobp;
+	else vpp->vp_headp = jobp;
+	vpp->vp_tailp = jobp;
+	vpp->vp_pending++;
+	pthread_cond_signal(&vpp->vp_work_cond);
+	pthread_mutex_unlock(&vpp->vp_mutex);
+	return(0);
+} // End of xdd_verify_pool_submit()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_pool_drain() - Wait for the verifier threads to finish all the
+ * buffers that have been handed to them so that the compare errors of a
+ * pass are complete before its results are displayed.
+ */
+void
+xdd_verify_pool_drain(target_data_t *tdp) {
+	xint_verify_pool_t	*vpp;
+
+
+	vpp = tdp->td_vpp;
+	if ((vpp == NULL) || (vpp->vp_threadp == NULL))
+		return;
+	pthread_mutex_lock(&vpp->vp_mutex);
+	while (vpp->vp_pending > 0)
+		pthread_cond_wait(&vpp->vp_free_cond, &vpp->vp_mutex);
+	pthread_mutex_unlock(&vpp->vp_mutex);
+} // End of xdd_verify_pool_drain()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_pool_destroy() - Verify whatever is left, stop the verifier
+ * threads, and wait for them to exit. Then every job is on the free list and
+ * the buffers the jobs hold are freed. Those may have started out as buffers
+ * of the Worker Threads but each trade leaves as many buffers with the jobs
+ * as were allocated for them, and all of them are the same kind.
+ */
+void
+xdd_verify_pool_destroy(target_data_t *tdp) {
+	xint_verify_pool_t	*vpp;
+	int32_t				i;
+
+
+	vpp = tdp->td_vpp;
+	if ((vpp == NULL) || (vpp->vp_threadp == NULL))
+		return;
+	pthread_mutex_lock(&vpp->vp_mutex);
+	vpp->vp_shutdown = 1;
+	pthread_cond_broadcast(&vpp->vp_work_cond);
+	pthread_mutex_unlock(&vpp->vp_mutex);
+	for (i = 0; i < vpp->vp_threads; i++)
+		pthread_join(vpp->vp_threadp[i], NULL);
+	free(vpp->vp_threadp);
+	vpp->vp_threadp = NULL;
+	if (vpp->vp_jobs) {
+		for (i = 0; i < vpp->vp_buffers; i++)
+			xdd_io_buffer_free(tdp, vpp->vp_jobs[i].vj_bufp, vpp->vp_buf_size);
+		free(vpp->vp_jobs);
+		vpp->vp_jobs = NULL;
+	}
+	vpp->vp_freep = NULL;
+} // End of xdd_verify_pool_destroy()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_pool_display() - Display how much the verifier threads of a
+ * target did over the run and how long Worker Threads waited for them
+ * Called by xdd_process_run_results()
+ */
+void
+xdd_verify_pool_display(FILE *out, target_data_t *tdp) {
+	xint_verify_pool_t	*vpp;
+
+
+	vpp = tdp->td_vpp;
+	fprintf(out,"Target %d verifier threads, %llu, buffers verified, %llu, waits for a spare buffer, %.3f, seconds waiting\n",
+		tdp->td_target_number, (unsigned long long)vpp->vp_verified, 
+		(unsigned long long)vpp->vp_waits, (double)vpp->vp_wait_time / FLOAT_BILLION);
+} // End of xdd_verify_pool_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
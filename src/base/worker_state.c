@@ -0,0 +1,228 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-23 I/O Performance, Inc.
+ * Copyright (C) 2009-23 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that keep track of the state of the
+ * Worker Threads in wd_current_state and, for -statetimes, of how long each
+ * Worker Thread spends in each state. Every time a Worker Thread enters or
+ * leaves a state the time since its last change is charged to the state it
+ * was in, so the state times of a pass add up to the time of the pass. The
+ * share of the time spent waiting on the ordering of the ops, the TOT locks, or
+ * the Target Thread rather than on the I/O tells whether a run is bound by
+ * the device or by xdd itself.
+ * The subroutines also time the handoff of each task from the Target Thread
+ * to the Worker Thread for -dispatchstats and the time stamp entries.
+ */
+#include "xint.h"
+
+// Names of the state times in the order of WORKER_STATE_TIME_*
+static char *xdd_worker_state_names[WORKER_STATE_TIMES] = {
+	"busy", "io", "receive", "send", "ordering", "tot_lock", "barrier"
+};
+static char *xdd_worker_state_titles[WORKER_STATE_TIMES] = {
+	"Busy", "I/O", "Receive", "Send", "Ordering", "TOT lock", "Barrier"
+};
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_index() - Return the state time to charge for a set of
+ * WORKER_CURRENT_STATE_* bits
+ */
+static int
+xdd_worker_state_index(uint32_t state) {
+	if (state & WORKER_CURRENT_STATE_IO)
+		return(WORKER_STATE_TIME_IO);
+	if (state & WORKER_CURRENT_STATE_DEST_RECEIVE)
+		return(WORKER_STATE_TIME_DEST_RECEIVE);
+	if (state & WORKER_CURRENT_STATE_SRC_SEND)
+		return(WORKER_STATE_TIME_SRC_SEND);
+	if (state & WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO)
+		return(WORKER_STATE_TIME_PREVIOUS_IO);
+	if (state & (WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_UPDATE |
+				 WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE |
+				 WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS))
+		return(WORKER_STATE_TIME_TOT_LOCK);
+	if (state & WORKER_CURRENT_STATE_BARRIER)
+		return(WORKER_STATE_TIME_BARRIER);
+	return(WORKER_STATE_TIME_BUSY);
+} // End of xdd_worker_state_index()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_charge() - Charge the time since the last change of state
+ * up to "now" to the state the Worker Thread is in
+ */
+static void
+xdd_worker_state_charge(worker_data_t *wdp, nclk_t now) {
+	if (now > wdp->wd_state_time_stamp) {
+		wdp->wd_state_time[xdd_worker_state_index(wdp->wd_current_state)] += (now - wdp->wd_state_time_stamp);
+		wdp->wd_state_time_stamp = now;
+	}
+} // End of xdd_worker_state_charge()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_enter() - Put a Worker Thread into a state
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_worker_state_enter(worker_data_t *wdp, uint32_t state) {
+	nclk_t	now;
+
+
+	if (wdp->wd_tdp->td_planp->plan_options & PLAN_STATE_TIMES) {
+		nclk_now(&now);
+		xdd_worker_state_charge(wdp, now);
+	}
+	wdp->wd_current_state |= state;
+} // End of xdd_worker_state_enter()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_leave() - Take a Worker Thread out of a state
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_worker_state_leave(worker_data_t *wdp, uint32_t state) {
+	nclk_t	now;
+
+
+	if (wdp->wd_tdp->td_planp->plan_options & PLAN_STATE_TIMES) {
+		nclk_now(&now);
+		xdd_worker_state_charge(wdp, now);
+	}
+	wdp->wd_current_state &= ~state;
+} // End of xdd_worker_state_leave()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_task_setup() - Note when the task of an op was set up for
+ * -dispatchstats and for the time stamp entry of the op
+ * This subroutine is called within the context of a Target Thread right
+ * before it releases the Worker Thread with the task.
+ */
+void
+xdd_worker_state_task_setup(worker_data_t *wdp) {
+	target_data_t	*tdp;
+
+
+	tdp = wdp->wd_tdp;
+	if ((tdp->td_planp->plan_options & PLAN_DISPATCH_STATS) || (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)))
+		nclk_now(&wdp->wd_task.task_setup_time);
+	else wdp->wd_task.task_setup_time = 0;
+} // End of xdd_worker_state_task_setup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_task_wakeup() - Note when the Worker Thread picked up a
+ * task that was timed by xdd_worker_state_task_setup()
+ * This subroutine is called within the context of a Worker Thread.
+ */
+void
+xdd_worker_state_task_wakeup(worker_data_t *wdp) {
+	if (wdp->wd_task.task_setup_time)
+		nclk_now(&wdp->wd_task.task_wakeup_time);
+} // End of xdd_worker_state_task_wakeup()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_before_pass() - Start the state times of a pass over
+ * This subroutine is called within the context of a Target Thread while the
+ * Worker Thread waits for its first task of the pass.
+ */
+void
+xdd_worker_state_before_pass(worker_data_t *wdp) {
+	memset(wdp->wd_state_time, 0, sizeof(wdp->wd_state_time));
+	nclk_now(&wdp->wd_state_time_stamp);
+} // End of xdd_worker_state_before_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_pass_end() - Charge the time of each Worker Thread of a
+ * target up to the end of the pass and add the state times of the pass to
+ * those of the run.
+ * This subroutine is called by the Results Manager at the end of each pass
+ * while the Worker Threads are idle.
+ */
+void
+xdd_worker_state_pass_end(target_data_t *tdp) {
+	worker_data_t	*wdp;
+	int				i;
+
+
+	if (!(tdp->td_planp->plan_options & PLAN_STATE_TIMES))
+		return;
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		xdd_worker_state_charge(wdp, tdp->td_counters.tc_pass_end_time);
+		for (i = 0; i < WORKER_STATE_TIMES; i++)
+			wdp->wd_state_time_total[i] += wdp->wd_state_time[i];
+	}
+} // End of xdd_worker_state_pass_end()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_name() - Return the name of a state time
+ */
+char *
+xdd_worker_state_name(int index) {
+	return(xdd_worker_state_names[index]);
+} // End of xdd_worker_state_name()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_display_line() - Display the state times of one Worker
+ * Thread or of all of them as a share of their sum
+ */
+static void
+xdd_worker_state_display_line(FILE *out, char *who, nclk_t *times) {
+	nclk_t	sum;
+	int		i;
+
+
+	sum = 0;
+	for (i = 0; i < WORKER_STATE_TIMES; i++)
+		sum += times[i];
+	fprintf(out,"%8s %12.6f", who, (double)sum / FLOAT_BILLION);
+	for (i = 0; i < WORKER_STATE_TIMES; i++)
+		fprintf(out," %9.2f", (sum > 0) ? (100.0 * (double)times[i]) / (double)sum : 0.0);
+	fprintf(out,"\n");
+} // End of xdd_worker_state_display_line()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_worker_state_display() - Display the share of the time of the run the
+ * Worker Threads of a target spent in each state
+ * Called by xdd_process_run_results()
+ */
+void
+xdd_worker_state_display(FILE *out, target_data_t *tdp) {
+	worker_data_t	*wdp;
+	nclk_t			all[WORKER_STATE_TIMES];	// Sum of the state times of all the Worker Threads
+	char			who[16];
+	int				i;
+
+
+	fprintf(out,"Target %d Worker Thread time in state, percent of time\n", tdp->td_target_number);
+	fprintf(out,"%8s %12s", "Worker", "Time(s)");
+	for (i = 0; i < WORKER_STATE_TIMES; i++)
+		fprintf(out," %9s", xdd_worker_state_titles[i]);
+	fprintf(out,"\n");
+	memset(all, 0, sizeof(all));
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		sprintf(who, "%d", wdp->wd_worker_number);
+		xdd_worker_state_display_line(out, who, wdp->wd_state_time_total);
+		for (i = 0; i < WORKER_STATE_TIMES; i++)
+			all[i] += wdp->wd_state_time_total[i];
+	}
+	xdd_worker_state_display_line(out, "All", all);
+	fflush(out);
+} // End of xdd_worker_state_display()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
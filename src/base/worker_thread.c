@@ -60,6 +60,7 @@ xdd_worker_thread(void *pin) {
 		// Enter the WorkerThread_TargetPass_Wait barrier until we are assigned something to do by targetpass()
 		nclk_now(&checktime);
 		xdd_barrier(&wdp->wd_thread_targetpass_wait_for_task_barrier,&wdp->wd_occupant,1);
+		xdd_worker_state_task_wakeup(wdp);
 
 		// Look at Task request 
 		switch (wdp->wd_task.task_request) {
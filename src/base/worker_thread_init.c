@@ -168,6 +168,10 @@ xdd_worker_thread_init(worker_data_t *wdp) {
 	// Set proper data pattern in Data buffer
 	xdd_datapattern_buffer_init(wdp);
 
+	// Get the latency histograms of this Worker Thread
+	if (xdd_histogram_worker_init(wdp))
+		return(-1);
+
 	// Init the WorkerThread-TargetPass WAIT Barrier for this WorkerThread
 	sprintf(tmpname,"T%04d:W%04d>worker_thread_targetpass_wait_barrier",tdp->td_target_number,wdp->wd_worker_number);
 	status = xdd_init_barrier(tdp->td_planp, &wdp->wd_thread_targetpass_wait_for_task_barrier, 2, tmpname);
@@ -98,9 +98,9 @@ xdd_worker_thread_io(worker_data_t *wdp) {
 		xdd_worker_thread_release_next_io(wdp);
 
 	// Call the OS-appropriate IO routine to perform the I/O
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_IO;
+	xdd_worker_state_enter(wdp, WORKER_CURRENT_STATE_IO);
 	xdd_io_for_os(wdp);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_IO;
+	xdd_worker_state_leave(wdp, WORKER_CURRENT_STATE_IO);
 
 	// Update counters and status in this Worker Thread's Data
 	xdd_worker_thread_update_local_counters(wdp);
@@ -124,6 +124,80 @@ xdd_worker_thread_io(worker_data_t *wdp) {
 
 } // End of xdd_worker_thread_io()
 
+/*----------------------------------------------------------------------------*/
+/* xdd_sparse_hole_check() - For a target with the -sparse option, find out
+ * with SEEK_DATA whether the range of the current read task lies entirely in
+ * a hole of the file in which case there is no need to read it - the caller
+ * zeroes the buffer instead, except on an E2E Source that only describes the hole.
+ * A range that is partly data, or that runs past the end of the file, is read
+ * as usual. The XNI transport always moves the data.
+ * Return value is 1 if the range is a hole, 0 otherwise.
+ */
+int32_t
+xdd_sparse_hole_check(worker_data_t *wdp) {
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+	target_data_t	*tdp;
+	off_t			data;			// Start of the next data at or after the task offset
+	off_t			end;			// End of the range of this task
+	off_t			end_of_file;	// Size of the file
+
+
+	tdp = wdp->wd_tdp;
+	if (!(tdp->td_target_options & TO_SPARSE) || (tdp->td_target_options & (TO_SGIO | TO_NULL_TARGET)))
+		return(0);
+	if ((tdp->td_target_options & TO_ENDTOEND) && (tdp->td_planp->plan_options & PLAN_ENABLE_XNI))
+		return(0);
+	end = wdp->wd_task.task_byte_offset + wdp->wd_task.task_xfer_size;
+	data = lseek(wdp->wd_task.task_file_desc, wdp->wd_task.task_byte_offset, SEEK_DATA);
+	if (data >= 0) 
+		return((data >= end) ? 1 : 0);
+	if (errno != ENXIO) // The file system cannot tell - read the data
+		return(0);
+	// No more data after this offset - it is a hole if the range is inside the file
+	end_of_file = lseek(wdp->wd_task.task_file_desc, 0, SEEK_END);
+	return(((end_of_file >= 0) && (end <= end_of_file)) ? 1 : 0);
+#else
+	return(0);
+#endif
+} // End of xdd_sparse_hole_check()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_sparse_punch_hole() - Recreate a hole described by the Source Side of
+ * an E2E operation on the Destination Side. The range is deallocated with 
+ * fallocate(PUNCH_HOLE) when the file system supports it, otherwise zeros
+ * are written. The end of the highest hole is remembered so that the file 
+ * can be extended with ftruncate() at the end of the pass when it ends in a hole.
+ * Return value is the number of bytes in the hole or -1 on error.
+ */
+ssize_t
+xdd_sparse_punch_hole(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	ssize_t			status;
+	uint64_t		end;			// End of the range of this task
+
+
+	tdp = wdp->wd_tdp;
+	status = -1;
+#if defined(FALLOC_FL_PUNCH_HOLE) && defined(FALLOC_FL_KEEP_SIZE)
+	if (fallocate(wdp->wd_task.task_file_desc, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+			wdp->wd_task.task_byte_offset, wdp->wd_task.task_xfer_size) == 0)
+		status = wdp->wd_task.task_xfer_size;
+#endif
+	if (status < 0) { // No hole punching here - write zeros instead
+		memset(wdp->wd_task.task_datap, 0, wdp->wd_task.task_xfer_size);
+		status = pwrite(wdp->wd_task.task_file_desc,
+						wdp->wd_task.task_datap,
+						wdp->wd_task.task_xfer_size,
+						wdp->wd_task.task_byte_offset);
+	}
+	end = wdp->wd_task.task_byte_offset + wdp->wd_task.task_xfer_size;
+	pthread_mutex_lock(&tdp->td_counters_mutex);
+	if (end > tdp->td_hole_end)
+		tdp->td_hole_end = end;
+	pthread_mutex_unlock(&tdp->td_counters_mutex);
+	return(status);
+} // End of xdd_sparse_punch_hole()
+
 /*----------------------------------------------------------------------------*/
 /* xdd_worker_thread_wait_for_previous_io() - This subroutine will wait for
  * the previous Worker Thread I/O to complete.
@@ -155,14 +229,14 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 
 
 	tep = &tdp->td_totp->tot_entry[tot_offset];
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS;
+	xdd_worker_state_enter(wdp, WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS);
 	pthread_mutex_lock(&tep->tot_mutex);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS;
+	xdd_worker_state_leave(wdp, WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS);
 	nclk_now(&tep->tot_wait_ts);
 
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM WAITING FOR PREVIOUS IO starting at %lld\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,(long long int)tep->tot_wait_ts);
 if (xgp->global_options & GO_DEBUG_TOT) xdd_show_tot_entry(tdp->td_totp,tot_offset);
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
+	xdd_worker_state_enter(wdp, WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO);
 
 	totwp = &wdp->wd_tot_wait;
 	if (TOT_ENTRY_UNAVAILABLE == tep->tot_status) {
@@ -180,7 +254,7 @@ if (xgp->global_options & GO_DEBUG_TOT) xdd_show_tot_entry(tdp->td_totp,tot_offs
 		}
 		totwp->totw_is_released = 0; 
 	}
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO;
+	xdd_worker_state_leave(wdp, WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO);
 	tep->tot_status = TOT_ENTRY_UNAVAILABLE;
 	pthread_mutex_unlock(&tep->tot_mutex);
 if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worker_thread_wait_for_previous_io: Target: %d: Worker: %d: tot_offset: %d: I AM DONE WAITING FOR PREVIOUS IO - released by worker %d\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number,tot_offset,tep->tot_post_worker_thread_number);
@@ -212,9 +286,9 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 
 	tep = &tdp->td_totp->tot_entry[tot_offset];
 	totwp = &wdp->wd_tot_wait;
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE;
+	xdd_worker_state_enter(wdp, WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE);
 	pthread_mutex_lock(&tep->tot_mutex);
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE;
+	xdd_worker_state_leave(wdp, WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE);
 	tep->tot_post_worker_thread_number = wdp->wd_worker_number;
 	nclk_now(&tep->tot_post_ts);
 
@@ -346,6 +420,8 @@ if (xgp->global_options & GO_DEBUG_IO) fprintf(stderr,"DEBUG_IO: %lld: xdd_worke
 void
 xdd_worker_thread_update_target_counters(worker_data_t *wdp) {
 	target_data_t	*tdp;			// Pointer to the Tartget's Data
+	seek_size_class_t	*scp;		// Pointer to the request size class of this op
+	seek_extent_t		*ep;		// Pointer to the file extent of this op
 
 	// Get the pointer to the Target's Data
 	tdp = wdp->wd_tdp;
@@ -358,6 +434,8 @@ xdd_worker_thread_update_target_counters(worker_data_t *wdp) {
 	pthread_mutex_lock(&tdp->td_counters_mutex);
 	// Update counters and status in the Worker Thread Data
 	tdp->td_counters.tc_accumulated_op_time += tdp->td_counters.tc_current_op_elapsed_time;
+	tdp->td_counters.tc_accumulated_pattern_fill_time += wdp->wd_counters.tc_current_pattern_fill_time;
+	wdp->wd_counters.tc_current_pattern_fill_time = 0;
 	if (wdp->wd_task.task_io_status == (ssize_t) wdp->wd_task.task_xfer_size) { // Only update counters if I/O succeeded
 		tdp->td_current_bytes_completed += wdp->wd_task.task_xfer_size;
 		tdp->td_counters.tc_accumulated_bytes_xfered += wdp->wd_task.task_xfer_size;
@@ -384,6 +462,27 @@ xdd_worker_thread_update_target_counters(worker_data_t *wdp) {
 			default:
 				break;
 		} // End of SWITCH
+		// Holes skipped in a sparse file
+		if (wdp->wd_task.task_hole) {
+			tdp->td_hole_ops++;
+			tdp->td_hole_bytes += wdp->wd_task.task_xfer_size;
+		}
+		// Per request size counters when request sizes vary
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) {
+			scp = xdd_get_size_class(&tdp->td_seekhdr, tdp->td_seekhdr.seeks[wdp->wd_task.task_op_number].reqsize);
+			if (scp) {
+				scp->ops++;
+				scp->bytes += wdp->wd_task.task_xfer_size;
+				scp->op_time += wdp->wd_counters.tc_current_op_elapsed_time;
+			}
+		}
+		// Per file extent counters when the seek list walks the extents of the file
+		ep = xdd_get_seek_extent(&tdp->td_seekhdr, wdp->wd_task.task_op_number);
+		if (ep) {
+			ep->ops++;
+			ep->bytes += wdp->wd_task.task_xfer_size;
+			ep->op_time += wdp->wd_counters.tc_current_op_elapsed_time;
+		}
 	} // End of IF clause that updates counters
 
 	// If this Worker Thread got an I/O error then its error count will be 1, otherwise it will be zero
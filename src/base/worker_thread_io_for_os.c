@@ -37,6 +37,8 @@ xdd_io_for_os(worker_data_t *wdp) {
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
 		ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
 		ttep->tte_disk_start = wdp->wd_counters.tc_current_op_start_time;
+		ttep->tte_task_setup = wdp->wd_task.task_setup_time;
+		ttep->tte_worker_wakeup = wdp->wd_task.task_wakeup_time;
 		ttep->tte_disk_processor_start = xdd_get_processor();
 	}
 
@@ -45,10 +47,15 @@ xdd_io_for_os(worker_data_t *wdp) {
 	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  // Write Operation
 		wdp->wd_task.task_op_string = "WRITE";
 		// Call xdd_datapattern_fill() to fill the buffer with any required patterns
-		xdd_datapattern_fill(wdp);
+		if (!wdp->wd_task.task_hole)
+			xdd_datapattern_fill(wdp);
 
 		if (tdp->td_target_options & TO_NULL_TARGET) { // If this is a NULL target then we fake the I/O
 			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
+		} else if (wdp->wd_task.task_hole) { // The E2E Source found a hole here - recreate it
+			wdp->wd_task.task_io_status = xdd_sparse_punch_hole(wdp);
+		} else if ((wdp->wd_task.task_compound == TASK_COMPOUND_RMW) && (xdd_compound_rmw_read(wdp) < 0)) {
+			// The read of a read-modify-write failed - task_io_status is its status
 		} else { // Issue the actual operation
 			if ((tdp->td_target_options & TO_SGIO)) 
 			 	wdp->wd_task.task_io_status = xdd_sg_io(wdp,'w'); // Issue the SGIO operation 
@@ -68,9 +75,15 @@ if (xgp->global_options & GO_DEBUG_IO) xdd_show_task(&wdp->wd_task);
 		}
 	} else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_READ) {  // READ Operation
 		wdp->wd_task.task_op_string = "READ";
+		wdp->wd_task.task_hole = xdd_sparse_hole_check(wdp);
 
 		if (tdp->td_target_options & TO_NULL_TARGET) { // If this is a NULL target then we fake the I/O
 			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
+		} else if (wdp->wd_task.task_hole) { // Nothing but a hole here - there is no need to read it
+			// A hole reads as zeros - the E2E Source only sends a description of the hole
+			if (!(tdp->td_target_options & TO_E2E_SOURCE))
+				memset(wdp->wd_task.task_datap, 0, wdp->wd_task.task_xfer_size);
+			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
 		} else { // Issue the actual operation
 			if ((tdp->td_target_options & TO_SGIO)) 
 			 	wdp->wd_task.task_io_status = xdd_sg_io(wdp,'r'); // Issue the SGIO operation 
@@ -131,6 +144,8 @@ xdd_io_for_os(worker_data_t *wdp) {
 	ttep = &tdp->td_ts_table.ts_hdrp->tsh_tte[wdp->wd_ts_entry];
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
 		ttep->tte_disk_start = wdp->wd_counters.tc_current_op_start_time;
+		ttep->tte_task_setup = wdp->wd_task.task_setup_time;
+		ttep->tte_worker_wakeup = wdp->wd_task.task_wakeup_time;
 		ttep->tte_disk_processor_start = xdd_get_processor();
 	}
 
@@ -139,10 +154,15 @@ xdd_io_for_os(worker_data_t *wdp) {
 	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {  // Write Operation
 		wdp->wd_task.task_op_string = "WRITE";
 		// Call xdd_datapattern_fill() to fill the buffer with any required patterns
-		xdd_datapattern_fill(wdp);
+		if (!wdp->wd_task.task_hole)
+			xdd_datapattern_fill(wdp);
 
 		if (tdp->td_target_options & TO_NULL_TARGET) { // If this is a NULL target then we fake the I/O
 			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
+		} else if (wdp->wd_task.task_hole) { // The E2E Source found a hole here - recreate it
+			wdp->wd_task.task_io_status = xdd_sparse_punch_hole(wdp);
+		} else if ((wdp->wd_task.task_compound == TASK_COMPOUND_RMW) && (xdd_compound_rmw_read(wdp) < 0)) {
+			// The read of a read-modify-write failed - task_io_status is its status
 		} else { // Issue the actual operation
 			if (!(tdp->td_target_options & TO_NULL_TARGET))
                             wdp->wd_task.task_io_status = pwrite(wdp->wd_task.task_file_desc,
@@ -154,9 +174,15 @@ xdd_io_for_os(worker_data_t *wdp) {
 		}
 	} else if (wdp->wd_task.task_op_type == TASK_OP_TYPE_READ) {  // READ Operation
 		wdp->wd_task.task_op_string = "READ";
+		wdp->wd_task.task_hole = xdd_sparse_hole_check(wdp);
 
 		if (tdp->td_target_options & TO_NULL_TARGET) { // If this is a NULL target then we fake the I/O
 			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
+		} else if (wdp->wd_task.task_hole) { // Nothing but a hole here - there is no need to read it
+			// A hole reads as zeros - the E2E Source only sends a description of the hole
+			if (!(tdp->td_target_options & TO_E2E_SOURCE))
+				memset(wdp->wd_task.task_datap, 0, wdp->wd_task.task_xfer_size);
+			wdp->wd_task.task_io_status = wdp->wd_task.task_xfer_size;
 		} else { // Issue the actual operation
 			if (!(tdp->td_target_options & TO_NULL_TARGET))
                             wdp->wd_task.task_io_status = pread(wdp->wd_task.task_file_desc,
@@ -197,6 +197,54 @@ xdd_raw_after_io_op(worker_data_t *wdp) {
 	}
 } // End of xdd_raw_after_io_op(wdp) 
 
+/*----------------------------------------------------------------------------*/
+/* xdd_verify_after_io_op() - This subroutine will verify the location,
+ * contents, or block checksums of the data that was just read if -verify 
+ * was specified. Miscompares are added to the compare error count of the 
+ * data pattern. With -verifythreads the read buffer is handed to the 
+ * verifier threads instead. For -verify checksum the checksums of the blocks that were
+ * just written are recorded.
+ * This subroutine is called by the xdd_worker_thread_ttd_after_io_op() for every I/O.
+ * 
+ * This subroutine is called within the context of a Worker Thread.
+ *
+ */
+void
+xdd_verify_after_io_op(worker_data_t *wdp) {
+	target_data_t	*tdp;
+	int32_t			errors;
+
+
+	tdp = wdp->wd_tdp;
+	if (!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM)) && (tdp->td_mfp == NULL))
+		return;
+	// Only complete transfers of real data can be checked
+	if ((wdp->wd_task.task_io_status != (ssize_t)wdp->wd_task.task_xfer_size) ||
+		(wdp->wd_task.task_hole) || (tdp->td_target_options & TO_NULL_TARGET))
+		return;
+	if (wdp->wd_task.task_op_type == TASK_OP_TYPE_WRITE) {
+		if (tdp->td_target_options & TO_VERIFY_CHECKSUM)
+			xdd_checksum_record(wdp);
+		if (tdp->td_mfp)
+			xdd_manifest_record(wdp);
+		return;
+	}
+	if ((wdp->wd_task.task_op_type != TASK_OP_TYPE_READ) ||
+		!(tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION | TO_VERIFY_CHECKSUM)))
+		return;
+
+	// With -verifythreads the buffer is verified by the verifier threads while this Worker Thread goes on
+	if (tdp->td_vpp && (tdp->td_vpp->vp_threads > 0) && (xdd_verify_pool_submit(wdp) == 0))
+		return;
+
+	errors = xdd_verify(wdp, wdp->wd_task.task_op_number);
+	if (errors) {
+		pthread_mutex_lock(&tdp->td_counters_mutex);
+		tdp->td_dpp->data_pattern_compare_errors += errors;
+		pthread_mutex_unlock(&tdp->td_counters_mutex);
+	}
+} // End of xdd_verify_after_io_op(wdp) 
+
 /*----------------------------------------------------------------------------*/
 /* xdd_e2e_after_io_op() - This subroutine will do 
  * all the processing necessary for an end-to-end operation.
@@ -223,9 +271,19 @@ if (xgp->global_options & GO_DEBUG_E2E) xdd_show_task(&wdp->wd_task);
 			// For Loose Ordering we get released just *before* the previous Worker Thread actually performs its sendto() 
 			// operation. 
 
-			// Send the data to the Destination machine
-			wdp->wd_e2ep->e2e_hdrp->e2eh_magic = XDD_E2E_DATA_READY;
-			wdp->wd_current_state |= WORKER_CURRENT_STATE_SRC_SEND;
+			// Send the data to the Destination machine - or just describe the hole if there was no data
+			if (wdp->wd_task.task_hole)
+				wdp->wd_e2ep->e2e_hdrp->e2eh_magic = XDD_E2E_HOLE;
+			else wdp->wd_e2ep->e2e_hdrp->e2eh_magic = XDD_E2E_DATA_READY;
+			// With -e2e checksum the destination checks the data against its CRC32C before writing it
+			if ((tdp->td_target_options & TO_E2E_CHECKSUM) && !wdp->wd_task.task_hole) {
+				wdp->wd_e2ep->e2e_hdrp->e2eh_flags = XDD_E2E_FLAG_CRC;
+				wdp->wd_e2ep->e2e_hdrp->e2eh_data_crc = (uint32_t)xdd_checksum_block(XDD_CHECKSUM_CRC32C, wdp->wd_task.task_datap, wdp->wd_task.task_xfer_size);
+			} else {
+				wdp->wd_e2ep->e2e_hdrp->e2eh_flags = 0;
+				wdp->wd_e2ep->e2e_hdrp->e2eh_data_crc = 0;
+			}
+			xdd_worker_state_enter(wdp, WORKER_CURRENT_STATE_SRC_SEND);
 
 			if (PLAN_ENABLE_XNI & tdp->td_planp->plan_options) {
 				status = xint_e2e_xni_send(wdp);
@@ -233,9 +291,12 @@ if (xgp->global_options & GO_DEBUG_E2E) xdd_show_task(&wdp->wd_task);
 			else {
 if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e_after_io_op: Target: %d: Worker: %d: Calling xdd_e2e_src_send...\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number);
                 status = xdd_e2e_src_send(wdp);
+				// Answer any requests of the destination to send data again
+				if ((status == 0) && (tdp->td_target_options & TO_E2E_CHECKSUM))
+					status = xdd_e2e_src_check_resend(wdp);
 if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e_after_io_op: Target: %d: Worker: %d: Returned from xdd_e2e_src_send...\n", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number);
 			}
-			wdp->wd_current_state &= ~WORKER_CURRENT_STATE_SRC_SEND;
+			xdd_worker_state_leave(wdp, WORKER_CURRENT_STATE_SRC_SEND);
 		
 			//If the status is "-1" then something bad happened
 			if (status == -1) {
@@ -347,12 +408,24 @@ xdd_worker_thread_ttd_after_io_op(worker_data_t *wdp) {
 	// Read-After_Write Processing
 	xdd_raw_after_io_op(wdp);
 
+	// Data Verification
+	xdd_verify_after_io_op(wdp);
+
+	// Read-Modify-Write and Write-Verify Processing
+	xdd_compound_after_io_op(wdp);
+
 	// End-to-End Processing
 	xdd_e2e_after_io_op(wdp);
 
 	// Extended Statistics 
 	xdd_extended_stats(wdp);
 
+	// Latency Histograms
+	xdd_histogram_after_io_op(wdp);
+
+	// Streamed Time Stamps
+	xdd_ts_stream_after_io_op(wdp);
+
 	// Send Operation Status Checking
 	xdd_status_after_io_op(wdp);
 
@@ -205,20 +205,27 @@ xdd_e2e_before_io_op(worker_data_t *wdp) {
 
 	// Lets read a packet of data from the Source side
 	// The call to xdd_e2e_dest_recv() will block until there is data to read 
-	wdp->wd_current_state |= WORKER_CURRENT_STATE_DEST_RECEIVE;
+	xdd_worker_state_enter(wdp, WORKER_CURRENT_STATE_DEST_RECEIVE);
 
         if (PLAN_ENABLE_XNI & tdp->td_planp->plan_options) {
             status = xint_e2e_xni_recv(wdp);
+            if (status == 0)
+                status = xdd_e2e_dest_check(wdp);
         }
         else {
 
 if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e_before_io_op: Target: %d: Worker: %d: Calling xdd_e2e_dest_recv...\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number);
 
-	    status = xdd_e2e_dest_receive(wdp);
+	    // A message whose data does not match its CRC32C is dropped and the next one received in its place
+	    do {
+		    status = xdd_e2e_dest_receive(wdp);
+		    if (status == 0)
+			    status = xdd_e2e_dest_check(wdp);
+	    } while (status == 1);
 
 if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e_before_io_op: Target: %d: Worker: %d: Returning from xdd_e2e_dest_recv: e2e header:\n ", (long long int)pclk_now(),tdp->td_target_number,wdp->wd_worker_number);
         }
-	wdp->wd_current_state &= ~WORKER_CURRENT_STATE_DEST_RECEIVE;
+	xdd_worker_state_leave(wdp, WORKER_CURRENT_STATE_DEST_RECEIVE);
 
 	// If status is "-1" then soemthing happened to the connection - time to leave
 	if (status == -1) 
@@ -234,8 +241,12 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	wdp->wd_task.task_byte_offset = wdp->wd_e2ep->e2e_hdrp->e2eh_byte_offset;
 	wdp->wd_task.task_xfer_size = wdp->wd_e2ep->e2e_hdrp->e2eh_data_length;
 	wdp->wd_task.task_op_number = wdp->wd_e2ep->e2e_hdrp->e2eh_sequence_number;
+	// A hole in a sparse source file comes without data and is recreated rather than written
+	wdp->wd_task.task_hole = (wdp->wd_e2ep->e2e_hdrp->e2eh_magic == XDD_E2E_HOLE);
 	// Record the amount of data received 
-	wdp->wd_e2ep->e2e_data_recvd = wdp->wd_e2ep->e2e_hdrp->e2eh_data_length;
+	if (wdp->wd_task.task_hole)
+		wdp->wd_e2ep->e2e_data_recvd = 0;
+	else wdp->wd_e2ep->e2e_data_recvd = wdp->wd_e2ep->e2e_hdrp->e2eh_data_length;
 
 	return(0);
 
@@ -85,6 +85,9 @@ int xint_plan_start(xdd_plan_t* planp, xdd_occupant_t* barrier_occupant) {
     rc += xdd_init_barrier(planp, &planp->main_targets_syncio_barrier,
 						   planp->number_of_targets,
 						   "main_targets_syncio_barrier");
+    rc += xdd_init_barrier(planp, &planp->main_targets_sharedfile_barrier,
+						   planp->number_of_targets,
+						   "main_targets_sharedfile_barrier");
     rc += xdd_init_barrier(planp, &planp->main_results_final_barrier, 2,
 						   "main_results_final_barrier");
     if (0 != rc)  {
@@ -112,6 +115,15 @@ int xint_plan_start(xdd_plan_t* planp, xdd_occupant_t* barrier_occupant) {
 	/* Start a heartbeat monitor if necessary */
 	xint_plan_start_heartbeat(planp);
 
+	/* Start the interval statistics writer if necessary */
+	xdd_timeseries_start(planp);
+
+	/* Start the live statistics updater if necessary */
+	xdd_shmstats_start(planp);
+
+	/* Start the metrics server if necessary */
+	xdd_metrics_start(planp);
+
 	/* Start a restart monitor if necessary */
 	xint_plan_start_restart_monitor(planp);
 
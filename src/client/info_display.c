@@ -186,8 +186,35 @@ xdd_options_info(xdd_plan_t* planp, FILE *out) {
 	fprintf(out, "Pass Delay in seconds, %f\n", planp->pass_delay); 
 	fprintf(out, "Maximum Error Threshold, %lld\n", (long long)xgp->max_errors);
 	fprintf(out, "Target Offset, %lld\n",(long long)planp->target_offset);
+	if (planp->plan_options & (PLAN_SHARED_FILE_STRIDED | PLAN_SHARED_FILE_SEGMENTED))
+		fprintf(out, "Shared File Layout, %s%s\n",
+			(planp->plan_options & PLAN_SHARED_FILE_STRIDED)?"strided":"segmented",
+			(planp->plan_options & PLAN_SHARED_FILE_FLUSH)?", collective flush":"");
+	else if (planp->plan_options & PLAN_SHARED_FILE_FLUSH)
+		fprintf(out, "Shared File Layout, collective flush\n");
 	fprintf(out, "I/O Synchronization, %d\n", planp->syncio);
 	fprintf(out, "Total run-time limit in seconds, %f\n", planp->run_time);
+	if (planp->plan_options & PLAN_HISTOGRAM)
+		fprintf(out, "Latency histograms, %s\n",
+			(planp->histogram_filename)?planp->histogram_filename:"percentiles only");
+	if (planp->plan_options & PLAN_TIMESERIES)
+		fprintf(out, "Interval statistics, every %.3f seconds, %s, %s\n",
+			(double)planp->timeseries_interval / FLOAT_BILLION, planp->timeseries_filename,
+			(planp->plan_options & PLAN_TIMESERIES_BINARY)?"binary":"csv");
+	if (planp->plan_options & PLAN_SHMSTATS) {
+		if (planp->shmstats_name)
+			fprintf(out, "Live statistics, shared memory segment %s%s\n",
+				(planp->shmstats_name[0] == '/')?"":"/", planp->shmstats_name);
+		else fprintf(out, "Live statistics, shared memory segment /xdd.%d\n", (int)getpid());
+	}
+	if (planp->plan_options & PLAN_METRICS)
+		fprintf(out, "Prometheus metrics, %s\n", planp->metrics_address);
+	if (planp->plan_options & PLAN_DISPATCH_STATS)
+		fprintf(out, "Dispatch latency histograms, enabled\n");
+	if (planp->plan_options & PLAN_STATE_TIMES)
+		fprintf(out, "Worker Thread state times, enabled\n");
+	if (planp->json_filename)
+		fprintf(out, "JSON results file name, %s\n", planp->json_filename);
 
 	fprintf(out, "Output file name, %s\n",xgp->output_filename);
 	fprintf(out, "CSV output file name, %s\n",xgp->csvoutput_filename);
@@ -273,6 +300,32 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 		xdd_display_kmgt(out, tdp->td_seekhdr.seek_range*tdp->td_block_size, tdp->td_block_size);
 	}
 	fprintf(out, "\t\tSeek pattern, %s\n", tdp->td_seekhdr.seek_pattern);
+	if (tdp->td_seekhdr.seek_num_size_classes > 0) {
+		fprintf(out, "\t\tRequest size distribution");
+		for (i = 0; i < (size_t)tdp->td_seekhdr.seek_num_size_classes; i++)
+			fprintf(out, ", %llu:%d", (unsigned long long)tdp->td_seekhdr.seek_size_classes[i].size_bytes, tdp->td_seekhdr.seek_size_classes[i].weight);
+		fprintf(out, ", bytes:weight\n");
+	}
+	if (tdp->td_seekhdr.seek_options & SO_SEEK_STREAMS) {
+		fprintf(out, "\t\tSequential streams, %d, policy, %s\n", tdp->td_seekhdr.seek_num_streams,
+			(tdp->td_seekhdr.seek_stream_policy == SO_STREAM_POLICY_RANDOM)?"random":
+			(tdp->td_seekhdr.seek_stream_policy == SO_STREAM_POLICY_WEIGHTED)?"weighted":"roundrobin");
+		for (i = 0; i < (size_t)tdp->td_seekhdr.seek_num_streams; i++)
+			fprintf(out, "\t\t\tStream %d, start block, %llu, stride, %lld, direction, %s, weight, %d\n", (int)i,
+				(unsigned long long)tdp->td_seekhdr.seek_streams[i].start,
+				(long long)tdp->td_seekhdr.seek_streams[i].stride,
+				(tdp->td_seekhdr.seek_streams[i].direction > 0)?"forward":"reverse",
+				tdp->td_seekhdr.seek_streams[i].weight);
+	}
+	if (tdp->td_seekhdr.seek_options & SO_SEEK_EXTENTS) {
+		fprintf(out, "\t\tExtent order, %s, physical region, %llu, to, %llu, bytes\n",
+			(tdp->td_seekhdr.seek_extent_order == SO_EXTENT_ORDER_LOGICAL)?"logical":"physical",
+			(unsigned long long)tdp->td_seekhdr.seek_extent_region_start,
+			(unsigned long long)tdp->td_seekhdr.seek_extent_region_end);
+		if (tdp->td_seekhdr.seek_num_extents > 0)
+			fprintf(out, "\t\tExtents in use, %d, physical discontiguities, %d\n",
+				tdp->td_seekhdr.seek_num_extents, tdp->td_seekhdr.seek_extent_discontiguities);
+	}
 	if (tdp->td_seekhdr.seek_stride > tdp->td_reqsize) 
 		fprintf(out, "\t\tSeek Stride, %d, %d-byte blocks, %d, bytes\n",tdp->td_seekhdr.seek_stride,tdp->td_block_size,tdp->td_seekhdr.seek_stride*tdp->td_block_size);
 	fprintf(out, "\t\tFlushwrite interval, %lld\n", (long long)tdp->td_flushwrite);
@@ -282,9 +335,14 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 	if (tdp->td_dpp) {
 		dpp = tdp->td_dpp;
 		fprintf(out,"\t\tData pattern in buffer");
-                if (dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN | DP_SEQUENCED_PATTERN | DP_INVERSE_PATTERN | DP_ASCII_PATTERN | DP_HEX_PATTERN | DP_PATTERN_PREFIX)) {
+                if (dpp->data_pattern_options & (DP_RANDOM_PATTERN | DP_RANDOM_BY_TARGET_PATTERN | DP_RANDOM_BY_OFFSET_PATTERN | DP_SEQUENCED_PATTERN | DP_INVERSE_PATTERN | DP_ASCII_PATTERN | DP_HEX_PATTERN | DP_PATTERN_PREFIX)) {
 			if (dpp->data_pattern_options & DP_RANDOM_PATTERN) fprintf(out,",random ");
                         if (dpp->data_pattern_options & DP_RANDOM_BY_TARGET_PATTERN) fprintf(out,",random by target number ");
+			if (dpp->data_pattern_options & DP_RANDOM_BY_OFFSET_PATTERN) {
+				fprintf(out,",random by byte offset, seed %llu", (unsigned long long)dpp->data_pattern_seed);
+				if (dpp->data_pattern_compress_ratio > 1.0) fprintf(out,", compression ratio %.2f:1", dpp->data_pattern_compress_ratio);
+				if (dpp->data_pattern_dedupe_ratio > 0.0) fprintf(out,", %.1f%% duplicate chunks", dpp->data_pattern_dedupe_ratio * 100.0);
+			}
 			if (dpp->data_pattern_options & DP_SEQUENCED_PATTERN) fprintf(out,",sequenced ");
 			if (dpp->data_pattern_options & DP_INVERSE_PATTERN) fprintf(out,",inversed ");
 			if (dpp->data_pattern_options & DP_ASCII_PATTERN) fprintf(out,",ASCII: '%s' <%d bytes> %s ",
@@ -293,18 +351,19 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 				fprintf(out,",HEX: 0x");
 				for (i=0; i<dpp->data_pattern_length; i++) 
 					fprintf(out,"%02x",dpp->data_pattern[i]);
-				fprintf(out, " <%d bytes>, %s\n",
+				fprintf(out, " <%d bytes>, %s",
 					(int)dpp->data_pattern_length, (dpp->data_pattern_options & DP_REPLICATE_PATTERN)?"Replicated":"Not Replicated");
 			}
 			if (dpp->data_pattern_options & DP_PATTERN_PREFIX)  {
 				fprintf(out,",PREFIX: 0x");
 				for (i=0; i<dpp->data_pattern_prefix_length; i+=2) 
 					fprintf(out,"%02x",dpp->data_pattern_prefix[i]);
-				fprintf(out, " <%d nibbles>\n", (int)dpp->data_pattern_prefix_length);
+				fprintf(out, " <%d nibbles>", (int)dpp->data_pattern_prefix_length);
 			}
 		} else { // Just display the one-byte hex pattern 
-			fprintf(out,",0x%02x\n",dpp->data_pattern[0]);
+			fprintf(out,",0x%02x",dpp->data_pattern[0]);
 		}
+		fprintf(out,"\n");
 		if (dpp->data_pattern_options & DP_FILE_PATTERN) 
 			fprintf(out," From file: %s\n",dpp->data_pattern_filename);
 	}
@@ -312,21 +371,45 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 	if ((tdp->td_target_options & (TO_VERIFY_LOCATION | TO_VERIFY_CONTENTS)))
 		fprintf(out," enabled for %s verification.\n", (tdp->td_target_options & TO_VERIFY_LOCATION)?"Location":"Content");
 	else fprintf(out," disabled.\n");
+	if ((tdp->td_target_options & TO_VERIFY_CHECKSUM) && tdp->td_csp) 
+		fprintf(out,"\t\tBlock checksum verification, %s, table file, %s\n", 
+			xdd_checksum_name(tdp->td_csp->cs_algorithm), 
+			(tdp->td_csp->cs_filename)?tdp->td_csp->cs_filename:"none");
+	if (tdp->td_vpp && (tdp->td_vpp->vp_threads > 0)) 
+		fprintf(out,"\t\tVerifier threads, %d, spare buffers, %d\n", 
+			tdp->td_vpp->vp_threads, 
+			(tdp->td_vpp->vp_buffers > 0)?tdp->td_vpp->vp_buffers:(tdp->td_vpp->vp_threads * XDD_VERIFY_POOL_BUFFERS_PER_THREAD));
+	if (tdp->td_cop && (tdp->td_cop->co_op == SO_OP_READ_MODIFY_WRITE)) 
+		fprintf(out,"\t\tCompound writes, read-modify-write, the data read is not carried into the write\n");
+	if (tdp->td_cop && (tdp->td_cop->co_op == SO_OP_WRITE_VERIFY)) 
+		fprintf(out,"\t\tCompound writes, write-verify, readback delay, %lld, ops\n", (long long int)tdp->td_cop->co_readback_delay);
+	if (tdp->td_mfp) 
+		fprintf(out,"\t\tManifest, %s, %s\n", (tdp->td_mfp->mf_mode == XDD_MANIFEST_WRITE) ? "write" : "verify", tdp->td_mfp->mf_filename);
+	if (tdp->td_pfp && (tdp->td_pfp->pf_buffers > 0)) 
+		fprintf(out,"\t\tPrefill buffers, %d\n", tdp->td_pfp->pf_buffers);
 	fprintf(out,"\t\tDirect I/O, %s", (tdp->td_target_options & TO_DIO)?"enabled\n":"disabled\n");
+	if (tdp->td_target_options & TO_SPARSE)
+		fprintf(out,"\t\tSparse file holes, skipped\n");
 	fprintf(out, "\t\tPreallocation, %lld\n",(long long int)tdp->td_preallocate);
 	fprintf(out, "\t\tPretruncation, %lld\n",(long long int)tdp->td_pretruncate);
 	fprintf(out, "\t\tQueue Depth, %d\n",tdp->td_queue_depth);
 	/* Timestamp options */
 	if (tdp->td_ts_table.ts_options & TS_ON) {
-                fprintf(out, "\t\tTimestamping, enabled with options, %s %s %s %s %s %s\n",
+                fprintf(out, "\t\tTimestamping, enabled with options, %s %s %s %s %s %s %s %s\n",
                    ( tdp->td_ts_table.ts_options & TS_DETAILED   )?"DETAILED":"", 
                    ( tdp->td_ts_table.ts_options & TS_SUMMARY    )?"SUMMARY":"",
                    ( tdp->td_ts_table.ts_options & TS_NORMALIZE  )?"NORMALIZE":"",
                    ( tdp->td_ts_table.ts_options & TS_APPEND     )?"APPEND":"",
                    ( tdp->td_ts_table.ts_options & TS_WRAP       )?"WRAP":"",
-                   ( tdp->td_ts_table.ts_options & TS_ONESHOT    )?"ONESHOT":"");
+                   ( tdp->td_ts_table.ts_options & TS_ONESHOT    )?"ONESHOT":"",
+                   ( tdp->td_ts_table.ts_options & TS_STREAM     )?"STREAM":"",
+                   ( tdp->td_ts_table.ts_options & TS_COMPACT    )?"COMPACT":"");
                 if ( tdp->td_ts_table.ts_options & TS_TRIGTIME   ) fprintf(out,"TRIGTIME %llu",tdp->td_ts_table.ts_trigtime);
                 if ( tdp->td_ts_table.ts_options & TS_TRIGOP     ) fprintf(out,":TRIGOP %"PRId64,tdp->td_ts_table.ts_trigop);
+		if ( tdp->td_ts_table.ts_sample_mode == XDD_TS_SAMPLE_EVERY ) fprintf(out, "\t\tTimestamp sampling, every %lld ops\n",(long long int)tdp->td_ts_table.ts_sample_every);
+		if ( tdp->td_ts_table.ts_sample_mode == XDD_TS_SAMPLE_RANDOM ) fprintf(out, "\t\tTimestamp sampling, random %.3f percent of the ops\n",tdp->td_ts_table.ts_sample_percent);
+		if ( tdp->td_ts_table.ts_sample_mode == XDD_TS_SAMPLE_WINDOW ) fprintf(out, "\t\tTimestamp sampling, %.3f seconds out of every %.3f seconds\n",
+			(double)tdp->td_ts_table.ts_sample_window / BILLION, (double)tdp->td_ts_table.ts_sample_period / BILLION);
 		if ( tdp->td_ts_table.ts_output_filename != NULL ) fprintf(out, "\t\tTimestamp ASCII output file name, %s\n",tdp->td_ts_table.ts_output_filename);
 		if ( tdp->td_ts_table.ts_options & TS_DUMP       ) fprintf(out, "\t\tTimestamp binary output file name, %s\n",tdp->td_ts_table.ts_binary_filename);
 	} else                                       fprintf(out, "\t\tTimestamping, disabled\n");
@@ -400,6 +483,8 @@ xdd_target_info(FILE *out, target_data_t *tdp) {
 		// Display info
 		fprintf(out,"\t\tEnd-to-End ACTIVE: this target is the %s side\n",
 			(tdp->td_target_options & TO_E2E_DESTINATION) ? "DESTINATION":"SOURCE");
+		if (tdp->td_target_options & TO_E2E_CHECKSUM)
+			fprintf(out,"\t\tEnd-to-End data checksums: CRC32C, damaged data is sent again\n");
 		// Display all the hostname:base_port,port_count entries in the e2e_address_table
 		for (i = 0; i < (size_t)tdp->td_e2ep->e2e_address_table_host_count; i++) {
 			fprintf(out,"\t\tEnd-to-End Destination Address %ld of %d '%s' base port %d for %d ports [ports %d - %d]\n",
@@ -38,9 +38,8 @@ xdd_initialization(int32_t argc,char *argv[], xdd_plan_t *planp) {
 	xgp->argv = argv; // remember the original argv 
 	xdd_parse(planp,argc,argv);
 
-	// Init output format header
-	if (planp->plan_options & PLAN_ENDTOEND) 
-		xdd_results_format_id_add("+E2ESRTIME+E2EIOTIME+E2EPERCENTSRTIME ", planp->format_string);
+	// The percentile format identifiers need the latency histograms
+	xdd_histogram_format_check(planp);
 
 	// Optimize runtime priorities and all that 
 	// See schedule.c
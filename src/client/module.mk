@@ -12,6 +12,7 @@ CLIENT_SRC := $(DIR)/info_display.c \
 	$(DIR)/parse_func.c \
 	$(DIR)/parse_table.c \
 	$(DIR)/results_display.c \
+	$(DIR)/results_json.c \
 	$(DIR)/results_manager.c \
 	$(DIR)/signals.c \
 	$(DIR)/utils.c
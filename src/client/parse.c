@@ -482,6 +482,103 @@ xdd_get_esp(target_data_t *tdp) {
 	return(tdp->td_esp);
 } /* End of xdd_get_esp() */
 
+/*----------------------------------------------------------------------------*/
+/* xdd_get_csp() - return a pointer to the Checksum Table Structure 
+ * for the specified target
+ */
+xint_checksum_t *
+xdd_get_csp(target_data_t *tdp) {
+	
+	if (tdp->td_csp == 0) { // Since there is no existing Checksum structure, allocate a new one for this target, initialize it, and move on...
+		tdp->td_csp = malloc(sizeof(xint_checksum_t));
+		if (tdp->td_csp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for CHECKSUM structure for target %d\n",
+			xgp->progname, (int)sizeof(xint_checksum_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_csp, 0, sizeof(*tdp->td_csp));
+		tdp->td_csp->cs_algorithm = XDD_CHECKSUM_CRC32C;
+	}
+	return(tdp->td_csp);
+} /* End of xdd_get_csp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_mfp() - return a pointer to the Write Manifest Structure 
+ * for the specified target
+ */
+xint_manifest_t *
+xdd_get_mfp(target_data_t *tdp) {
+	
+	if (tdp->td_mfp == 0) { // Since there is no existing Manifest structure, allocate a new one for this target, initialize it, and move on...
+		tdp->td_mfp = malloc(sizeof(xint_manifest_t));
+		if (tdp->td_mfp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for MANIFEST structure for target %d\n",
+			xgp->progname, (int)sizeof(xint_manifest_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_mfp, 0, sizeof(*tdp->td_mfp));
+		tdp->td_mfp->mf_fd = -1;
+	}
+	return(tdp->td_mfp);
+} /* End of xdd_get_mfp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_cop() - return a pointer to the Compound Op Structure 
+ * for the specified target
+ */
+xint_compound_t *
+xdd_get_cop(target_data_t *tdp) {
+	
+	if (tdp->td_cop == 0) { // Since there is no existing Compound structure, allocate a new one for this target, initialize it, and move on...
+		tdp->td_cop = malloc(sizeof(xint_compound_t));
+		if (tdp->td_cop == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for COMPOUND structure for target %d\n",
+			xgp->progname, (int)sizeof(xint_compound_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_cop, 0, sizeof(*tdp->td_cop));
+	}
+	return(tdp->td_cop);
+} /* End of xdd_get_cop() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_vpp() - return a pointer to the Verifier Thread Pool Structure 
+ * for the specified target
+ */
+xint_verify_pool_t *
+xdd_get_vpp(target_data_t *tdp) {
+	
+	if (tdp->td_vpp == 0) { // Since there is no existing Verify Pool structure, allocate a new one for this target, initialize it, and move on...
+		tdp->td_vpp = malloc(sizeof(xint_verify_pool_t));
+		if (tdp->td_vpp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for VERIFY POOL structure for target %d\n",
+			xgp->progname, (int)sizeof(xint_verify_pool_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_vpp, 0, sizeof(*tdp->td_vpp));
+	}
+	return(tdp->td_vpp);
+} /* End of xdd_get_vpp() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_pfp() - return a pointer to the Prefill Ring Structure 
+ * for the specified target
+ */
+xint_prefill_t *
+xdd_get_pfp(target_data_t *tdp) {
+	
+	if (tdp->td_pfp == 0) { // Since there is no existing Prefill structure, allocate a new one for this target, initialize it, and move on...
+		tdp->td_pfp = malloc(sizeof(xint_prefill_t));
+		if (tdp->td_pfp == NULL) {
+			fprintf(xgp->errout,"%s: ERROR: Cannot allocate %d bytes of memory for PREFILL structure for target %d\n",
+			xgp->progname, (int)sizeof(xint_prefill_t), tdp->td_target_number);
+			return(NULL);
+		}
+		memset(tdp->td_pfp, 0, sizeof(*tdp->td_pfp));
+	}
+	return(tdp->td_pfp);
+} /* End of xdd_get_pfp() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_get_throtp() - return a pointer to the XDD Throttle Data Structure 
  */
@@ -68,6 +68,124 @@ xdd_parse_arg_count_check(int32_t args, int32_t argc, char *option) {
 
 } // End of xdd_parse_arg_count_check()
 /*----------------------------------------------------------------------------*/
+// xdd_parse_size_distribution() - Parse a request size distribution of the 
+// form "size:weight,size:weight,..." such as "4K:60,64K:30,1M:10" into the
+// size classes of the specified seek header. Sizes are in bytes and may have
+// a K, M, or G suffix. Weights are relative and need not add up to 100.
+// Return value is 0 if the distribution is good, -1 otherwise.
+//
+int32_t
+xdd_parse_size_distribution(seekhdr_t *sp, char *spec) {
+	char		*cp;		// Current position in the spec
+	char		*endp;		// End of the number that was just converted
+	uint64_t	size;		// Size of the current class in bytes
+	long		weight;		// Weight of the current class
+	int32_t		n;			// Number of classes parsed so far
+
+
+	n = 0;
+	cp = spec;
+	while (*cp) {
+		if (n == SO_SEEK_MAX_SIZE_CLASSES) {
+			fprintf(xgp->errout,"%s: ERROR: Too many request sizes in '%s' - the maximum is %d\n",xgp->progname, spec, SO_SEEK_MAX_SIZE_CLASSES);
+			return(-1);
+		}
+		size = strtoull(cp, &endp, 10);
+		if (endp == cp) 
+			break;
+		switch (*endp) {
+			case 'k': case 'K': size *= 1024; endp++; break;
+			case 'm': case 'M': size *= 1024*1024; endp++; break;
+			case 'g': case 'G': size *= 1024*1024*1024; endp++; break;
+			default: break;
+		}
+		if (*endp != ':') 
+			break;
+		cp = endp + 1;
+		weight = strtol(cp, &endp, 10);
+		if ((endp == cp) || (weight <= 0) || (size == 0)) 
+			break;
+		sp->seek_size_classes[n].size_bytes = size;
+		sp->seek_size_classes[n].weight = weight;
+		n++;
+		cp = endp;
+		if (*cp == ',') 
+			cp++;
+		else if (*cp != '\0')
+			break;
+	}
+	if ((*cp != '\0') || (n == 0)) {
+		fprintf(xgp->errout,"%s: ERROR: Invalid request size distribution '%s' - expected size:weight,size:weight,...\n",xgp->progname, spec);
+		return(-1);
+	}
+	sp->seek_num_size_classes = n;
+	sp->seek_options |= SO_SEEK_VARSIZE;
+	return(0);
+
+} // End of xdd_parse_size_distribution()
+/*----------------------------------------------------------------------------*/
+// xdd_parse_seek_streams() - Parse a list of sequential streams of the form
+// "start:stride:direction[:weight],..." such as "0:0:f,1048576:16:r:3" into the
+// streams of the specified seek header. The start and stride are in blocks and
+// a stride of 0 means the request size. The direction is 'f' for ascending or
+// 'r' for descending locations. The weight defaults to 1.
+// Return value is 0 if the list is good, -1 otherwise.
+//
+int32_t
+xdd_parse_seek_streams(seekhdr_t *sp, char *spec) {
+	char		*cp;		// Current position in the spec
+	char		*endp;		// End of the number that was just converted
+	seek_stream_t	*stp;	// Stream being parsed
+	int32_t		n;			// Number of streams parsed so far
+
+
+	n = 0;
+	cp = spec;
+	while (*cp) {
+		if (n == SO_SEEK_MAX_STREAMS) {
+			fprintf(xgp->errout,"%s: ERROR: Too many streams in '%s' - the maximum is %d\n",xgp->progname, spec, SO_SEEK_MAX_STREAMS);
+			return(-1);
+		}
+		stp = &sp->seek_streams[n];
+		stp->start = strtoull(cp, &endp, 10);
+		if ((endp == cp) || (*endp != ':')) 
+			break;
+		cp = endp + 1;
+		stp->stride = strtoll(cp, &endp, 10);
+		if ((endp == cp) || (*endp != ':') || (stp->stride < 0)) 
+			break;
+		cp = endp + 1;
+		if ((*cp == 'f') || (*cp == 'F')) 
+			stp->direction = 1;
+		else if ((*cp == 'r') || (*cp == 'R')) 
+			stp->direction = -1;
+		else break;
+		cp++;
+		stp->weight = 1;
+		if (*cp == ':') {
+			cp++;
+			stp->weight = strtol(cp, &endp, 10);
+			if ((endp == cp) || (stp->weight <= 0)) 
+				break;
+			cp = endp;
+		}
+		n++;
+		if (*cp == ',') 
+			cp++;
+		else if (*cp != '\0')
+			break;
+	}
+	if ((*cp != '\0') || (n == 0)) {
+		fprintf(xgp->errout,"%s: ERROR: Invalid stream list '%s' - expected start:stride:f|r[:weight],...\n",xgp->progname, spec);
+		return(-1);
+	}
+	sp->seek_num_streams = n;
+	sp->seek_options |= SO_SEEK_STREAMS;
+	sp->seek_pattern = "streams";
+	return(0);
+
+} // End of xdd_parse_seek_streams()
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_blocksize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -159,6 +277,94 @@ xddfunc_bytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 } // End of xddfunc_bytes()
 /*----------------------------------------------------------------------------*/
+// Set the algorithm or the table file of the per-block checksums used by
+// -verify checksum. This option also turns -verify checksum on.
+// When the table file is set for all targets and there is more than one
+// target the target number is appended to the file name.
+// Arguments: -checksum [target #] crc32c|xxh64|file <filename>
+int
+xddfunc_checksum(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, args_index, i; 
+    int target_number;
+    int32_t algorithm;
+    char *filename;
+    target_data_t *tdp;
+    xint_checksum_t *csp;
+
+
+    args_index = 1;
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+    args_index += args;
+
+    if (args_index >= argc) {
+		fprintf(xgp->errout,"%s: ERROR: No checksum suboption specified for option %s\n", xgp->progname, argv[0]);
+		return(0);
+    }
+    algorithm = -1;
+    filename = NULL;
+    if (strcmp(argv[args_index], "crc32c") == 0) 
+		algorithm = XDD_CHECKSUM_CRC32C;
+    else if (strcmp(argv[args_index], "xxh64") == 0)
+		algorithm = XDD_CHECKSUM_XXH64;
+    else if (strcmp(argv[args_index], "file") == 0) {
+		if ((args_index + 1) >= argc) {
+			fprintf(xgp->errout,"%s: ERROR: No checksum table file name specified for option %s\n", xgp->progname, argv[0]);
+			return(0);
+		}
+		filename = argv[args_index+1];
+    } else {
+		fprintf(xgp->errout,"%s: ERROR: Invalid checksum suboption %s\n", xgp->progname, argv[args_index]);
+		return(0);
+    }
+
+    if (target_number >= 0) { /* Set this option for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		csp = xdd_get_csp(tdp);
+		if (csp == NULL) return(-1);
+		tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+		if (algorithm >= 0) 
+			csp->cs_algorithm = algorithm;
+		else {
+			free(csp->cs_filename);
+			csp->cs_filename = strdup(filename);
+			if (csp->cs_filename == NULL) {
+				fprintf(xgp->errout,"%s: ERROR: Cannot allocate memory for the checksum table file name of target %d\n", xgp->progname, target_number);
+				return(-1);
+			}
+		}
+    } else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				csp = xdd_get_csp(tdp);
+				if (csp == NULL) return(-1);
+				tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+				if (algorithm >= 0) 
+					csp->cs_algorithm = algorithm;
+				else {
+					// The name is always allocated so that xdd_checksum_free() can free it
+					free(csp->cs_filename);
+					csp->cs_filename = malloc(strlen(filename) + 16);
+					if (csp->cs_filename == NULL) {
+						fprintf(xgp->errout,"%s: ERROR: Cannot allocate memory for the checksum table file name of target %d\n", xgp->progname, i);
+						return(-1);
+					}
+					if (planp->number_of_targets > 1)
+						sprintf(csp->cs_filename, "%s.%d", filename, i);
+					else strcpy(csp->cs_filename, filename);
+				}
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+    }
+    return((algorithm >= 0) ? (args_index+1) : (args_index+2));
+} // End of xddfunc_checksum()
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_combinedout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -345,6 +551,8 @@ xddfunc_datapattern(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
 	unsigned char 		*pattern_value; // The ACSII representation of the specified data pattern
 	uint64_t      		pattern_binary = 0; // The 64-bit value shifted all the way to the left
 	size_t        		pattern_length; // The length of the pattern string from the command line
+	double				ratio;		// Compression or dedupe ratio
+	char				*endp;
 	unsigned char 		*tmpp;
 	int           		retval;
   
@@ -394,6 +602,68 @@ xddfunc_datapattern(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
 				}
 			}
 		}
+    } else if (strcmp(pattern_type, "randbyoffset") == 0) {  /* random data made from the seed, target number, and byte offset of each op */
+		pattern_binary = 0;
+		if ((argc > args+2) && isdigit((int)argv[args+2][0])) { /* Optional seed */
+			pattern_binary = strtoull(argv[args+2], NULL, 0);
+			retval++;
+		}
+		if (tdp) { /* set option for the specific target */
+			tdp->td_dpp->data_pattern_options |= DP_RANDOM_BY_OFFSET_PATTERN;
+			tdp->td_dpp->data_pattern_seed = pattern_binary;
+		} else { // Put this option into all Targets 
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) { 
+					tdp->td_dpp->data_pattern_options |= DP_RANDOM_BY_OFFSET_PATTERN;
+					tdp->td_dpp->data_pattern_seed = pattern_binary;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+    } else if ((strcmp(pattern_type, "compress") == 0) || (strcmp(pattern_type, "dedupe") == 0)) { 
+		/* random by offset data with a compression ratio like 2 or 2:1, or a percentage of duplicate chunks */
+		retval++;
+		if (argc <= args+2) {
+			fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-datapattern %s'\n",xgp->progname,pattern_type);
+			return(0);
+		}
+		ratio = strtod(argv[args+2], &endp);
+		if (pattern_type[0] == 'c') {
+			if ((*endp == ':') && (strtod(endp+1, NULL) > 0.0))
+				ratio /= strtod(endp+1, NULL);
+			if (ratio < 1.0) {
+				fprintf(xgp->errout,"%s: ERROR: the compression ratio '%s' must be 1 or more\n",xgp->progname,argv[args+2]);
+				return(0);
+			}
+		} else {
+			if ((ratio < 0.0) || (ratio > 100.0)) {
+				fprintf(xgp->errout,"%s: ERROR: the dedupe percentage '%s' must be 0 to 100\n",xgp->progname,argv[args+2]);
+				return(0);
+			}
+			ratio /= 100.0;
+		}
+		if (tdp) { /* set option for the specific target */
+			tdp->td_dpp->data_pattern_options |= DP_RANDOM_BY_OFFSET_PATTERN;
+			if (pattern_type[0] == 'c')
+				tdp->td_dpp->data_pattern_compress_ratio = ratio;
+			else tdp->td_dpp->data_pattern_dedupe_ratio = ratio;
+		} else { // Put this option into all Targets 
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) { 
+					tdp->td_dpp->data_pattern_options |= DP_RANDOM_BY_OFFSET_PATTERN;
+					if (pattern_type[0] == 'c')
+						tdp->td_dpp->data_pattern_compress_ratio = ratio;
+					else tdp->td_dpp->data_pattern_dedupe_ratio = ratio;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
 	} else if (strcmp(pattern_type, "ascii") == 0) {
 		retval++;
 		if (argc <= args+2) {
@@ -854,6 +1124,15 @@ xddfunc_dio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Keep histograms of the time ops take to be handed to a Worker Thread and issued
+// Arguments: -dispatchstats
+int
+xddfunc_dispatchstats(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	planp->plan_options |= (PLAN_DISPATCH_STATS | PLAN_HISTOGRAM);
+    return(1);
+}
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_dryrun(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -1294,6 +1573,26 @@ xddfunc_endtoend(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	    	}
 		}
 		return(args_index);
+    } else if ((strcmp(argv[args_index], "checksum") == 0) ||
+	       (strcmp(argv[args_index], "crc") == 0)) { 
+		// Put a CRC32C of the data in each message so that the destination can ask for damaged data again
+		args_index++;
+		if (target_number >= 0) {
+	    	tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+	    	if (tdp == NULL) return(-1);
+	    	tdp->td_target_options |= TO_E2E_CHECKSUM;
+		} else {  /* set option for all targets */
+	    	if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+		    	tdp->td_target_options |= TO_E2E_CHECKSUM;
+		    	i++;
+		    	tdp = planp->target_datap[i];
+			}
+	    	}
+		}
+		return(args_index);
     } else if ((strcmp(argv[args_index], "sourcepath") == 0) ||  /* complete source file path for restart option */
 	       (strcmp(argv[args_index], "srcpath") == 0)) { 
 		if (target_number >= 0) {
@@ -1627,6 +1926,19 @@ xddfunc_help(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     return(-1);
 }
 /*----------------------------------------------------------------------------*/
+// Keep latency histograms of the ops of each target
+// Arguments: -histogram [filename]
+int
+xddfunc_histogram(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	planp->plan_options |= PLAN_HISTOGRAM;
+	if ((argc > 1) && argv[1] && (argv[1][0] != '-')) {
+		planp->histogram_filename = argv[1];
+		return(2);
+	}
+	return(1);
+} // End of xddfunc_histogram()
+/*----------------------------------------------------------------------------*/
 // Specify an identification string for this run
 // Arguments: -id commandline|"string"
 int
@@ -1664,6 +1976,19 @@ xddfunc_interactive(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
     return(1);
 }
 /*----------------------------------------------------------------------------*/
+// Write the results as JSON lines to a file
+// Arguments: -json <filename>
+int
+xddfunc_json(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	if (argc < 2) {
+		fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-json'\n",xgp->progname);
+		return(0);
+	}
+	planp->json_filename = argv[1];
+	return(2);
+} // End of xddfunc_json()
+/*----------------------------------------------------------------------------*/
 // Specify the number of KBytes to transfer per pass (1K=1024 bytes)
 // Arguments: -kbytes [target #] #
 // This will set tdp->td_bytes to the calculated value (kbytes * 1024)
@@ -2003,6 +2328,80 @@ xddfunc_looseordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 	}
 } // End of  xddfunc_looseordering()
 /*----------------------------------------------------------------------------*/
+// Keep a manifest of the blocks written to a target or verify the target
+// against the manifest of earlier runs. The verify mode implies -verify checksum.
+// When the manifest is set for all targets and there is more than one
+// target the target number is appended to the file name.
+// Arguments: -manifest [target #] write|verify <filename>
+int
+xddfunc_manifest(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, args_index, i; 
+    int target_number;
+    int32_t mode;
+    char *filename;
+    target_data_t *tdp;
+    xint_manifest_t *mfp;
+
+
+    args_index = 1;
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+    args_index += args;
+
+    if ((args_index + 1) >= argc) {
+		fprintf(xgp->errout,"%s: ERROR: Option %s requires write|verify and a file name\n", xgp->progname, argv[0]);
+		return(0);
+    }
+    if (strcmp(argv[args_index], "write") == 0) 
+		mode = XDD_MANIFEST_WRITE;
+    else if (strcmp(argv[args_index], "verify") == 0)
+		mode = XDD_MANIFEST_VERIFY;
+    else {
+		fprintf(xgp->errout,"%s: ERROR: Invalid manifest suboption %s\n", xgp->progname, argv[args_index]);
+		return(0);
+    }
+    filename = argv[args_index+1];
+
+    if (target_number >= 0) { /* Set this option for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		mfp = xdd_get_mfp(tdp);
+		if (mfp == NULL) return(-1);
+		mfp->mf_mode = mode;
+		mfp->mf_filename = filename;
+		if (mode == XDD_MANIFEST_VERIFY) {
+			if (xdd_get_csp(tdp) == NULL) return(-1);
+			tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+		}
+    } else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				mfp = xdd_get_mfp(tdp);
+				if (mfp == NULL) return(-1);
+				mfp->mf_mode = mode;
+				if (planp->number_of_targets > 1) {
+					mfp->mf_filename = malloc(strlen(filename) + 16);
+					if (mfp->mf_filename == NULL) {
+						fprintf(xgp->errout,"%s: ERROR: Cannot allocate memory for the manifest file name of target %d\n", xgp->progname, i);
+						return(-1);
+					}
+					sprintf(mfp->mf_filename, "%s.%d", filename, i);
+				} else mfp->mf_filename = filename;
+				if (mode == XDD_MANIFEST_VERIFY) {
+					if (xdd_get_csp(tdp) == NULL) return(-1);
+					tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+				}
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+    }
+    return(args_index+2);
+} // End of xddfunc_manifest()
+/*----------------------------------------------------------------------------*/
 // Set the maxpri and process lock
 int
 xddfunc_maxall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
@@ -2151,6 +2550,20 @@ xddfunc_memalign(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	}
 } 
 /*----------------------------------------------------------------------------*/
+// Answer requests for live metrics in the Prometheus text format
+// Arguments: -metrics [address:]port|socket_path
+int
+xddfunc_metrics(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	if (argc < 2) {
+		fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-metrics'\n",xgp->progname);
+		return(0);
+	}
+	planp->metrics_address = argv[1];
+	planp->plan_options |= (PLAN_METRICS | PLAN_HISTOGRAM);
+	return(2);
+} // End of xddfunc_metrics()
+/*----------------------------------------------------------------------------*/
 // Set the  no mem lock and no proc lock flags 
 int
 xddfunc_minall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
@@ -2333,7 +2746,9 @@ xddfunc_operationdelay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t f
 }
 /*----------------------------------------------------------------------------*/
 // Specify the operation to perform - read or write 
-// Arguments: -op [target #] read|write
+// The writes can also be compound ops: rmw reads the blocks before writing
+// them and writeverify reads them back after -readbackdelay more ops
+// Arguments: -op [target #] read|write|noop|rmw|writeverify
 int
 xddfunc_operation(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -2342,6 +2757,7 @@ xddfunc_operation(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     target_data_t 	*tdp;
 	char	*opname;
 	double 	rwratio;
+	char	compound_op;
 
     args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
     if (args < 0) return(-1);
@@ -2351,14 +2767,21 @@ xddfunc_operation(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 
 	opname = (char *)argv[args+1];
 
+	compound_op = 0;
 	if (strcmp(opname, "write") == 0) {
 		rwratio = 0.0; /* all write operations */
 	} else if (strcmp(opname, "read") == 0) {
 		rwratio = 1.0; /* all read operations */
 	} else if ((strcmp(opname, "noop") == 0) || (strcmp(opname, "nop") == 0)) {
 		rwratio = -1.0; /* all NOOP operations */
+	} else if ((strcmp(opname, "rmw") == 0) || (strcmp(opname, "readmodifywrite") == 0)) {
+		rwratio = 0.0; /* all read-modify-write operations */
+		compound_op = SO_OP_READ_MODIFY_WRITE;
+	} else if ((strcmp(opname, "writeverify") == 0) || (strcmp(opname, "wv") == 0)) {
+		rwratio = 0.0; /* all write operations that are read back later */
+		compound_op = SO_OP_WRITE_VERIFY;
 	} else {
-		fprintf(xgp->errout,"%s: xddfunc_operation: ERROR: Operation '%s' is not valid. Acceptable operations are 'read', 'write', or 'noop'.\n",
+		fprintf(xgp->errout,"%s: xddfunc_operation: ERROR: Operation '%s' is not valid. Acceptable operations are 'read', 'write', 'noop', 'rmw', or 'writeverify'.\n",
 			xgp->progname,
 			opname);
 			return(0);
@@ -2368,6 +2791,11 @@ xddfunc_operation(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		if (tdp == NULL) return(-1);
 
 		tdp->td_rwratio = rwratio;
+		if (compound_op) {
+			if (xdd_get_cop(tdp) == NULL) return(-1);
+			tdp->td_cop->co_op = compound_op;
+		} else if (tdp->td_cop) 
+			tdp->td_cop->co_op = 0;
         return(args+2);
 	} else { // Put this option into all Targets 
 		if (flags & XDD_PARSE_PHASE2) {
@@ -2375,6 +2803,11 @@ xddfunc_operation(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			i = 0;
 			while (tdp) {
 				tdp->td_rwratio = rwratio;
+				if (compound_op) {
+					if (xdd_get_cop(tdp) == NULL) return(-1);
+					tdp->td_cop->co_op = compound_op;
+				} else if (tdp->td_cop) 
+					tdp->td_cop->co_op = 0;
 				i++;
 				tdp = planp->target_datap[i];
 			}
@@ -2540,7 +2973,7 @@ xddfunc_output_format(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 				fprintf(stderr,"%s: Error: No format string specified for '-outputformat add' option\n", xgp->progname);
 				return(-1);
 			}
-			xdd_results_format_id_add(argv[2], planp->format_string);
+			xdd_results_format_id_add(argv[2], &planp->format_string);
 			return(3);
 		}
 		if (strcmp(argv[1], "new") == 0) {
@@ -2672,6 +3105,53 @@ xddfunc_percentcpu(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
     }
 }
 /*----------------------------------------------------------------------------*/
+// Specify the number of write buffers that a prefill thread fills ahead of 
+// the Worker Threads for data patterns that change from op to op
+// Arguments: -prefill [target #] <#buffers>
+int
+xddfunc_prefill(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{ 
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	xint_prefill_t *pfp;
+	int32_t buffers;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	buffers = atoi(argv[args+1]);
+	if (buffers < 0) {
+		fprintf(xgp->errout,"%s: ERROR: The number of prefill buffers must be 0 or more for option %s\n", xgp->progname, argv[0]);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		pfp = xdd_get_pfp(tdp);
+		if (pfp == NULL) return(-1);
+		pfp->pf_buffers = buffers;
+        return(args+2);
+	} else { // Put this option into all Targets 
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				pfp = xdd_get_pfp(tdp);
+				if (pfp == NULL) return(-1);
+				pfp->pf_buffers = buffers;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+        return(2);
+	}
+} // End of xddfunc_prefill()
+/*----------------------------------------------------------------------------*/
 // Specify the number of bytes to preallocate for a target file that is 
 // being created. This option is only valid when used on operating systems
 // and file systems that support the Reserve Space file operation.
@@ -2969,6 +3449,50 @@ xddfunc_readafterwrite(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t f
 	}/* End of the -readafterwrite (raw) sub options */
 }
 /*----------------------------------------------------------------------------*/
+// Specify how many more ops a target does before the write of an
+// -op writeverify op is read back
+// Arguments: -readbackdelay [target #] <#ops>
+int
+xddfunc_readbackdelay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{ 
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	int64_t delay;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	delay = atoll(argv[args+1]);
+	if (delay < 0) {
+		fprintf(xgp->errout,"%s: ERROR: The readback delay must be 0 or more ops for option %s\n", xgp->progname, argv[0]);
+		return(0);
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		if (xdd_get_cop(tdp) == NULL) return(-1);
+		tdp->td_cop->co_readback_delay = delay;
+        return(args+2);
+	} else { // Put this option into all Targets 
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				if (xdd_get_cop(tdp) == NULL) return(-1);
+				tdp->td_cop->co_readback_delay = delay;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+        return(2);
+	}
+} // End of xddfunc_readbackdelay()
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_reallyverbose(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -3418,6 +3942,7 @@ int
 xddfunc_seek(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
     int     i;
+    int     policy;
     int     args, args_index; 
     int     target_number;
     target_data_t  *tdp;
@@ -3625,6 +4150,123 @@ xddfunc_seek(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			}
 		}  
 		return(args_index+2);
+	} else if (strcmp(argv[args_index], "sizedist") == 0) { /* variable request sizes from a size distribution */
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			if (xdd_parse_size_distribution(&tdp->td_seekhdr, argv[args_index+1]) < 0)
+				return(0);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					if (xdd_parse_size_distribution(&tdp->td_seekhdr, argv[args_index+1]) < 0)
+						return(0);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+2);
+	} else if (strcmp(argv[args_index], "streams") == 0) { /* interleave several sequential streams */
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			if (xdd_parse_seek_streams(&tdp->td_seekhdr, argv[args_index+1]) < 0)
+				return(0);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					if (xdd_parse_seek_streams(&tdp->td_seekhdr, argv[args_index+1]) < 0)
+						return(0);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+2);
+	} else if (strcmp(argv[args_index], "extents") == 0) { /* walk the extents of the file */
+		if (strcmp(argv[args_index+1], "physical") == 0) 
+			policy = SO_EXTENT_ORDER_PHYSICAL;
+		else if (strcmp(argv[args_index+1], "logical") == 0) 
+			policy = SO_EXTENT_ORDER_LOGICAL;
+		else {
+			fprintf(xgp->errout,"%s: Invalid extent order %s - must be physical or logical\n",xgp->progname, argv[args_index+1]);
+			return(0);
+		}
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_seekhdr.seek_options |= SO_SEEK_EXTENTS;
+			tdp->td_seekhdr.seek_extent_order = policy;
+			tdp->td_seekhdr.seek_pattern = "extents";
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_seekhdr.seek_options |= SO_SEEK_EXTENTS;
+					tdp->td_seekhdr.seek_extent_order = policy;
+					tdp->td_seekhdr.seek_pattern = "extents";
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+2);
+	} else if (strcmp(argv[args_index], "extentregion") == 0) { /* only use extents in this physical range */
+		if ((args_index+2 >= argc) || (atoll(argv[args_index+2]) != 0 && atoll(argv[args_index+2]) <= atoll(argv[args_index+1]))) {
+			fprintf(xgp->errout,"%s: -seek extentregion requires a start and an end physical address in bytes with end > start, or end 0\n",xgp->progname);
+			return(0);
+		}
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_seekhdr.seek_extent_region_start = atoll(argv[args_index+1]);
+			tdp->td_seekhdr.seek_extent_region_end = atoll(argv[args_index+2]);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_seekhdr.seek_extent_region_start = atoll(argv[args_index+1]);
+					tdp->td_seekhdr.seek_extent_region_end = atoll(argv[args_index+2]);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+3);
+	} else if (strcmp(argv[args_index], "streampolicy") == 0) { /* how to pick the stream for the next op */
+		if (strcmp(argv[args_index+1], "roundrobin") == 0) 
+			policy = SO_STREAM_POLICY_ROUND_ROBIN;
+		else if (strcmp(argv[args_index+1], "random") == 0) 
+			policy = SO_STREAM_POLICY_RANDOM;
+		else if (strcmp(argv[args_index+1], "weighted") == 0) 
+			policy = SO_STREAM_POLICY_WEIGHTED;
+		else {
+			fprintf(xgp->errout,"%s: Invalid stream policy %s - must be roundrobin, random, or weighted\n",xgp->progname, argv[args_index+1]);
+			return(0);
+		}
+		if (target_number >= 0) {  /* set option for specific target */
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_seekhdr.seek_stream_policy = policy;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_seekhdr.seek_stream_policy = policy;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		} 
+		return(args_index+2);
 	} else if (strcmp(argv[args_index], "seed") == 0) { /* set the seed for random seek locations */
 		if (target_number >= 0) {  /* set option for specific target */
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
@@ -3733,6 +4375,30 @@ xddfunc_sgio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     }
 }
 /*----------------------------------------------------------------------------*/
+// Arrange all the targets in a single shared file (N-to-1)
+// Arguments: -sharedfile strided|segmented|flush
+int
+xddfunc_sharedfile(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	if (argc < 2) {
+		fprintf(xgp->errout,"%s: ERROR: -sharedfile requires strided, segmented, or flush\n",xgp->progname);
+		return(0);
+	}
+	if (strcmp(argv[1], "strided") == 0) {
+		planp->plan_options &= ~PLAN_SHARED_FILE_SEGMENTED;
+		planp->plan_options |= PLAN_SHARED_FILE_STRIDED;
+	} else if (strcmp(argv[1], "segmented") == 0) {
+		planp->plan_options &= ~PLAN_SHARED_FILE_STRIDED;
+		planp->plan_options |= PLAN_SHARED_FILE_SEGMENTED;
+	} else if (strcmp(argv[1], "flush") == 0) {
+		planp->plan_options |= PLAN_SHARED_FILE_FLUSH;
+	} else {
+		fprintf(xgp->errout,"%s: ERROR: -sharedfile: unknown layout '%s' - use strided, segmented, or flush\n",xgp->progname,argv[1]);
+		return(0);
+	}
+    return(2);
+}
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_sharedmemory(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -3764,6 +4430,24 @@ xddfunc_sharedmemory(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fla
 		return(1);
 	}
 }
+/*----------------------------------------------------------------------------*/
+// Keep live statistics of the run in a shared memory segment
+// Arguments: -shmstats [name]
+int
+xddfunc_shmstats(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	planp->plan_options |= PLAN_SHMSTATS;
+	if ((argc > 1) && argv[1] && (argv[1][0] != '-')) {
+		if ((strlen(argv[1]) + 2) > XINT_SHMSTATS_NAME_LENGTH) {
+			fprintf(xgp->errout,"%s: ERROR: The -shmstats name can be at most %d characters long\n",
+				xgp->progname, XINT_SHMSTATS_NAME_LENGTH - 2);
+			return(-1);
+		}
+		planp->shmstats_name = argv[1];
+		return(2);
+	}
+	return(1);
+} // End of xddfunc_shmstats()
 /*----------------------------------------------------------------------------*/	
 // single processor scheduling
 int
@@ -3812,6 +4496,41 @@ xddfunc_singleproc(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Skip the holes of a sparse file when reading it and recreate them on the 
+// destination side of an E2E operation instead of moving zeros
+// Arguments: -sparse [target #]
+int
+xddfunc_sparse(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+    // At this point the "target_number" is valid
+	if (target_number >= 0) { /* Set this option for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+
+		tdp->td_target_options |= TO_SPARSE;
+        return(args+1);
+    } else { /* Set option for all targets */
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				tdp->td_target_options |= TO_SPARSE;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+        return(1);
+    }
+}
+/*----------------------------------------------------------------------------*/
 // The start delay function will set the "start delay" time for all
 // targets or for a specific target if specified.
 // For example, assuming four targets have been specified, the option
@@ -4039,6 +4758,15 @@ xddfunc_starttrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fla
 	}
 }
 /*----------------------------------------------------------------------------*/
+// Account for the time each Worker Thread spends in each state
+// Arguments: -statetimes
+int
+xddfunc_statetimes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	planp->plan_options |= PLAN_STATE_TIMES;
+    return(1);
+}
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_stoponerror(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -4550,6 +5278,33 @@ xddfunc_timerinfo(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     return(1);
 }
 /*----------------------------------------------------------------------------*/
+// Write interval statistics of each target to a file
+// Arguments: -timeseries <seconds> <filename> [binary]
+int
+xddfunc_timeseries(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{
+	double	seconds;
+
+
+	if (argc < 3) {
+		fprintf(xgp->errout,"%s: ERROR: not enough arguments specified for the option '-timeseries'\n",xgp->progname);
+		return(0);
+	}
+	seconds = atof(argv[1]);
+	if (seconds < 0.001) {
+		fprintf(xgp->errout,"%s: ERROR: The -timeseries interval must be at least 0.001 seconds\n",xgp->progname);
+		return(-1);
+	}
+	planp->timeseries_interval = (nclk_t)(seconds * BILLION);
+	planp->timeseries_filename = argv[2];
+	planp->plan_options |= (PLAN_TIMESERIES | PLAN_HISTOGRAM);
+	if ((argc > 3) && argv[3] && (strcmp(argv[3], "binary") == 0)) {
+		planp->plan_options |= PLAN_TIMESERIES_BINARY;
+		return(4);
+	}
+	return(3);
+} // End of xddfunc_timeseries()
+/*----------------------------------------------------------------------------*/
 int
 xddfunc_timeserver(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 {
@@ -4588,6 +5343,10 @@ xddfunc_timestamp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 	int i;
 	int args, args_index; 
 	int target_number;
+	int64_t ring_size;
+	int32_t sample_mode;
+	int64_t sample_every;
+	double sample_percent, sample_window, sample_period;
 	target_data_t *tdp;
 
 
@@ -4823,6 +5582,99 @@ xddfunc_timestamp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 		}
 		planp->ts_binary_filename_prefix = argv[args_index];
 		return(args_index+1);
+	} else if (strcmp(argv[args_index], "stream") == 0) { /* stream the entries to the dump file during the run */
+		ring_size = 0;
+		if ((args_index + 1 < argc) && argv[args_index+1] && isdigit((unsigned char)argv[args_index+1][0])) {
+			args_index++;
+			ring_size = atoll(argv[args_index]);
+		}
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_STREAM);
+			tdp->td_ts_table.ts_ring_size = ring_size;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_STREAM);
+					tdp->td_ts_table.ts_ring_size = ring_size;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(args_index+1);
+	} else if (strcmp(argv[args_index], "sample") == 0) { /* only time stamp some of the ops */
+		sample_every = 0;
+		sample_percent = sample_window = sample_period = 0.0;
+		if ((args_index + 2 < argc) && (strcmp(argv[args_index+1], "every") == 0)) {
+			sample_mode = XDD_TS_SAMPLE_EVERY;
+			sample_every = atoll(argv[args_index+2]);
+			args_index += 2;
+		} else if ((args_index + 2 < argc) && (strcmp(argv[args_index+1], "random") == 0)) {
+			sample_mode = XDD_TS_SAMPLE_RANDOM;
+			sample_percent = atof(argv[args_index+2]);
+			args_index += 2;
+		} else if ((args_index + 3 < argc) && (strcmp(argv[args_index+1], "window") == 0)) {
+			sample_mode = XDD_TS_SAMPLE_WINDOW;
+			sample_window = atof(argv[args_index+2]);
+			sample_period = atof(argv[args_index+3]);
+			args_index += 3;
+		} else {
+			fprintf(xgp->errout,"%s: ERROR: -ts sample needs 'every #ops', 'random percent', or 'window seconds period_seconds'\n",xgp->progname);
+			return(-1);
+		}
+		if (((sample_mode == XDD_TS_SAMPLE_EVERY) && (sample_every < 1)) ||
+			((sample_mode == XDD_TS_SAMPLE_RANDOM) && ((sample_percent <= 0.0) || (sample_percent > 100.0))) ||
+			((sample_mode == XDD_TS_SAMPLE_WINDOW) && ((sample_window <= 0.0) || (sample_period < sample_window)))) {
+			fprintf(xgp->errout,"%s: ERROR: Invalid value for -ts sample %s\n",xgp->progname, argv[args_index]);
+			return(-1);
+		}
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_ts_table.ts_options |= (TS_ON | TS_ALL);
+			tdp->td_ts_table.ts_sample_mode = sample_mode;
+			tdp->td_ts_table.ts_sample_every = sample_every;
+			tdp->td_ts_table.ts_sample_percent = sample_percent;
+			tdp->td_ts_table.ts_sample_window = (nclk_t)(sample_window * BILLION);
+			tdp->td_ts_table.ts_sample_period = (nclk_t)(sample_period * BILLION);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_ts_table.ts_options |= (TS_ON | TS_ALL);
+					tdp->td_ts_table.ts_sample_mode = sample_mode;
+					tdp->td_ts_table.ts_sample_every = sample_every;
+					tdp->td_ts_table.ts_sample_percent = sample_percent;
+					tdp->td_ts_table.ts_sample_window = (nclk_t)(sample_window * BILLION);
+					tdp->td_ts_table.ts_sample_period = (nclk_t)(sample_period * BILLION);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(args_index+1);
+	} else if (strcmp(argv[args_index], "compact") == 0) { /* write the dump file in the compact format */
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_COMPACT);
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					tdp->td_ts_table.ts_options |= ((TS_ON | TS_ALL) | TS_COMPACT);
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(args_index+1);
 	} else if (strcmp(argv[args_index], "summary") == 0) { /* set the time stamp SUMMARY reporting option */
 		if (target_number >= 0) {
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
@@ -4861,7 +5713,64 @@ xddfunc_timestamp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
     return(args_index+1);
 }
 /*----------------------------------------------------------------------------*/
- // -verify location | contents
+// Specify the number of verifier threads and spare buffers used to verify 
+// reads off the I/O path
+// Arguments: -verifythreads [target #] <#threads> [<#buffers>]
+int
+xddfunc_verifythreads(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
+{ 
+    int args, i; 
+    int target_number;
+    target_data_t *tdp;
+	xint_verify_pool_t *vpp;
+	int32_t threads;
+	int32_t buffers;
+
+    args = xdd_parse_target_number(planp, argc, &argv[0], flags, &target_number);
+    if (args < 0) return(-1);
+
+	if (xdd_parse_arg_count_check(args,argc, argv[0]) == 0)
+		return(0);
+
+	threads = atoi(argv[args+1]);
+	if (threads < 0) {
+		fprintf(xgp->errout,"%s: ERROR: The number of verifier threads must be 0 or more for option %s\n", xgp->progname, argv[0]);
+		return(0);
+	}
+	buffers = 0;
+	if ((argc > args+2) && isdigit((int)argv[args+2][0])) { /* Optional number of spare buffers */
+		buffers = atoi(argv[args+2]);
+		if ((buffers > 0) && (buffers < threads)) {
+			fprintf(xgp->errout,"%s: ERROR: There must be at least one spare buffer per verifier thread for option %s\n", xgp->progname, argv[0]);
+			return(0);
+		}
+	}
+
+	if (target_number >= 0) { /* Set this option value for a specific target */
+		tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+		if (tdp == NULL) return(-1);
+		vpp = xdd_get_vpp(tdp);
+		if (vpp == NULL) return(-1);
+		vpp->vp_threads = threads;
+		vpp->vp_buffers = buffers;
+	} else { // Put this option into all Targets 
+		if (flags & XDD_PARSE_PHASE2) {
+			tdp = planp->target_datap[0];
+			i = 0;
+			while (tdp) {
+				vpp = xdd_get_vpp(tdp);
+				if (vpp == NULL) return(-1);
+				vpp->vp_threads = threads;
+				vpp->vp_buffers = buffers;
+				i++;
+				tdp = planp->target_datap[i];
+			}
+		}
+	}
+	return((buffers > 0) ? (args+3) : (args+2));
+} // End of xddfunc_verifythreads()
+/*----------------------------------------------------------------------------*/
+ // -verify location | contents | checksum
 int
 xddfunc_verify(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags) 
 {
@@ -4902,6 +5811,25 @@ xddfunc_verify(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 			}
 		}
 		return(args_index+1);
+	} else if (strcmp(argv[args_index], "checksum") == 0) { /*  Checksum each block on write and verify it on read */
+		if (target_number >= 0) {
+			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
+			if (tdp == NULL) return(-1);
+			if (xdd_get_csp(tdp) == NULL) return(-1);
+			tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+		} else {  /* set option for all targets */
+			if (flags & XDD_PARSE_PHASE2) {
+				tdp = planp->target_datap[0];
+				i = 0;
+				while (tdp) {
+					if (xdd_get_csp(tdp) == NULL) return(-1);
+					tdp->td_target_options |= TO_VERIFY_CHECKSUM;
+					i++;
+					tdp = planp->target_datap[i];
+				}
+			}
+		}
+		return(args_index+1);
 	} else if (strcmp(argv[args_index], "location") == 0) { /*  Verify the buffer location */
 		if (target_number >= 0) {
 			tdp = xdd_get_target_datap(planp, target_number, argv[0]);
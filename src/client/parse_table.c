@@ -43,6 +43,15 @@ xdd_func_t  xdd_func[] = {
             {"    Specifies the number of bytes to transfer during a single pass\n", 
             0,0,0,0},
 			0},
+    {"checksum", "cksum",
+            xddfunc_checksum,
+            1,  
+            "  -checksum [target <target#>] crc32c|xxh64|file <filename>\n",  
+            {"    Selects the per-block checksum used by -verify checksum (default crc32c) or the checksum table file\n", 
+             "    The table file is loaded at the start of the run and saved at the end so that a later read-only\n",
+             "    run can verify blocks written by an earlier run. Implies -verify checksum\n",
+            0,0},
+			0},
     {"combinedout", "combo",
             xddfunc_combinedout,
             1,  
@@ -81,9 +90,13 @@ xdd_func_t  xdd_func[] = {
     {"datapattern", "dp",
             xddfunc_datapattern,    
             1,  
-            "  -datapattern [target <target#>] <c> | random | sequenced | prefix <hexdigits> | inverse | ascii <asciistring> | hex <hexdigits> | replicate | lfpat | ltpat | cjtpat | crpat | cspat\n",  
+            "  -datapattern [target <target#>] <c> | random | randbyoffset [seed] | compress <ratio> | dedupe <percent> | sequenced | prefix <hexdigits> | inverse | ascii <asciistring> | hex <hexdigits> | replicate | lfpat | ltpat | cjtpat | crpat | cspat\n",  
             {"    -datapattern 'c' will use the character c as the data pattern to write\n\
        If the word 'random' is specified for the pattern then a random pattern will be generated\n\
+       If the word 'randbyoffset' is specified then every op gets random data made from the seed, target number, and byte offset\n\
+       If the word 'compress' is specified then the randbyoffset data of every 4096-byte chunk compresses about <ratio>:1, i.e. 2 or 2:1\n\
+       If the word 'dedupe' is specified then about <percent> of the 4096-byte chunks of the randbyoffset data repeat an earlier chunk\n\
+       within the same 4 MiB of the target\n\
        If the word 'sequenced' is specified for the pattern then a sequenced number pattern will be generated\n\
        If the word 'prefix' is specified for the pattern then the specified hex digits will be placed in the upper N bits of the 64-bit pattern\n\
        If the word 'inverse' is specified for the pattern then the actual pattern will be the 1's compliment of the specified pattern\n\
@@ -122,6 +135,15 @@ xdd_func_t  xdd_func[] = {
             {"    Will use DIRECTIO on targets that are files\n", 
             0,0,0,0},
 			0},
+    {"dispatchstats", "dispatchstats",
+            xddfunc_dispatchstats, 
+            1,  
+            "  -dispatchstats\n",  
+            {"    Keeps histograms of the time each op takes from its task setup by the Target Thread to the\n\
+                 wakeup of the Worker Thread (handoff), from there to the issue of the op (preissue), and the\n\
+                 two together (dispatch), apart from the service time of the op. Implies -histogram.\n", 
+            0,0,0,0},
+			0},
     {"dryrun",  "dry",
             xddfunc_dryrun,        
             1,  
@@ -132,9 +154,10 @@ xdd_func_t  xdd_func[] = {
     {"endtoend", "e2e",
             xddfunc_endtoend,
             1,
-            "  -endtoend [target #]  issource | isdestination | destination <hostname[:baseport#[,portcount]]> | port <#> | portcount <#>\n",
+            "  -endtoend [target #]  issource | isdestination | destination <hostname[:baseport#[,portcount]]> | port <#> | portcount <#> | checksum\n",
             {"    Specifies a source and destination information for doing end-to-end test between two machines",
-            0,0,0,0},
+            "    'checksum' on the source puts a CRC32C of the data in each message - the destination asks again for data that does not match\n",
+            0,0,0},
 			0},
     {"errout", "eo",
             xddfunc_errout,     
@@ -195,6 +218,19 @@ xdd_func_t  xdd_func[] = {
             {"    Will print out extended help for a specific option \n", 
             0,0,0,0},
 			0},
+    {"histogram", "hist",
+            xddfunc_histogram,  
+            1,  
+            "  -histogram [filename]\n",  
+            {"    Keeps a latency histogram of the read, write, and all ops of each target and prints\n\
+                 the p50, p90, p99, p99.9, p99.99, and max op times of each target at the end of the run.\n\
+                 If a filename is given the buckets of the histograms of each target and of each of its\n\
+                 Worker Threads are written to it as CSV so that the histograms of several hosts can be\n\
+                 merged and the Worker Threads of a target compared.\n\
+                 The -outputformat identifiers +P50LATENCY, +P90LATENCY, +P99LATENCY, +P999LATENCY,\n\
+                 +P9999LATENCY, and +MAXLATENCY turn the histograms on as well.\n", 
+            0,0,0,0},
+			0},
     {"identifier",   "id",
             xddfunc_id, 
             1,  
@@ -209,6 +245,15 @@ xdd_func_t  xdd_func[] = {
             {"    Indicates that XDD should start up in Interactive Mode - targets will not start until the 'run' command is given.\n", 
             0,0,0,0},
             XDD_FUNC_INVISIBLE},
+    {"json", "json",
+            xddfunc_json, 
+            1,  
+            "  -json <filename>\n",  
+            {"    Writes the plan and the results of each target for each pass, the target averages, and the\n\
+                 combined results to <filename> as JSON lines, one object per line. Includes the Worker Thread\n\
+                 counters of each pass, -extendedstats, and the latency percentiles and buckets of -histogram.\n", 
+            0,0,0,0},
+			0},
     {"kbytes",  "kb",
             xddfunc_kbytes,     
             1,  
@@ -261,6 +306,16 @@ xdd_func_t  xdd_func[] = {
              "    see also: -serialordering or -noordering\n",
 			0,0,0},
 			0},
+    {"manifest", "manifest",
+            xddfunc_manifest,
+            1,  
+            "  -manifest [target <target#>] write|verify <filename>\n",  
+            {"    write appends the offset, run generation, pass, and block checksums of every write to the manifest\n", 
+             "    and syncs it at the end of each pass. verify checks every block read against the newest checksum\n",
+             "    of the block in the manifest, so a later run can validate data after a failover or power cycle.\n",
+             "    The verify mode implies -verify checksum\n",
+            0},
+			0},
     {"maxall", "maxall",
             xddfunc_maxall,     
             1,  
@@ -305,6 +360,15 @@ xdd_func_t  xdd_func[] = {
             {"    Align memory on an #-byte boundary - should be an even number\n", 
             0,0,0,0},
 			0},
+    {"metrics", "metrics",
+            xddfunc_metrics, 
+            1,  
+            "  -metrics [address:]port|socket_path\n",  
+            {"    Answers HTTP requests for the bytes, ops, op time histograms, and states of the targets and\n\
+                 Worker Threads in the Prometheus text format, on 127.0.0.1 or <address> at <port>, or on\n\
+                 the UNIX socket <socket_path> if it has a '/' in it. Turns on the latency histograms of -histogram.\n", 
+            0,0,0,0},
+			0},
     {"minall", "minall",
             xddfunc_minall,     
             1,  
@@ -366,10 +430,13 @@ xdd_func_t  xdd_func[] = {
     {"operation", "op",
             xddfunc_operation,  
             1,  
-            "  -operation [target <target#>] read|write|noop\n",   
+            "  -operation [target <target#>] read|write|noop|rmw|writeverify\n",   
             {"   The operation is either 'read', 'write', 'noop' -or- 'target # read', 'target # write', or 'target # noop'\n", 
              "   The 'target # <op>' will cause the specified target to perform the specified operations\n",
-             0,0,0},
+             "   'rmw' reads the blocks of each write before writing the data pattern over them. No data from the read\n\
+   is carried into the write. 'writeverify' reads the blocks of each write back after -readbackdelay\n",
+             "   more ops and reports writes that were lost. Both also apply to the writes of -rwratio\n",
+             0},
 			0},
     {"ordering", "or",
             xddfunc_ordering,  
@@ -434,6 +501,15 @@ xdd_func_t  xdd_func[] = {
             {"    Will preallocate # bytes before writing a file.\n", 
             0,0,0,0},
 			0},
+    {"prefill", "prefill",
+            xddfunc_prefill,
+            1,  
+            "  -prefill [target <target#>] <#buffers>\n",  
+            {"    A prefill thread fills a ring of <#buffers> write buffers ahead of the Worker Threads\n", 
+             "    for the sequenced and randbyoffset data patterns that change from op to op.\n",
+             "    The time Worker Threads wait for a prefilled buffer is reported\n",
+            0,0},
+			0},
     {"pretruncate", "pt",
             xddfunc_pretruncate,
             1,  
@@ -477,6 +553,13 @@ xdd_func_t  xdd_func[] = {
             {"    Specifies a reader and writer for doing read-after-writes to a single target", 
             0,0,0,0},
 			XDD_FUNC_INVISIBLE},
+    {"readbackdelay", "rbd",
+            xddfunc_readbackdelay,
+            1,  
+            "  -readbackdelay [target <target#>] <#ops>\n",  
+            {"    Number of ops the target does between a write of -op writeverify and its readback. Default is 0\n", 
+            0,0,0,0},
+			0},
     {"reallyverbose", "rv",
             xddfunc_reallyverbose, 
             1,  
@@ -560,7 +643,7 @@ xdd_func_t  xdd_func[] = {
     {"seek",  "s",
             xddfunc_seek,       
             1,  
-            "  -seek [target <target#>] save <filename> | load <filename> | disthist #buckets | seekhist #buckets | sequential | random | range #blocks | stagger #blocks | interleave #blocks | seed # | none\n",  
+            "  -seek [target <target#>] save <filename> | load <filename> | disthist #buckets | seekhist #buckets | sequential | random | range #blocks | stagger #blocks | interleave #blocks | seed # | sizedist size:weight,... | streams start:stride:f|r[:weight],... | streampolicy roundrobin|random|weighted | extents physical|logical | extentregion start end | none\n",  
             {"    -seek 'save <filename>' will save the seek list in the file specified\n\
     -seek 'load <filename>' will load the seek list from the file specified\n\
     -seek 'disthist #buckets' will display a 'seek distance' histogram using the specified number of 'buckets'\n\
@@ -572,7 +655,18 @@ xdd_func_t  xdd_func[] = {
     -seek 'interleave #' specifies the number of blocksized blocks to interleave into the access pattern\n\
     -seek 'seed #' specifies a seed to use when generating random numbers\n\
     -seek 'none' do not seek - retransfer the same block each time \n",
-                0,0,0},
+             "    -seek 'sizedist size:weight,...' picks the size of each request from a weighted list of sizes in bytes\n\
+        such as 4K:60,64K:30,1M:10 - results are also reported for each size. A seek list loaded with\n\
+        'load' whose request size column differs from -reqsize is treated the same way\n",
+             "    -seek 'streams start:stride:f|r[:weight],...' interleaves several sequential streams. Start and stride\n\
+        are in blocks from -startoffset, a stride of 0 is the request size, f walks forward and r walks backward\n\
+        from start. A stream that runs past the end of the seek range starts over at its start\n\
+    -seek 'streampolicy roundrobin|random|weighted' picks the stream for each op in turn, at random, or\n\
+        at random in proportion to the stream weights. The default is roundrobin\n\
+    -seek 'extents physical|logical' walks the extents of an existing file from the file system extent map\n\
+        in physical address or file offset order - results are also reported for each extent\n\
+    -seek 'extentregion start end' only uses the extents between two physical addresses in bytes, end 0 is no limit\n",
+                0},
 			0},
     {"serialordering", "so",
             xddfunc_serialordering,     
@@ -596,6 +690,16 @@ xdd_func_t  xdd_func[] = {
             {"    Will use SCSI Generic I/O <linux only> - only necessary if SG device is not /dev/sgX\n", 
             0,0,0,0},
 			0},
+    {"sharedfile","shf",
+            xddfunc_sharedfile,
+            1,  
+            "  -sharedfile strided|segmented|flush\n",   
+            {"    Lays all targets out in one shared file (N-to-1) - use '-targets -N file' to name the file N times\n", 
+             "    strided: the targets interleave their requests; segmented: each target owns a contiguous segment\n",
+             "    flush: all targets sync the file together at the end of each pass - time shows up as flush time\n",
+             "    Overrides -targetoffset. Without this option each target is its own file (N-to-N)\n",
+            0},
+			0},
     {"sharedmemory","shm",
             xddfunc_sharedmemory,
             1,  
@@ -603,6 +707,17 @@ xdd_func_t  xdd_func[] = {
             {"    Will use a shared memory segment instead of the normal malloc/valloc for the I/O buffer.\n", 
             0,0,0,0},
 			0},
+    {"shmstats", "shmstats",
+            xddfunc_shmstats, 
+            1,  
+            "  -shmstats [name]\n",  
+            {"    Keeps the counters and current state of each target and Worker Thread in the POSIX shared\n\
+                 memory segment <name>, /xdd.<pid> by default, every 0.1 seconds for other programs to\n\
+                 read while the run goes on. The layout of the segment is described in xint_shmstats.h.\n\
+                 The segment must not exist yet. It is removed at the end of the run, right after its\n\
+                 last update; readers that have it mapped still see the final values.\n", 
+            0,0,0,0},
+			0},
     {"singleproc",  "sp",
             xddfunc_singleproc, 
             1,  
@@ -611,6 +726,14 @@ xdd_func_t  xdd_func[] = {
              "    Requires the processor number to run on\n",
              0,0,0},
 			0},
+    {"sparse", "sparse",
+            xddfunc_sparse,      
+            1,  
+            "  -sparse [target <target#>]\n",  
+            {"    Reads skip the holes of a sparse file found with SEEK_DATA/SEEK_HOLE. On the destination of an\n", 
+             "    E2E operation the holes are punched or the file is extended rather than written with zeros\n",
+            0,0,0},
+			0},
     {"startdelay", "sd",
             xddfunc_startdelay, 
             1,  
@@ -640,6 +763,15 @@ xdd_func_t  xdd_func[] = {
             "  -starttrigger <target#> <target#> <<time|op|percent|mbytes|kbytes> #>\n",   
             {" ", 0,0,0,0},
             XDD_FUNC_INVISIBLE},
+    {"statetimes", "statetimes",
+            xddfunc_statetimes, 
+            1,  
+            "  -statetimes\n",  
+            {"    Accounts for the time each Worker Thread spends doing I/O, waiting on the ordering of the ops\n\
+                 or the TOT locks, in a barrier waiting for a task, or busy in xdd itself, and displays the share\n\
+                 of the time of the run spent in each state for each target. Included in the -json records.\n", 
+            0,0,0,0},
+			0},
     {"stoponerror", "soe",
             xddfunc_stoponerror,
             1,  
@@ -765,6 +897,15 @@ xdd_func_t  xdd_func[] = {
             {"    Will print out overhead information for various timer functions used\n", 
             0,0,0,0},
 			XDD_FUNC_INVISIBLE},
+    {"timeseries", "tseries",
+            xddfunc_timeseries, 
+            1,  
+            "  -timeseries <seconds> <filename> [binary]\n",  
+            {"    Writes the bytes, ops, MB/s, IOPS, and mean, p50, p90, p99, p99.9, and max op times of\n\
+                 each target every <seconds> seconds to <filename> as CSV, or as binary records with\n\
+                 'binary'. Turns on the latency histograms of -histogram.\n", 
+            0,0,0,0},
+			0},
     {"timeserver", "tsvr",
             xddfunc_timeserver, 
             1,  
@@ -777,7 +918,7 @@ xdd_func_t  xdd_func[] = {
     {"timestamps", "ts",
             xddfunc_timestamp,  
             1,  
-            "  -ts [target <target#>] summary|detailed|wrap|oneshot|size #|append|output <filename>|dump <filename>|triggertime <seconds>|triggerop <op#>\n",   
+            "  -ts [target <target#>] summary|detailed|wrap|oneshot|size #|append|output <filename>|dump <filename>|stream [#]|compact|sample every #|sample random %|sample window <seconds> <seconds>|triggertime <seconds>|triggerop <op#>\n",   
             {"    -ts  'summary' will turn on time stamping with summary reporting option\n\
     -ts  'detailed'  will turn on time stamping with detailed reporting option\n\
     -ts  'wrap'  will cause the timestamp buffer to wrap after N timestamp entries are used. Should be used in conjunction with -ts size.\n\
@@ -788,6 +929,14 @@ xdd_func_t  xdd_func[] = {
     -ts  'append'  will append output to existing output file.\n\
     -ts  'output filename' will print the output to file 'filename'. Default output is stdout\n\
     -ts  'dump filename'  will turn on time stamping and dump a binary time stamp file to 'filename'\n\
+    -ts  'stream [#]'  will write the time stamps to the dump file while the run goes on instead of keeping\n\
+         them all in memory. Each Worker Thread keeps up to # entries (default 4096) for the writer thread;\n\
+         entries that find them full are dropped and counted. Needs 'dump filename'.\n\
+    -ts  'compact'  will write the dump file in the compact format: the entries of each Worker Thread as\n\
+         varints of the differences between them, without the fields the run does not use\n\
+    -ts  'sample every #'  will only time stamp one op out of every # ops\n\
+    -ts  'sample random %'  will time stamp about % percent of the ops picked at random\n\
+    -ts  'sample window <seconds> <period>'  will time stamp the ops of the first <seconds> of every <period> seconds\n\
     Default is no time stamping.\n",
               0,0,0},
 			0},
@@ -808,11 +957,21 @@ xdd_func_t  xdd_func[] = {
     {"verify", "verify",
             xddfunc_verify,     
             1,  
-            "  -verify [target <target#>] location|contents\n",   
+            "  -verify [target <target#>] location|contents|checksum\n",   
             {"    -verify  'location'  will verify the block location is correct\n",
              "    -verify  'contents' will verify the contents of the data buffer read is the same as the specified data pattern\n",
-             0,0,0},
+             "    -verify  'checksum' will checksum every block written and verify the checksum of every block read - see -checksum\n",
+             0,0},
 			XDD_FUNC_INVISIBLE},
+    {"verifythreads", "vthreads",
+            xddfunc_verifythreads,     
+            1,  
+            "  -verifythreads [target <target#>] <#threads> [<#buffers>]\n",   
+            {"    Hands every buffer read to a pool of verifier threads so that -verify does not hold up the next read.\n",
+             "    The Worker Thread gets a spare buffer in trade and waits when all <#buffers> spare buffers are\n",
+             "    waiting to be verified. The default is 2 buffers per verifier thread\n",
+             0,0},
+			0},
     {"version", "ver",
             xddfunc_version,     
             1,  
@@ -224,6 +224,58 @@ xdd_results_fmt_latency(results_t *rp) {
 
 }
 /*----------------------------------------------------------------------------*/
+// The percentile latencies come from the histogram of all the read and write
+// ops and are -1 if there is no histogram
+static void 
+xdd_results_fmt_percentile_latency(results_t *rp, char *header, double percent) {
+	xint_histogram_t	*hp;
+
+
+	if (rp->flags & RESULTS_HEADER_TAG) {
+		fprintf(rp->output,"%9s",header);
+	} else if (rp->flags & RESULTS_UNITS_TAG) {
+		fprintf(rp->output,"%9s"," millisec");
+	} else if (rp->flags & RESULTS_PASS_INFO) {
+		if (rp->hgp == NULL) {
+			fprintf(rp->output,"%9.3f",-1.0);
+			return;
+		}
+		hp = &rp->hgp->hs_hist[XINT_HISTOGRAM_ALL];
+		fprintf(rp->output,"%9.3f",(double)xdd_histogram_percentile(hp, percent) / FLOAT_MILLION);
+	}
+
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p50_latency(results_t *rp) {
+	xdd_results_fmt_percentile_latency(rp, "  P50_Lat", 50.0);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p90_latency(results_t *rp) {
+	xdd_results_fmt_percentile_latency(rp, "  P90_Lat", 90.0);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p99_latency(results_t *rp) {
+	xdd_results_fmt_percentile_latency(rp, "  P99_Lat", 99.0);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p999_latency(results_t *rp) {
+	xdd_results_fmt_percentile_latency(rp, " P999_Lat", 99.9);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_p9999_latency(results_t *rp) {
+	xdd_results_fmt_percentile_latency(rp, "P9999_Lat", 99.99);
+}
+/*----------------------------------------------------------------------------*/
+void 
+xdd_results_fmt_max_latency(results_t *rp) {
+	xdd_results_fmt_percentile_latency(rp, "  Max_Lat", 100.0);
+}
+/*----------------------------------------------------------------------------*/
 void 
 xdd_results_fmt_elapsed_time_from_1st_op(results_t *rp) {
 	if (rp->flags & RESULTS_HEADER_TAG) {
@@ -267,7 +319,7 @@ xdd_results_fmt_elapsed_pattern_fill_time(results_t *rp) {
 	} else if (rp->flags & RESULTS_UNITS_TAG) {
 		fprintf(rp->output,"%9s"," millisec");
 	} else if (rp->flags & RESULTS_PASS_INFO) {
-		fprintf(rp->output,"%9.3f",-1.0);
+		fprintf(rp->output,"%9.3f",rp->accumulated_pattern_fill_time * 1000.0);
 	}
 
 }
@@ -547,6 +599,12 @@ static	xdd_results_fmt_t	xdd_results_fmt_table[] = {
 	{"+READIOPS", 			xdd_results_fmt_read_iops},
 	{"+WRITEIOPS", 			xdd_results_fmt_write_iops},
 	{"+LATENCY", 			xdd_results_fmt_latency},
+	{"+P50LATENCY", 		xdd_results_fmt_p50_latency},
+	{"+P90LATENCY", 		xdd_results_fmt_p90_latency},
+	{"+P99LATENCY", 		xdd_results_fmt_p99_latency},
+	{"+P999LATENCY", 		xdd_results_fmt_p999_latency},
+	{"+P9999LATENCY", 		xdd_results_fmt_p9999_latency},
+	{"+MAXLATENCY", 		xdd_results_fmt_max_latency},
 	{"+ELAPSEDTIME1STOP", 	xdd_results_fmt_elapsed_time_from_1st_op},
 	{"+ELAPSEDTIMEPASS", 	xdd_results_fmt_elapsed_time_from_pass_start},
 	{"+OVERHEADTIME", 		xdd_results_fmt_elapsed_over_head_time},
@@ -694,7 +752,7 @@ xdd_results_display(results_t *rp) {
 // This routine will add a string of format IDs or other text to the end
 // of the existing format ID string.
 void 
-xdd_results_format_id_add( char *sp , char *format_stringp) {
+xdd_results_format_id_add( char *sp , char **format_stringpp) {
 
 	char	*tmpp;
 	int		length_format_string;
@@ -702,7 +760,7 @@ xdd_results_format_id_add( char *sp , char *format_stringp) {
 	int		new_length;
 
 
-	length_format_string = strlen(format_stringp);
+	length_format_string = strlen(*format_stringpp);
 	length_added_string = strlen(sp);
 
 	new_length = length_format_string + length_added_string + 2;
@@ -712,10 +770,11 @@ xdd_results_format_id_add( char *sp , char *format_stringp) {
 			xgp->progname, 
 			new_length,
 			sp,
-			format_stringp);
+			*format_stringpp);
+		return;
 	}
-	sprintf(tmpp, "%s%s ",format_stringp, sp);
-	format_stringp = tmpp;
+	sprintf(tmpp, "%s%s ",*format_stringpp, sp);
+	*format_stringpp = tmpp;
 	
 	return;
 }
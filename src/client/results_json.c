@@ -0,0 +1,396 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines of -json which writes the results of a
+ * run as JSON lines: one JSON object per line, each with a "type" member.
+ *	"plan"				Once, before the first pass results - the run and its targets
+ *	"target_pass"		Each target at the end of each pass, with its Worker Threads
+ *	"target_average"	Each target at the end of the run
+ *	"combined"			Once, at the end of the run
+ * Times are in seconds and rates in MB/sec (10^6 bytes) and ops/sec, the same
+ * as the text results. Values that cannot be computed are null.
+ */
+#include "xint.h"
+
+#define XDD_JSON_VERSION	1	// Changes when members are renamed or change meaning
+
+/*----------------------------------------------------------------------------*/
+/* xdd_json_quote() - Write a string as a JSON string
+ */
+static void
+xdd_json_quote(FILE *fp, char *sp) {
+	unsigned char	*cp;
+
+
+	if (sp == NULL) {
+		fputs("null", fp);
+		return;
+	}
+	fputc('"', fp);
+	for (cp = (unsigned char *)sp; *cp; cp++) {
+		if ((*cp == '"') || (*cp == '\\'))
+			fprintf(fp, "\\%c", *cp);
+		else if (*cp == '\n')
+			fputs("\\n", fp);
+		else if (*cp == '\t')
+			fputs("\\t", fp);
+		else if (*cp < 0x20)
+			fprintf(fp, "\\u%04x", *cp);
+		else fputc(*cp, fp);
+	}
+	fputc('"', fp);
+} // End of xdd_json_quote()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_json_str(), xdd_json_int(), and xdd_json_num() - Write a member of an
+ * object that has already been started
+ */
+static void
+xdd_json_str(FILE *fp, char *name, char *value) {
+	fprintf(fp, ",\"%s\":", name);
+	xdd_json_quote(fp, value);
+} // End of xdd_json_str()
+
+static void
+xdd_json_int(FILE *fp, char *name, long long int value) {
+	fprintf(fp, ",\"%s\":%lld", name, value);
+} // End of xdd_json_int()
+
+static void
+xdd_json_num(FILE *fp, char *name, double value) {
+	// JSON has no infinity or NaN, and the huge "none yet" values are not results either
+	if (!isfinite(value) || (value >= DOUBLE_MAX) || (value <= -DOUBLE_MAX))
+		fprintf(fp, ",\"%s\":null", name);
+	else fprintf(fp, ",\"%s\":%.9g", name, value);
+} // End of xdd_json_num()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_plan() - Write the "plan" object
+ */
+static void
+xdd_results_json_plan(xdd_plan_t *planp) {
+	FILE			*fp;
+	target_data_t	*tdp;
+	int				target_number;
+	int				i;
+
+
+	fp = planp->json_fp;
+	fprintf(fp, "{\"type\":\"plan\"");
+	xdd_json_int(fp, "format_version", XDD_JSON_VERSION);
+	xdd_json_str(fp, "xdd_version", PACKAGE_VERSION);
+	xdd_json_str(fp, "host", planp->hostname.nodename);
+	xdd_json_int(fp, "pid", (long long int)getpid());
+	xdd_json_str(fp, "id", xgp->id);
+	fprintf(fp, ",\"command_line\":[");
+	for (i = 0; i < xgp->argc; i++) {
+		if (i)
+			fputc(',', fp);
+		xdd_json_quote(fp, xgp->argv[i]);
+	}
+	fputc(']', fp);
+	xdd_json_int(fp, "passes", planp->passes);
+	xdd_json_num(fp, "pass_delay", planp->pass_delay);
+	xdd_json_num(fp, "run_time", planp->run_time);
+	xdd_json_int(fp, "number_of_targets", planp->number_of_targets);
+	fprintf(fp, ",\"plan_options\":\"0x%016llx\"", (unsigned long long)planp->plan_options);
+	fprintf(fp, ",\"targets\":[");
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		if (target_number)
+			fputc(',', fp);
+		fprintf(fp, "{\"target\":%d", tdp->td_target_number);
+		xdd_json_str(fp, "path", tdp->td_target_full_pathname);
+		xdd_json_str(fp, "op", (tdp->td_rwratio == 0.0) ? "write" : ((tdp->td_rwratio == 1.0) ? "read" : "mixed"));
+		xdd_json_num(fp, "read_ratio", tdp->td_rwratio);
+		xdd_json_int(fp, "block_size", tdp->td_block_size);
+		xdd_json_int(fp, "request_size", tdp->td_reqsize);
+		xdd_json_int(fp, "transfer_size", (long long int)tdp->td_xfer_size);
+		xdd_json_int(fp, "queue_depth", tdp->td_queue_depth);
+		xdd_json_int(fp, "ops_per_pass", (long long int)tdp->td_target_ops);
+		xdd_json_int(fp, "bytes_per_pass", (long long int)tdp->td_target_bytes_to_xfer_per_pass);
+		xdd_json_int(fp, "start_offset", (long long int)tdp->td_start_offset);
+		xdd_json_int(fp, "pass_offset", (long long int)tdp->td_pass_offset);
+		xdd_json_num(fp, "time_limit", tdp->td_time_limit);
+		fprintf(fp, ",\"target_options\":\"0x%016llx\"", (unsigned long long)tdp->td_target_options);
+		fputc('}', fp);
+	}
+	fprintf(fp, "]}\n");
+} // End of xdd_results_json_plan()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_results() - Write the members that come from a results
+ * structure
+ */
+static void
+xdd_results_json_results(FILE *fp, results_t *rp) {
+	xdd_json_str(fp, "op", rp->optype);
+	xdd_json_int(fp, "queue_depth", rp->queue_depth);
+	xdd_json_num(fp, "transfer_size", rp->xfer_size_bytes);
+	xdd_json_int(fp, "bytes", (long long int)rp->bytes_xfered);
+	xdd_json_int(fp, "bytes_read", (long long int)rp->bytes_read);
+	xdd_json_int(fp, "bytes_written", (long long int)rp->bytes_written);
+	xdd_json_int(fp, "ops", (long long int)rp->op_count);
+	xdd_json_int(fp, "read_ops", (long long int)rp->read_op_count);
+	xdd_json_int(fp, "write_ops", (long long int)rp->write_op_count);
+	xdd_json_int(fp, "errors", (long long int)rp->error_count);
+	xdd_json_num(fp, "elapsed_time", rp->elapsed_pass_time);
+	xdd_json_num(fp, "op_time", rp->accumulated_op_time);
+	xdd_json_num(fp, "read_op_time", rp->accumulated_read_op_time);
+	xdd_json_num(fp, "write_op_time", rp->accumulated_write_op_time);
+	xdd_json_num(fp, "pattern_fill_time", rp->accumulated_pattern_fill_time);
+	xdd_json_num(fp, "flush_time", rp->accumulated_flush_time);
+	xdd_json_num(fp, "bandwidth", rp->bandwidth);
+	xdd_json_num(fp, "read_bandwidth", rp->read_bandwidth);
+	xdd_json_num(fp, "write_bandwidth", rp->write_bandwidth);
+	xdd_json_num(fp, "iops", rp->iops);
+	xdd_json_num(fp, "read_iops", rp->read_iops);
+	xdd_json_num(fp, "write_iops", rp->write_iops);
+	xdd_json_num(fp, "latency", rp->latency / 1000.0);
+	xdd_json_num(fp, "user_time", rp->user_time);
+	xdd_json_num(fp, "system_time", rp->system_time);
+	xdd_json_num(fp, "percent_cpu", rp->percent_cpu);
+	if (rp->e2e_io_time_this_pass > 0.0) {
+		xdd_json_num(fp, "e2e_send_receive_time", rp->e2e_sr_time_this_pass);
+		xdd_json_num(fp, "e2e_percent_send_receive_time", rp->e2e_sr_time_percent_this_pass);
+		xdd_json_num(fp, "e2e_wait_first_message", rp->e2e_wait_1st_msg);
+	}
+} // End of xdd_results_json_results()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_histograms() - Write the "latency_percentiles" member with the op time
+ * percentiles of reads, writes, and all ops, and the buckets that have op
+ * times in them as [lowest, highest, count] when with_buckets is set.
+ */
+static void
+xdd_results_json_histograms(FILE *fp, xint_histograms_t *hsp, int with_buckets) {
+	static char			*names[XINT_HISTOGRAMS] = { "read", "write", "all", "handoff", "preissue", "dispatch" };
+	xint_histogram_t	*hp;
+	int					first;
+	int					i;
+	int					b;
+
+
+	if (hsp == NULL)
+		return;
+	fprintf(fp, ",\"latency_percentiles\":{");
+	first = 1;
+	for (i = 0; i < hsp->hs_count; i++) {
+		hp = &hsp->hs_hist[i];
+		if (hp->h_count == 0)
+			continue;
+		fprintf(fp, "%s\"%s\":{\"count\":%llu", (first) ? "" : ",", names[i], (unsigned long long)hp->h_count);
+		first = 0;
+		xdd_json_num(fp, "min", (double)hp->h_min / FLOAT_BILLION);
+		xdd_json_num(fp, "mean", ((double)hp->h_total / (double)hp->h_count) / FLOAT_BILLION);
+		xdd_json_num(fp, "p50", (double)xdd_histogram_percentile(hp, 50.0) / FLOAT_BILLION);
+		xdd_json_num(fp, "p90", (double)xdd_histogram_percentile(hp, 90.0) / FLOAT_BILLION);
+		xdd_json_num(fp, "p99", (double)xdd_histogram_percentile(hp, 99.0) / FLOAT_BILLION);
+		xdd_json_num(fp, "p999", (double)xdd_histogram_percentile(hp, 99.9) / FLOAT_BILLION);
+		xdd_json_num(fp, "p9999", (double)xdd_histogram_percentile(hp, 99.99) / FLOAT_BILLION);
+		xdd_json_num(fp, "max", (double)hp->h_max / FLOAT_BILLION);
+		if (with_buckets) {
+			fprintf(fp, ",\"buckets_ns\":[");
+			for (b = 0; b < XINT_HISTOGRAM_BUCKETS; b++) {
+				if (hp->h_buckets[b] == 0)
+					continue;
+				fprintf(fp, "%s[%llu,%llu,%llu]", (with_buckets > 1) ? "," : "",
+					(unsigned long long)xdd_histogram_bucket_low(b), (unsigned long long)xdd_histogram_bucket_high(b),
+					(unsigned long long)hp->h_buckets[b]);
+				with_buckets = 2;
+			}
+			fputc(']', fp);
+			with_buckets = 1;
+		}
+		fputc('}', fp);
+	}
+	fputc('}', fp);
+} // End of xdd_results_json_histograms()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_extended_stats() - Write the "extended_stats" member with
+ * the longest and shortest ops of the pass just done for -extendedstats
+ */
+static void
+xdd_results_json_extended_stats(FILE *fp, target_data_t *tdp) {
+	xint_extended_stats_t	*esp;
+
+
+	esp = tdp->td_esp;
+	if ((esp == NULL) || !(xgp->global_options & GO_EXTENDED_STATS))
+		return;
+	fprintf(fp, ",\"extended_stats\":{\"longest_op_time\":%.9g", (double)esp->my_longest_op_time / FLOAT_BILLION);
+	xdd_json_int(fp, "longest_op_bytes", (long long int)esp->my_longest_op_bytes);
+	xdd_json_int(fp, "longest_op_number", (long long int)esp->my_longest_op_number);
+	xdd_json_num(fp, "longest_read_op_time", (double)esp->my_longest_read_op_time / FLOAT_BILLION);
+	xdd_json_num(fp, "longest_write_op_time", (double)esp->my_longest_write_op_time / FLOAT_BILLION);
+	if (esp->my_shortest_op_time != NCLK_MAX) {
+		xdd_json_num(fp, "shortest_op_time", (double)esp->my_shortest_op_time / FLOAT_BILLION);
+		xdd_json_int(fp, "shortest_op_bytes", (long long int)esp->my_shortest_op_bytes);
+		xdd_json_int(fp, "shortest_op_number", (long long int)esp->my_shortest_op_number);
+	}
+	if (esp->my_shortest_read_op_time != NCLK_MAX)
+		xdd_json_num(fp, "shortest_read_op_time", (double)esp->my_shortest_read_op_time / FLOAT_BILLION);
+	if (esp->my_shortest_write_op_time != NCLK_MAX)
+		xdd_json_num(fp, "shortest_write_op_time", (double)esp->my_shortest_write_op_time / FLOAT_BILLION);
+	fputc('}', fp);
+} // End of xdd_results_json_extended_stats()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_state_times() - Write the "state_times" member with the
+ * seconds spent in each Worker Thread state for -statetimes
+ */
+static void
+xdd_results_json_state_times(FILE *fp, nclk_t *times) {
+	int		i;
+
+
+	fprintf(fp, ",\"state_times\":{");
+	for (i = 0; i < WORKER_STATE_TIMES; i++)
+		fprintf(fp, "%s\"%s\":%.9g", (i == 0) ? "" : ",", xdd_worker_state_name(i), (double)times[i] / FLOAT_BILLION);
+	fputc('}', fp);
+} // End of xdd_results_json_state_times()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_target_state_times() - Write the "state_times" member with
+ * the sum of the state times of all the Worker Threads of a target for the
+ * pass just done or, if "total" is set, for the run
+ */
+static void
+xdd_results_json_target_state_times(FILE *fp, target_data_t *tdp, int total) {
+	worker_data_t	*wdp;
+	nclk_t			all[WORKER_STATE_TIMES];
+	int				i;
+
+
+	if (!(tdp->td_planp->plan_options & PLAN_STATE_TIMES))
+		return;
+	memset(all, 0, sizeof(all));
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) 
+		for (i = 0; i < WORKER_STATE_TIMES; i++)
+			all[i] += (total) ? wdp->wd_state_time_total[i] : wdp->wd_state_time[i];
+	xdd_results_json_state_times(fp, all);
+} // End of xdd_results_json_target_state_times()
+
+/* xdd_results_json_workers() - Write the "workers" member with the counters
+ * of each Worker Thread of a target for the pass just done
+ */
+static void
+xdd_results_json_workers(FILE *fp, target_data_t *tdp) {
+	worker_data_t	*wdp;
+	double			elapsed;
+
+
+	fprintf(fp, ",\"workers\":[");
+	for (wdp = tdp->td_next_wdp; wdp; wdp = wdp->wd_next_wdp) {
+		fprintf(fp, "%s{\"worker\":%d", (wdp == tdp->td_next_wdp) ? "" : ",", wdp->wd_worker_number);
+		xdd_json_int(fp, "bytes", (long long int)wdp->wd_counters.tc_accumulated_bytes_xfered);
+		xdd_json_int(fp, "ops", (long long int)wdp->wd_counters.tc_accumulated_op_count);
+		xdd_json_int(fp, "read_ops", (long long int)wdp->wd_counters.tc_accumulated_read_op_count);
+		xdd_json_int(fp, "write_ops", (long long int)wdp->wd_counters.tc_accumulated_write_op_count);
+		xdd_json_int(fp, "errors", (long long int)wdp->wd_counters.tc_current_error_count);
+		xdd_json_num(fp, "op_time", (double)wdp->wd_counters.tc_accumulated_op_time / FLOAT_BILLION);
+		elapsed = -1.0;
+		if (wdp->wd_counters.tc_pass_end_time > wdp->wd_counters.tc_pass_start_time)
+			elapsed = (double)(wdp->wd_counters.tc_pass_end_time - wdp->wd_counters.tc_pass_start_time) / FLOAT_BILLION;
+		if (elapsed > 0.0) {
+			xdd_json_num(fp, "elapsed_time", elapsed);
+			xdd_json_num(fp, "bandwidth", ((double)wdp->wd_counters.tc_accumulated_bytes_xfered / elapsed) / FLOAT_MILLION);
+			xdd_json_num(fp, "iops", (double)wdp->wd_counters.tc_accumulated_op_count / elapsed);
+		}
+		if (tdp->td_planp->plan_options & PLAN_STATE_TIMES)
+			xdd_results_json_state_times(fp, wdp->wd_state_time);
+		fputc('}', fp);
+	}
+	fputc(']', fp);
+} // End of xdd_results_json_workers()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_pass() - Write the "target_pass" object of a target.
+ * The file is opened and the "plan" object written the first time.
+ * This is called by the Results Manager at the end of each pass while the
+ * Worker Threads are idle.
+ */
+void
+xdd_results_json_pass(xdd_plan_t *planp, target_data_t *tdp, results_t *trp) {
+	FILE	*fp;
+
+
+	if (planp->json_filename == NULL)
+		return;
+	if (planp->json_fp == NULL) {
+		planp->json_fp = fopen(planp->json_filename, "w");
+		if (planp->json_fp == NULL) {
+			fprintf(xgp->errout,"%s: xdd_results_json_pass: ERROR: Cannot open JSON results file '%s'\n",
+				xgp->progname, planp->json_filename);
+			perror("Reason");
+			planp->json_filename = NULL;
+			return;
+		}
+		xdd_results_json_plan(planp);
+	}
+	fp = planp->json_fp;
+	fprintf(fp, "{\"type\":\"target_pass\",\"target\":%d,\"pass\":%d", trp->my_target_number, trp->pass_number);
+	xdd_results_json_results(fp, trp);
+	xdd_results_json_histograms(fp, trp->hgp, 0);
+	xdd_results_json_extended_stats(fp, tdp);
+	xdd_results_json_target_state_times(fp, tdp, 0);
+	xdd_results_json_workers(fp, tdp);
+	fprintf(fp, "}\n");
+	fflush(fp);
+} // End of xdd_results_json_pass()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_results_json_run() - Write the "target_average" object of each target
+ * and the "combined" object, and close the file. The run histograms go in
+ * with their buckets.
+ * This is called by the Results Manager at the end of the run.
+ */
+void
+xdd_results_json_run(xdd_plan_t *planp, results_t *crp) {
+	FILE		*fp;
+	results_t	*tarp;
+	int			target_number;
+
+
+	fp = planp->json_fp;
+	if (fp == NULL)
+		return;
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tarp = planp->target_average_resultsp[target_number];
+		fprintf(fp, "{\"type\":\"target_average\",\"target\":%d,\"passes\":%d", target_number, tarp->pass_number);
+		xdd_results_json_results(fp, tarp);
+		xdd_results_json_histograms(fp, tarp->hgp, 1);
+		xdd_results_json_target_state_times(fp, planp->target_datap[target_number], 1);
+		fprintf(fp, "}\n");
+	}
+	fprintf(fp, "{\"type\":\"combined\",\"passes\":%d", planp->passes);
+	xdd_json_int(fp, "targets", planp->number_of_targets);
+	xdd_results_json_results(fp, crp);
+	xdd_results_json_histograms(fp, crp->hgp, 1);
+	xdd_json_int(fp, "aborted", (long long int)xgp->abort);
+	fprintf(fp, "}\n");
+	fclose(fp);
+	planp->json_fp = NULL;
+} // End of xdd_results_json_run()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
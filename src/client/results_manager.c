@@ -199,6 +199,10 @@ xdd_process_pass_results(xdd_plan_t *planp) {
     results_t	targetpass_results; // Temporary for target pass results
 
 	
+	// Write the interval statistics up to the end of this pass before the histograms are emptied
+	xdd_timeseries_pass_end(planp);
+	xdd_metrics_pass_end(planp);
+
 	// Initialize temporary to 0
 	memset(&targetpass_results, 0, sizeof(targetpass_results));
 		   
@@ -252,6 +256,12 @@ xdd_process_pass_results(xdd_plan_t *planp) {
                 xdd_results_display(trp);
             }
         }
+
+		// Add the time the Worker Threads spent in each state this pass to that of the run
+		xdd_worker_state_pass_end(tdp);
+
+		// Write the Pass Results for this target to the JSON results file if requested
+		xdd_results_json_pass(planp, tdp, trp);
 	
     } /* end of FOR loop that looks at all targets */
     
@@ -281,6 +291,15 @@ xdd_process_run_results(xdd_plan_t *planp) {
 	// Tell the heartbeat to stop
 	planp->heartbeat_flags |= HEARTBEAT_EXIT;
 
+	// Write the last interval statistics
+	xdd_timeseries_stop(planp);
+
+	// Make the last update of the live statistics and remove them
+	xdd_shmstats_stop(planp);
+
+	// Stop answering metrics requests
+	xdd_metrics_stop(planp);
+
 	// Initialize the place where the COMBINED results are accumulated
 	crp = &combined_results; 
 	memset(crp, 0, sizeof(results_t));
@@ -335,6 +354,86 @@ xdd_process_run_results(xdd_plan_t *planp) {
 		xdd_results_display(crp);
 	}
 
+	// Write the AVERAGE and COMBINED results to the JSON results file if requested
+	xdd_results_json_run(planp, crp);
+
+	// Display the per request size, sparse file, verify, latency percentile, and per extent results of each target
+	for (target_number=0; target_number<planp->number_of_targets; target_number++) { 
+		tdp = planp->target_datap[target_number];
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) {
+			xdd_size_class_results_display(xgp->output, tdp, planp->target_average_resultsp[target_number]);
+			if (xgp->csvoutput)
+				xdd_size_class_results_display(xgp->csvoutput, tdp, planp->target_average_resultsp[target_number]);
+		}
+		if (tdp->td_target_options & TO_SPARSE) {
+			fprintf(xgp->output,"Target %d sparse file, %llu, hole ops, %llu, hole bytes not moved\n",
+				tdp->td_target_number, (unsigned long long)tdp->td_hole_ops, (unsigned long long)tdp->td_hole_bytes);
+			if (xgp->csvoutput)
+				fprintf(xgp->csvoutput,"Target %d sparse file, %llu, hole ops, %llu, hole bytes not moved\n",
+					tdp->td_target_number, (unsigned long long)tdp->td_hole_ops, (unsigned long long)tdp->td_hole_bytes);
+		}
+		if (tdp->td_target_options & (TO_VERIFY_CONTENTS | TO_VERIFY_LOCATION)) {
+			fprintf(xgp->output,"Target %d verify, %lld, data compare errors\n",
+				tdp->td_target_number, (long long int)tdp->td_dpp->data_pattern_compare_errors);
+			if (xgp->csvoutput)
+				fprintf(xgp->csvoutput,"Target %d verify, %lld, data compare errors\n",
+					tdp->td_target_number, (long long int)tdp->td_dpp->data_pattern_compare_errors);
+		}
+		if ((tdp->td_target_options & TO_VERIFY_CHECKSUM) && tdp->td_csp) {
+			fprintf(xgp->output,"Target %d %s checksums, %llu, blocks recorded, %llu, blocks verified, %llu, blocks without a checksum, %lld, checksum errors\n",
+				tdp->td_target_number, xdd_checksum_name(tdp->td_csp->cs_algorithm),
+				(unsigned long long)tdp->td_csp->cs_blocks_recorded, (unsigned long long)tdp->td_csp->cs_blocks_verified,
+				(unsigned long long)tdp->td_csp->cs_blocks_unknown, (long long int)tdp->td_csp->cs_errors);
+			if (xgp->csvoutput)
+				fprintf(xgp->csvoutput,"Target %d %s checksums, %llu, blocks recorded, %llu, blocks verified, %llu, blocks without a checksum, %lld, checksum errors\n",
+					tdp->td_target_number, xdd_checksum_name(tdp->td_csp->cs_algorithm),
+					(unsigned long long)tdp->td_csp->cs_blocks_recorded, (unsigned long long)tdp->td_csp->cs_blocks_verified,
+					(unsigned long long)tdp->td_csp->cs_blocks_unknown, (long long int)tdp->td_csp->cs_errors);
+		}
+		if (tdp->td_vpp && (tdp->td_vpp->vp_threads > 0)) {
+			xdd_verify_pool_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_verify_pool_display(xgp->csvoutput, tdp);
+		}
+		if (tdp->td_pfp) {
+			xdd_prefill_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_prefill_display(xgp->csvoutput, tdp);
+		}
+		if (tdp->td_cop && tdp->td_cop->co_op) {
+			xdd_compound_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_compound_display(xgp->csvoutput, tdp);
+		}
+		if (tdp->td_mfp) {
+			xdd_manifest_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_manifest_display(xgp->csvoutput, tdp);
+		}
+		if ((tdp->td_target_options & TO_ENDTOEND) && tdp->td_e2ep &&
+			((tdp->td_target_options & TO_E2E_CHECKSUM) || tdp->td_e2ep->e2e_crc_msgs)) {
+			xdd_e2e_checksum_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_e2e_checksum_display(xgp->csvoutput, tdp);
+		}
+		tarp = planp->target_average_resultsp[target_number];
+		if (tarp->hgp) {
+			xdd_histogram_display(xgp->output, tdp, tarp->hgp);
+			if (xgp->csvoutput)
+				xdd_histogram_display(xgp->csvoutput, tdp, tarp->hgp);
+		}
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_EXTENTS) {
+			xdd_extent_results_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_extent_results_display(xgp->csvoutput, tdp);
+		}
+		if (planp->plan_options & PLAN_STATE_TIMES) {
+			xdd_worker_state_display(xgp->output, tdp);
+			if (xgp->csvoutput)
+				xdd_worker_state_display(xgp->csvoutput, tdp);
+		}
+	}
+
 	// Process TimeStamp reports for the -ts option
 	for (target_number=0; target_number<planp->number_of_targets; target_number++) { 
 		tdp = planp->target_datap[target_number]; /* Get the target_datap for this target */
@@ -343,15 +442,112 @@ xdd_process_run_results(xdd_plan_t *planp) {
 			if (tdp->td_ts_table.ts_current_entry > tdp->td_ts_table.ts_size) 
 				tdp->td_ts_table.ts_hdrp->tsh_numents = tdp->td_ts_table.ts_size;
 			else tdp->td_ts_table.ts_hdrp->tsh_numents = tdp->td_ts_table.ts_current_entry;
-			xdd_ts_reports(tdp);  /* generate reports if requested */
-			xdd_ts_write(tdp); 
+			if (tdp->td_ts_table.ts_options & TS_STREAM) {
+				xdd_ts_stream_close(tdp); /* the entries are already in the dump file */
+			} else {
+				xdd_ts_reports(tdp);  /* generate reports if requested */
+				xdd_ts_write(tdp); 
+			}
 			xdd_ts_cleanup(tdp->td_ts_table.ts_hdrp); /* call this to free the TS table in memory */
 		}
 	} // End of processing TimeStamp reports
 
+	// Write the latency histograms for the -histogram option
+	xdd_histogram_write(planp);
+	for (target_number=0; target_number<planp->number_of_targets; target_number++) { 
+		tarp = planp->target_average_resultsp[target_number];
+		if (tarp->hgp) {
+			free(tarp->hgp);
+			tarp->hgp = NULL;
+		}
+	}
+	if (crp->hgp) {
+		free(crp->hgp);
+		crp->hgp = NULL;
+	}
+
 	return(0);
 } // End of xdd_process_run_results() 
 
+/*----------------------------------------------------------------------------*/
+// xdd_size_class_results_display() 
+// Display the bandwidth, IOPS, and average latency of each request size class
+// of a target that uses variable request sizes. The bandwidth and IOPS are the 
+// share of the target's elapsed time over all passes that went to each size.
+// Called by xdd_process_run_results() 
+//
+void
+xdd_size_class_results_display(FILE *out, target_data_t *tdp, results_t *tarp) {
+	int32_t		i;
+	seek_size_class_t	*scp;
+	double		elapsed;	// Elapsed time over all passes in seconds
+	double		latency;	// Average op time in milliseconds
+
+
+	elapsed = tarp->elapsed_pass_time;
+	fprintf(out,"Target %d request size distribution\n", tdp->td_target_number);
+	fprintf(out,"%16s %8s %14s %18s %12s %12s %12s\n", 
+		"Size(bytes)", "Weight", "Ops", "Bytes", "MB/sec", "IOPS", "Latency(ms)");
+	for (i = 0; i < tdp->td_seekhdr.seek_num_size_classes; i++) {
+		scp = &tdp->td_seekhdr.seek_size_classes[i];
+		if (scp->ops > 0) 
+			latency = ((double)scp->op_time / (double)scp->ops) / FLOAT_MILLION;
+		else latency = 0.0;
+		fprintf(out,"%16llu %8d %14lld %18lld %12.3f %12.3f %12.4f\n",
+			(unsigned long long)scp->size_bytes,
+			scp->weight,
+			(long long)scp->ops,
+			(long long)scp->bytes,
+			(elapsed > 0.0) ? ((double)scp->bytes / elapsed) / FLOAT_MILLION : -1.0,
+			(elapsed > 0.0) ? (double)scp->ops / elapsed : -1.0,
+			latency);
+	}
+	fflush(out);
+} // End of xdd_size_class_results_display()
+
+/*----------------------------------------------------------------------------*/
+// xdd_extent_results_display() 
+// Display the bandwidth and average latency of the ops that started in each
+// extent of a target whose seek list walks the extents of the file, in the 
+// order the extents were walked. The bandwidth of an extent is its bytes over
+// the accumulated op time of its ops. A jump in physical address from one extent
+// to the next is marked with a '*' so slow extents can be lined up with the
+// fragmentation of the file.
+// Called by xdd_process_run_results() 
+//
+void
+xdd_extent_results_display(FILE *out, target_data_t *tdp) {
+	int32_t		i;
+	seek_extent_t	*ep;
+	double		latency;	// Average op time in milliseconds
+	double		seconds;	// Op time of this extent in seconds
+
+
+	fprintf(out,"Target %d extents, %d in use, %d physical discontiguities\n", 
+		tdp->td_target_number, tdp->td_seekhdr.seek_num_extents, tdp->td_seekhdr.seek_extent_discontiguities);
+	fprintf(out,"%8s %1s %18s %18s %14s %8s %12s %16s %12s %12s\n", 
+		"Extent", "", "Logical", "Physical", "Length", "Flags", "Ops", "Bytes", "MB/sec", "Latency(ms)");
+	for (i = 0; i < tdp->td_seekhdr.seek_num_extents; i++) {
+		ep = &tdp->td_seekhdr.seek_extents[i];
+		seconds = (double)ep->op_time / FLOAT_BILLION;
+		if (ep->ops > 0) 
+			latency = ((double)ep->op_time / (double)ep->ops) / FLOAT_MILLION;
+		else latency = 0.0;
+		fprintf(out,"%8d %1s %18llu %18llu %14llu %8x %12lld %16lld %12.3f %12.4f\n",
+			i,
+			((i > 0) && (ep->physical != (ep[-1].physical + ep[-1].length))) ? "*" : "",
+			(unsigned long long)ep->logical,
+			(unsigned long long)ep->physical,
+			(unsigned long long)ep->length,
+			ep->flags,
+			(long long)ep->ops,
+			(long long)ep->bytes,
+			(seconds > 0.0) ? ((double)ep->bytes / seconds) / FLOAT_MILLION : 0.0,
+			latency);
+	}
+	fflush(out);
+} // End of xdd_extent_results_display()
+
 /*----------------------------------------------------------------------------*/
 // xdd_combine_results() 
 // Called by xdd_results_manager() to combine results from a Worker Thread pass 
@@ -680,6 +876,14 @@ xdd_combine_results(results_t *to, results_t *from, xdd_plan_t *planp) {
 	if (to->shortest_write_op_pass_number > from->longest_op_pass_number)
 		to->shortest_write_op_pass_number = from->longest_op_pass_number;
 
+	// Latency Histograms
+	if (from->hgp) {
+		if (to->hgp == NULL)
+			to->hgp = xdd_histogram_alloc(from->hgp->hs_count);
+		if (to->hgp)
+			xdd_histogram_merge(to->hgp, from->hgp);
+	}
+
 } // End of xdd_combine_results()
 
 /*----------------------------------------------------------------------------*/
@@ -697,6 +901,7 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 	// Basic parameters
 	rp->pass_number = tdp->td_counters.tc_pass_number;	// int32
 	rp->my_target_number = tdp->td_target_number;		// int32
+	rp->hgp = xdd_histogram_target_pass(tdp);			// Latency histograms of the Worker Threads
 	rp->queue_depth = tdp->td_queue_depth;				// int32
 	rp->bytes_xfered = tdp->td_counters.tc_accumulated_bytes_xfered;	// int64
 	rp->bytes_read = tdp->td_counters.tc_accumulated_bytes_read;		// int64
@@ -734,6 +939,12 @@ xdd_extract_pass_results(results_t *rp, target_data_t *tdp, xdd_plan_t *planp) {
 	rp->xfer_size_blocks = tdp->td_xfer_size/tdp->td_block_size;	// blocks
 	rp->xfer_size_kbytes = tdp->td_xfer_size/1024;			// kbytes
 	rp->xfer_size_mbytes = tdp->td_xfer_size/(1024*1024);	// mbytes
+	if ((tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) && (rp->op_count > 0)) { // Report the average request size
+		rp->xfer_size_bytes = (double)rp->bytes_xfered / (double)rp->op_count;	// bytes
+		rp->xfer_size_blocks = rp->xfer_size_bytes/tdp->td_block_size;	// blocks
+		rp->xfer_size_kbytes = rp->xfer_size_bytes/1024;			// kbytes
+		rp->xfer_size_mbytes = rp->xfer_size_bytes/(1024*1024);	// mbytes
+	}
 
 	// Bandwidth
 	rp->bandwidth = (double)(((double)rp->bytes_xfered / (double)rp->elapsed_pass_time) / FLOAT_MILLION);  // MB/sec
@@ -62,6 +62,16 @@ xdd_init_seek_list(target_data_t *tdp) {
 	int32_t  previous_percent_op; /* used to determine read/write operation */
 	int32_t  percent_op;  /* used to determine read/write operation */
 	int32_t  current_op;  /* Current operation - SO_OP_READ or SO_OP_WRITE or SO_OP_NOOP */
+	int32_t  reqsize;  /* Request size in blocks for the current operation */
+	int32_t  reqsize_high; /* Largest request size in blocks in the seek list */
+	int64_t  next_location; /* Next sequential location in blocks when request sizes vary */
+	int32_t  total_weight; /* Sum of the weights of the request size distribution */
+	uint64_t bytes_in_list; /* Total number of bytes described by the seek list */
+	int64_t  step;   /* Distance in blocks to the next op of a stream */
+	seek_stream_t *stp;  /* Stream that supplies the current seek location */
+	seek_extent_t *ep;   /* File extent that supplies the current seek location */
+	int32_t  extent_index; /* Index of the current file extent */
+	int64_t  extent_offset; /* Offset in blocks of the next op within the current file extent */
 	seekhdr_t *sp;   /* pointer to the seek header */
         
 	/* If a throttle value has been specified, calculate the time that each operation should take */
@@ -111,13 +121,66 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
 		rw_op_index = 0;
 		rw_index = 0;
 		rw_index_incr = 1;
+		next_location = 0;
+		total_weight = 0;
+		for (j = 0; j < sp->seek_num_size_classes; j++)
+			total_weight += sp->seek_size_classes[j].weight;
+		for (j = 0; j < sp->seek_num_streams; j++)
+			sp->seek_streams[j].next_location = sp->seek_streams[j].start;
+		extent_index = 0;
+		extent_offset = 0;
+		if (sp->seek_options & SO_SEEK_EXTENTS) { /* The file system tells us where the data lives */
+			if (xdd_extent_map_init(tdp) <= 0) {
+				fprintf(xgp->errout,"%s: xdd_init_seek_list: WARNING: No usable extents for target %d - using sequential locations\n",
+					xgp->progname, tdp->td_target_number);
+				sp->seek_options &= ~SO_SEEK_EXTENTS;
+			}
+		}
+		/* Pick the request sizes first since they decide how many ops it takes to move the bytes of a pass */
+		if ((sp->seek_options & SO_SEEK_VARSIZE) && (total_weight > 0)) {
+			if (xdd_size_distribution_pick(tdp, total_weight) < 0)
+				return;
+		}
 		sp->seek_num_rw_ops = sp->seek_total_ops;
 		if (tdp->td_rwratio >= 0.5) /* This has to be set correctly or the first op may not be correct */
 			previous_percent_op = -1.0;
 		else previous_percent_op = 0.0;
 		for (op_index = 0; op_index < sp->seek_total_ops; op_index++) {   
+			/* The request size for this operation was picked from the size distribution if there is one */
+			if ((sp->seek_options & SO_SEEK_VARSIZE) && (total_weight > 0))
+				reqsize = sp->seeks[rw_index].reqsize;
+			else reqsize = tdp->td_reqsize;
 			/* Fill in the seek location */
-			if (sp->seek_options & SO_SEEK_RANDOM) { /* generate a random seek location */
+			if ((sp->seek_options & SO_SEEK_STREAMS) && (sp->seek_num_streams > 0)) { /* take the next location of one of the streams */
+				stp = xdd_seek_next_stream(sp, op_index);
+				step = (stp->stride > 0) ? stp->stride : reqsize;
+				/* Stream locations are relative to the start offset - a stream that runs past the seek range starts over */
+				if ((sp->seek_range > 0) && (stp->next_location + reqsize > (uint64_t)sp->seek_range)) {
+					if (sp->seek_range > reqsize)
+						stp->next_location = stp->start % (uint64_t)(sp->seek_range - reqsize + 1);
+					else stp->next_location = 0;
+				}
+				sp->seeks[rw_index].block_location = tdp->td_start_offset + stp->next_location;
+				if (stp->direction > 0) 
+					stp->next_location += step;
+				else if (stp->next_location >= (uint64_t)step)
+					stp->next_location -= step;
+				else stp->next_location = stp->start; /* A descending stream that reaches block 0 starts over */
+			} else if (sp->seek_options & SO_SEEK_EXTENTS) { /* walk the extents of the file */
+				ep = &sp->seek_extents[extent_index];
+				if ((extent_offset > 0) && ((uint64_t)(extent_offset + reqsize) * tdp->td_block_size > ep->length)) {
+					/* This request does not fit in what is left of the extent - go to the next one */
+					extent_index = (extent_index + 1) % sp->seek_num_extents;
+					extent_offset = 0;
+					ep = &sp->seek_extents[extent_index];
+				}
+				sp->seeks[rw_index].block_location = (ep->logical / tdp->td_block_size) + extent_offset;
+				sp->seeks[rw_index].extent = extent_index;
+				/* A request cannot run past the end of an extent that is shorter than the request */
+				if ((uint64_t)(extent_offset + reqsize) * tdp->td_block_size > ep->length)
+					reqsize = (ep->length / tdp->td_block_size) - extent_offset;
+				extent_offset += reqsize;
+			} else if (sp->seek_options & SO_SEEK_RANDOM) { /* generate a random seek location */
 				range_in_1kblocks = sp->seek_range;
 				range_in_bytes = range_in_1kblocks * 1024;
 				range_in_blocksize_blocks = range_in_bytes / tdp->td_block_size;
@@ -137,15 +200,21 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
 				        if (sp->seek_stride > tdp->td_reqsize) gap = sp->seek_stride - tdp->td_reqsize;
                                 }
 				else gap = 0; 
+				/* Targets sharing a file in a strided layout skip over the requests of the other targets */
+				if (tdp->td_planp->plan_options & PLAN_SHARED_FILE_STRIDED)
+					gap = (tdp->td_planp->number_of_targets - 1) * tdp->td_reqsize;
 				if (sp->seek_interleave > 1)
 // FIXME ????		interleave_threadoffset = (tdp->td_my_qthread_number%sp->seek_interleave)*tdp->td_reqsize;
 					interleave_threadoffset = sp->seek_interleave*tdp->td_reqsize;
 				else interleave_threadoffset = 0;
-				sp->seeks[rw_index].block_location = tdp->td_start_offset + interleave_threadoffset + 
+				if (sp->seek_options & SO_SEEK_VARSIZE) { /* Each op starts where the previous one ended */
+					sp->seeks[rw_index].block_location = tdp->td_start_offset + interleave_threadoffset + next_location;
+					next_location += (reqsize*sp->seek_interleave)+gap;
+				} else sp->seeks[rw_index].block_location = tdp->td_start_offset + interleave_threadoffset + 
 						(rw_op_index * ((tdp->td_reqsize*sp->seek_interleave)+gap));
 			} /* end of generating a sequential seek */
 			/* Now lets fill in the request sizes to transfer */
-			sp->seeks[rw_index].reqsize = tdp->td_reqsize;
+			sp->seeks[rw_index].reqsize = reqsize;
 			/* Now lets fill in the appropriate operation */
 			/* The operation is specified either as "read" or "write" in which case
 			 * all operations for this target will be either read or write accordingly.
@@ -167,7 +236,10 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
 				previous_percent_op = percent_op;
             	/* Fill in the operation */
 				if (current_op == SO_OP_WRITE) { /* This is a WRITE operation */
-					sp->seeks[rw_index].operation = SO_OP_WRITE;
+					/* -op rmw and -op writeverify turn the writes into compound ops */
+					if (tdp->td_cop && tdp->td_cop->co_op)
+						sp->seeks[rw_index].operation = tdp->td_cop->co_op;
+					else sp->seeks[rw_index].operation = SO_OP_WRITE;
 				} else { /* This is a READ operation */
 					sp->seeks[rw_index].operation = SO_OP_READ;
 				}
@@ -189,13 +261,39 @@ if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %ll
 
             }
 if (xgp->global_options & GO_DEBUG_THROTTLE) fprintf(stderr,"DEBUG_THROTTLE: %lld: xdd_init_seek_list: Target: %d: Worker: %d: SET SEEK TIME: nano_seconds_per_op: %lld: relative_time: %lld:\n", (long long int)pclk_now(),tdp->td_target_number,-1,(long long int)nano_seconds_per_op,(long long int)relative_time);
-			relative_time += nano_seconds_per_op;
+			/* A bandwidth throttle has to allow proportionally more time for larger requests */
+			if ((tdp->td_throtp) && (tdp->td_throtp->throttle_type & XINT_THROTTLE_BW) && (reqsize != tdp->td_reqsize))
+				relative_time += (nclk_t)(((double)nano_seconds_per_op * reqsize) / tdp->td_reqsize);
+			else relative_time += nano_seconds_per_op;
 
 			/* Increment to the next entry in the seek list */
 			rw_index += rw_index_incr;
 			rw_op_index++;
 		} /* end of FOR loop */
 	} /* done generating a new seek list */
+	/* When request sizes vary the pass is defined by the seek list rather than reqsize */
+	reqsize_high = tdp->td_reqsize;
+	bytes_in_list = 0;
+	for (op_index = 0; op_index < sp->seek_total_ops; op_index++) {
+		if (sp->seeks[op_index].reqsize > reqsize_high)
+			reqsize_high = sp->seeks[op_index].reqsize;
+		bytes_in_list += (uint64_t)sp->seeks[op_index].reqsize * tdp->td_block_size;
+	}
+	sp->seek_iosize = reqsize_high * tdp->td_block_size;
+	/* With -numreqs or a loaded seek list that falls short of -bytes the pass moves the bytes in the list */
+	if ((sp->seek_options & SO_SEEK_VARSIZE) && ((tdp->td_numreqs) || (bytes_in_list < tdp->td_target_bytes_to_xfer_per_pass))) {
+		if ((tdp->td_numreqs == 0) && (bytes_in_list < tdp->td_target_bytes_to_xfer_per_pass)) {
+			fprintf(xgp->errout,"%s: xdd_init_seek_list: Target %d: WARNING: the seek list only holds %llu of the %llu bytes to transfer per pass - each pass will transfer %llu bytes\n",
+				xgp->progname, tdp->td_target_number,
+				(unsigned long long)bytes_in_list,
+				(unsigned long long)tdp->td_target_bytes_to_xfer_per_pass,
+				(unsigned long long)bytes_in_list);
+		}
+		tdp->td_target_bytes_to_xfer_per_pass = bytes_in_list;
+	} else if ((sp->seek_options & SO_SEEK_EXTENTS) && (bytes_in_list < tdp->td_target_bytes_to_xfer_per_pass)) {
+		/* Requests cut short at the end of their extents leave fewer bytes for the pass */
+		tdp->td_target_bytes_to_xfer_per_pass = bytes_in_list;
+	}
 	/* Save this seek list to a file if requested to do so */
 	if (sp->seek_options & (SO_SEEK_SAVE | SO_SEEK_SEEKHIST | SO_SEEK_DISTHIST)) 
 		xdd_save_seek_list(tdp);
@@ -255,6 +353,10 @@ xdd_save_seek_list(target_data_t *tdp) {
 				opc = "w";
 			else if (sp->seeks[i].operation == SO_OP_NOOP)
 				opc = "n";
+			else if (sp->seeks[i].operation == SO_OP_READ_MODIFY_WRITE)
+				opc = "m";
+			else if (sp->seeks[i].operation == SO_OP_WRITE_VERIFY)
+				opc = "v";
 			else opc = "u";
 			fprintf(tmp,"%010d %012llu %d %s %016llu %016llu\n",
 				i,
@@ -351,9 +453,19 @@ xdd_load_seek_list(target_data_t *tdp) {
 	char 		*status; 	/* status of the fgets */
 	struct seekhdr	*sp;
 	char 		line[1024]; 	/* one line of characters */
+	int32_t		j;  		/* index variable */
+	seek_size_class_t	*scp;	/* Pointer to a size class */
+	int32_t		compound_op;	// Compound op the target is set up for
+	int32_t		plain_writes;	// Compound ops in the file done as plain writes
 
 
 	sp = &tdp->td_seekhdr;
+	/* Compound ops need the state that -op rmw or -op writeverify sets up - 
+	 * xdd_compound_init() has already turned it off for E2E and SGIO targets.
+	 * A read-modify-write can use either; a write-verify needs the readback ring.
+	 */
+	compound_op = (tdp->td_cop) ? tdp->td_cop->co_op : 0;
+	plain_writes = 0;
 	/* open the load file */
 	loadfp = fopen(sp->seek_loadfile,"r");
 	if (loadfp == NULL) {
@@ -365,7 +477,7 @@ xdd_load_seek_list(target_data_t *tdp) {
 	status = line;
 	i = 0;
 	reqsz_high = 0;
-	while (status != NULL) {
+	while ((status != NULL) && (i < sp->seek_total_ops)) {
 		status = fgets(line, sizeof(line), loadfp);
 		if (status == NULL ) continue;
 		tp = line;
@@ -386,17 +498,214 @@ xdd_load_seek_list(target_data_t *tdp) {
 			sp->seeks[i].operation = SO_OP_WRITE;
 		else if ((rw == 'n') || (rw == 'N')) 
 			sp->seeks[i].operation = SO_OP_NOOP; /* NOOP */
+		else if (((rw == 'm') || (rw == 'M')) && compound_op)
+			sp->seeks[i].operation = SO_OP_READ_MODIFY_WRITE; /* Read-Modify-Write */
+		else if (((rw == 'v') || (rw == 'V')) && (compound_op == SO_OP_WRITE_VERIFY))
+			sp->seeks[i].operation = SO_OP_WRITE_VERIFY; /* Write with a later readback */
+		else if ((rw == 'm') || (rw == 'M') || (rw == 'v') || (rw == 'V')) {
+			sp->seeks[i].operation = SO_OP_WRITE;
+			plain_writes++;
+		}
 		else sp->seeks[i].operation = SO_OP_READ; /* READ */
 		sp->seeks[i].reqsize = reqsz;
 		sp->seeks[i].time1 = t1;
 		sp->seeks[i].time2 = t2;
 		if (reqsz > reqsz_high) reqsz_high = reqsz;
+		/* A request size column that differs from -reqsize makes this a variable size list */
+		if ((reqsz != tdp->td_reqsize) && !(tdp->td_target_options & TO_ENDTOEND))
+			sp->seek_options |= SO_SEEK_VARSIZE;
 		i++;
 	}
+	fclose(loadfp);
+	if (plain_writes)
+		fprintf(xgp->errout,"%s: xdd_load_seek_list: Target %d: WARNING: %d read-modify-write or write-verify ops in seek load file %s are done as plain writes - use -op rmw or -op writeverify to do them\n",
+			xgp->progname, tdp->td_target_number, plain_writes, sp->seek_loadfile);
 	sp->seek_iosize = reqsz_high * tdp->td_block_size;
+
+	/* Build the size classes from the loaded list so results can be reported per size */
+	if ((sp->seek_options & SO_SEEK_VARSIZE) && (sp->seek_num_size_classes == 0)) {
+		for (j = 0; j < i; j++) {
+			scp = xdd_get_size_class(sp, sp->seeks[j].reqsize);
+			if (scp == NULL) {
+				if (sp->seek_num_size_classes == SO_SEEK_MAX_SIZE_CLASSES) 
+					continue; /* Ops of this size are transferred but not reported by size */
+				scp = &sp->seek_size_classes[sp->seek_num_size_classes++];
+				scp->reqsize = sp->seeks[j].reqsize;
+				scp->size_bytes = (uint64_t)sp->seeks[j].reqsize * tdp->td_block_size;
+			}
+			scp->weight++;
+		}
+	}
 	return(0);
 } /* end of xdd_load_seek_list() */
 
+/*----------------------------------------------------------------------------*/
+/* xdd_get_seek_extent() - return the file extent that the specified op of the
+ * seek list starts in, or NULL if the seek list does not walk the extents.
+ */
+seek_extent_t *
+xdd_get_seek_extent(seekhdr_t *sp, int64_t op_number) {
+
+	if (!(sp->seek_options & SO_SEEK_EXTENTS) || (op_number < 0) || (op_number >= sp->seek_total_ops))
+		return(NULL);
+	if ((sp->seeks[op_number].extent < 0) || (sp->seeks[op_number].extent >= sp->seek_num_extents))
+		return(NULL);
+	return(&sp->seek_extents[sp->seeks[op_number].extent]);
+} /* end of xdd_get_seek_extent() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_seek_next_stream() - pick the stream that supplies the location of
+ * the specified operation according to the stream policy.
+ */
+seek_stream_t *
+xdd_seek_next_stream(seekhdr_t *sp, int32_t op_index) {
+	int32_t	i;
+	int32_t	total_weight;	/* Sum of the weights of all streams */
+	int32_t	weight;			/* Used to pick a weighted stream */
+
+
+	switch (sp->seek_stream_policy) {
+		case SO_STREAM_POLICY_RANDOM:
+			i = (int32_t)(sp->seek_num_streams * xdd_random_float());
+			break;
+		case SO_STREAM_POLICY_WEIGHTED:
+			total_weight = 0;
+			for (i = 0; i < sp->seek_num_streams; i++)
+				total_weight += sp->seek_streams[i].weight;
+			weight = (int32_t)(total_weight * xdd_random_float());
+			for (i = 0; i < sp->seek_num_streams - 1; i++) {
+				if (weight < sp->seek_streams[i].weight)
+					break;
+				weight -= sp->seek_streams[i].weight;
+			}
+			break;
+		case SO_STREAM_POLICY_ROUND_ROBIN:
+		default:
+			i = op_index % sp->seek_num_streams;
+			break;
+	}
+	if (i >= sp->seek_num_streams) /* xdd_random_float() can return 1.0 */
+		i = sp->seek_num_streams - 1;
+	return(&sp->seek_streams[i]);
+} /* end of xdd_seek_next_stream() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_size_distribution_init() - convert the request size distribution
+ * specified with "-seek sizedist" into blocks for this target.
+ * Every size class has to be a whole number of blocks.
+ * Returns the weighted mean request size in bytes which is used to figure 
+ * out the number of ops in a pass, or -1 if the distribution is not usable
+ * in which case it is dropped and the target falls back to -reqsize.
+ */
+int64_t
+xdd_size_distribution_init(target_data_t *tdp) {
+	int32_t		i;				/* index variable */
+	int64_t		total_weight;	/* Sum of the weights of all classes */
+	uint64_t	weighted_bytes;	/* Sum of the weighted class sizes */
+	seek_size_class_t	*scp;	/* Pointer to the current size class */
+	seekhdr_t	*sp;
+
+
+	sp = &tdp->td_seekhdr;
+	if (tdp->td_target_options & TO_ENDTOEND) {
+		fprintf(xgp->errout,"%s: xdd_size_distribution_init: Target %d: WARNING: request size distributions are not supported for End-to-End operations - using reqsize\n",
+			xgp->progname, tdp->td_target_number);
+		sp->seek_options &= ~SO_SEEK_VARSIZE;
+		sp->seek_num_size_classes = 0;
+		return(-1);
+	}
+	total_weight = 0;
+	weighted_bytes = 0;
+	for (i = 0; i < sp->seek_num_size_classes; i++) {
+		scp = &sp->seek_size_classes[i];
+		if ((scp->size_bytes == 0) || (scp->size_bytes % tdp->td_block_size)) {
+			fprintf(xgp->errout,"%s: xdd_size_distribution_init: Target %d: ERROR: request size of %llu bytes is not a multiple of the %d-byte block size - using reqsize\n",
+				xgp->progname, tdp->td_target_number, (unsigned long long)scp->size_bytes, tdp->td_block_size);
+			sp->seek_options &= ~SO_SEEK_VARSIZE;
+			sp->seek_num_size_classes = 0;
+			return(-1);
+		}
+		scp->reqsize = scp->size_bytes / tdp->td_block_size;
+		total_weight += scp->weight;
+		weighted_bytes += scp->size_bytes * scp->weight;
+	}
+	return((int64_t)(weighted_bytes / total_weight));
+} /* end of xdd_size_distribution_init() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_size_distribution_pick() - pick the request size of each op of the
+ * seek list from the request size distribution.
+ * With -numreqs the number of ops is fixed and the bytes per pass are the sum
+ * of the sizes picked. Otherwise ops are added until their sizes cover the
+ * bytes to transfer per pass so a pass moves exactly that many bytes - the last
+ * op is cut short by xdd_target_pass_task_setup(). The seek list, the number of
+ * ops in the seek list, and td_target_ops are resized to match.
+ * Returns 0 if all went well or -1 if the seek list could not be resized.
+ */
+int32_t
+xdd_size_distribution_pick(target_data_t *tdp, int32_t total_weight) {
+	int32_t		j;				/* index variable */
+	int64_t		op_index;		/* Current operation number */
+	int64_t		max_ops;		/* Number of entries the seek list has room for */
+	int32_t		weight;			/* Used to pick a class from the request size distribution */
+	uint64_t	bytes_picked;	/* Bytes covered by the sizes picked so far */
+	seek_t		*seeks;			/* The resized seek list */
+	seekhdr_t	*sp;
+
+
+	sp = &tdp->td_seekhdr;
+	max_ops = sp->seek_total_ops;
+	bytes_picked = 0;
+	for (op_index = 0; ; op_index++) {
+		if (tdp->td_numreqs) {
+			if (op_index >= sp->seek_total_ops)
+				break;
+		} else if (bytes_picked >= tdp->td_target_bytes_to_xfer_per_pass) 
+			break;
+		if (op_index >= max_ops) { /* Not enough room for the ops of a pass - make the seek list bigger */
+			max_ops += (max_ops / 4) + 1;
+			seeks = (seek_t *)realloc(sp->seeks, max_ops * sizeof(seek_t));
+			if (seeks == NULL) {
+				fprintf(xgp->errout,"%s: xdd_size_distribution_pick: Target %d: ERROR: Cannot allocate memory for a seek list of %lld ops\n",
+					xgp->progname, tdp->td_target_number, (long long)max_ops);
+				fflush(xgp->errout);
+				xgp->abort = 1;
+				return(-1);
+			}
+			sp->seeks = seeks;
+			memset(&sp->seeks[op_index], 0, (max_ops - op_index) * sizeof(seek_t));
+		}
+		weight = (int32_t)(total_weight * xdd_random_float());
+		for (j = 0; j < sp->seek_num_size_classes - 1; j++) {
+			if (weight < sp->seek_size_classes[j].weight)
+				break;
+			weight -= sp->seek_size_classes[j].weight;
+		}
+		sp->seeks[op_index].reqsize = sp->seek_size_classes[j].reqsize;
+		bytes_picked += (uint64_t)sp->seek_size_classes[j].size_bytes;
+	}
+	sp->seek_total_ops = op_index;
+	tdp->td_target_ops = op_index;
+	return(0);
+} /* end of xdd_size_distribution_pick() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_get_size_class() - return the size class of the request size 
+ * distribution that has the specified request size in blocks or NULL
+ * if there is no such class.
+ */
+seek_size_class_t *
+xdd_get_size_class(seekhdr_t *sp, int32_t reqsize) {
+	int32_t	i;
+
+
+	for (i = 0; i < sp->seek_num_size_classes; i++) {
+		if (sp->seek_size_classes[i].reqsize == reqsize)
+			return(&sp->seek_size_classes[i]);
+	}
+	return(NULL);
+} /* end of xdd_get_size_class() */
+
  
  
  
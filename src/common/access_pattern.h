@@ -13,7 +13,8 @@
 
 #define SO_OP_WRITE 'w'        /**< Write seek entry type */
 #define SO_OP_READ  'r'        /**< Read seek entry type */
-#define SO_OP_WRITE_VERIFY 'v' /**< Write-Verify seek entry type */
+#define SO_OP_WRITE_VERIFY 'v' /**< Write-Verify seek entry type - a write that is read back later */
+#define SO_OP_READ_MODIFY_WRITE 'm' /**< Read-Modify-Write seek entry type */
 #define SO_OP_NOOP  'n'        /**< NOOP seek entry type */
 #define SO_OP_EOF  'e'        /**< EOF seek entry type */
 
@@ -24,6 +25,7 @@ struct seek_entries {
 	uint64_t block_location; /**< Starting location in blocks */
 	nclk_t time1;  /**< Relative time in nano seconds that this operation should start */
 	nclk_t time2;  /**< not yet implemented */
+	int32_t extent; /**< Index into seek_extents of the file extent this op starts in */
 };
 typedef struct seek_entries seek_t;
 
@@ -35,6 +37,55 @@ typedef struct seek_entries seek_t;
 #define SO_SEEK_NONE      0x00000010 /**< No seek locations */
 #define SO_SEEK_DISTHIST  0x00000020 /**< Print the seek distance histogram */
 #define SO_SEEK_SEEKHIST  0x00000040 /**< Print the seek location histogram */
+#define SO_SEEK_VARSIZE   0x00000080 /**< Request size varies per op - taken from seeks[].reqsize */
+#define SO_SEEK_STREAMS   0x00000100 /**< Interleave several sequential streams */
+#define SO_SEEK_EXTENTS   0x00000200 /**< Walk the extents of the file as mapped by the file system */
+
+#define SO_SEEK_MAX_SIZE_CLASSES 16 /**< Maximum number of classes in a request size distribution */
+
+/** A single class of a request size distribution */
+struct seek_size_class {
+	uint64_t size_bytes; /**< Request size of this class in bytes */
+	int32_t  reqsize;    /**< Request size of this class in blocks */
+	int32_t  weight;     /**< Relative weight of this class within the distribution */
+	int64_t  ops;        /**< Number of ops of this size that have completed */
+	int64_t  bytes;      /**< Number of bytes transferred by ops of this size */
+	nclk_t   op_time;    /**< Accumulated op time in nanoseconds for ops of this size */
+};
+typedef struct seek_size_class seek_size_class_t;
+
+#define SO_SEEK_MAX_STREAMS 32 /**< Maximum number of sequential streams */
+
+/** Policies used to pick the stream that supplies the next seek location */
+#define SO_STREAM_POLICY_ROUND_ROBIN 0 /**< Take turns in the order the streams were specified */
+#define SO_STREAM_POLICY_RANDOM      1 /**< Pick any stream with equal probability */
+#define SO_STREAM_POLICY_WEIGHTED    2 /**< Pick a stream in proportion to its weight */
+
+/** A single sequential stream of a multi-stream access pattern */
+struct seek_stream {
+	uint64_t start;      /**< Location of the first op of this stream in blocks */
+	int64_t  stride;     /**< Distance in blocks between ops of this stream, 0 means the request size */
+	int32_t  direction;  /**< 1 for ascending or -1 for descending locations */
+	int32_t  weight;     /**< Relative weight used by the weighted policy */
+	uint64_t next_location; /**< Location of the next op of this stream in blocks */
+};
+typedef struct seek_stream seek_stream_t;
+
+/** Orders in which the extents of a file are walked */
+#define SO_EXTENT_ORDER_PHYSICAL 0 /**< Extents in ascending physical (device) address */
+#define SO_EXTENT_ORDER_LOGICAL  1 /**< Extents one after the other in file offset order */
+
+/** A single extent of a file as reported by the file system */
+struct seek_extent {
+	uint64_t logical;    /**< Offset of this extent within the file in bytes */
+	uint64_t physical;   /**< Physical address of this extent on the device in bytes */
+	uint64_t length;     /**< Length of this extent in bytes */
+	uint32_t flags;      /**< Extent flags reported by the file system */
+	int64_t  ops;        /**< Number of ops that started in this extent */
+	int64_t  bytes;      /**< Number of bytes transferred by ops that started in this extent */
+	nclk_t   op_time;    /**< Accumulated op time in nanoseconds for ops that started in this extent */
+};
+typedef struct seek_extent seek_extent_t;
 
 /** The seek header contains all the information regarding seek locations */
 struct seekhdr {
@@ -52,6 +103,17 @@ struct seekhdr {
 	char  *seek_loadfile; /**< file from which to load seek locations from */
 	char  *seek_pattern; /**< The seek pattern used for this target */
 	seek_t  *seeks;  /**< the seek list */
+	int32_t  seek_num_size_classes; /**< Number of classes in the request size distribution */
+	seek_size_class_t seek_size_classes[SO_SEEK_MAX_SIZE_CLASSES]; /**< The request size distribution */
+	int32_t  seek_num_streams; /**< Number of sequential streams */
+	int32_t  seek_stream_policy; /**< How the next stream is picked - one of SO_STREAM_POLICY_* */
+	seek_stream_t seek_streams[SO_SEEK_MAX_STREAMS]; /**< The sequential streams */
+	int32_t  seek_extent_order; /**< How the extents are walked - one of SO_EXTENT_ORDER_* */
+	uint64_t seek_extent_region_start; /**< Only use extents at or above this physical address in bytes */
+	uint64_t seek_extent_region_end; /**< Only use extents below this physical address in bytes, 0 means no limit */
+	int32_t  seek_num_extents; /**< Number of extents in seek_extents */
+	int32_t  seek_extent_discontiguities; /**< Number of times the file jumps to a new physical location */
+	seek_extent_t *seek_extents; /**< The extents of the file in the order they are walked */
 	char state[256];
 	char *oldstate;
 };
@@ -328,7 +328,7 @@ xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
 		((target_data_t *)(occupantp->occupant_data))->td_current_barrier = bp;
 	} else if (occupantp->occupant_type & XDD_OCCUPANT_TYPE_WORKER_THREAD) {
 		// Put the barrier pointer into this thread's Worker_Data->current_barrier
-		((worker_data_t *)(occupantp->occupant_data))->wd_current_state |= WORKER_CURRENT_STATE_BARRIER;
+		xdd_worker_state_enter((worker_data_t *)(occupantp->occupant_data), WORKER_CURRENT_STATE_BARRIER);
 		((worker_data_t *)(occupantp->occupant_data))->wd_current_barrier = bp;
 	}
 	
@@ -365,7 +365,7 @@ xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner) {
 	} else if (occupantp->occupant_type & XDD_OCCUPANT_TYPE_WORKER_THREAD) {
 		// Put the barrier pointer into this thread's Worker_Data->current_barrier
 		((worker_data_t *)(occupantp->occupant_data))->wd_current_barrier = NULL;
-		((worker_data_t *)(occupantp->occupant_data))->wd_current_state &= ~WORKER_CURRENT_STATE_BARRIER;
+		xdd_worker_state_leave((worker_data_t *)(occupantp->occupant_data), WORKER_CURRENT_STATE_BARRIER);
 	}
 	// Clear this occupant chain if we are the owner of this barrier
 	if (owner) {
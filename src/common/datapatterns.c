@@ -39,16 +39,21 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
     unsigned char    *ucp;          // Pointer to an unsigned char type, duhhhh
     uint32_t *lp;			// pointer to a pattern
     xint_data_pattern_t	*dpp;
+    int32_t xfer_size;		// Number of bytes in the buffer to initialize
 
 
 	tdp = wdp->wd_tdp;
     dpp = tdp->td_dpp;
+	// When request sizes vary the pattern has to cover the largest request
+	xfer_size = tdp->td_xfer_size;
+	if ((tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) && (tdp->td_seekhdr.seek_iosize > (uint32_t)xfer_size))
+		xfer_size = tdp->td_seekhdr.seek_iosize;
     if (dpp->data_pattern_options & DP_RANDOM_PATTERN) { // A nice random pattern
 		lp = (uint32_t *)wdp->wd_task.task_datap;
 		xgp->random_initialized = 0;
 		xgp->random_init_seed = 72058; // Backward compatibility with older xdd versions
 		/* Set each four-byte field in the I/O buffer to a random integer */
-		for(i = 0; i < (int32_t)(tdp->td_xfer_size / sizeof(int32_t)); i++ ) {
+		for(i = 0; i < (int32_t)(xfer_size / sizeof(int32_t)); i++ ) {
 	    	*lp=xdd_random_int();
 	    	lp++;
 		}
@@ -57,17 +62,17 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 		xgp->random_initialized = 0;
 		xgp->random_init_seed = (tdp->td_target_number+1); 
 		/* Set each four-byte field in the I/O buffer to a random integer */
-		for(i = 0; i < (int32_t)(tdp->td_xfer_size / sizeof(int32_t)); i++ ) {
+		for(i = 0; i < (int32_t)(xfer_size / sizeof(int32_t)); i++ ) {
 	    	*lp=xdd_random_int();
 	    	lp++;
 		}
     } else if ((dpp->data_pattern_options & DP_ASCII_PATTERN) ||
 	     (dpp->data_pattern_options & DP_HEX_PATTERN)) { // put the pattern that is in the pattern buffer into the io buffer
 		// Clear out the buffer before putting in the string so there are no strange characters in it.
-		memset(wdp->wd_task.task_datap,'\0',tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,'\0',xfer_size);
 		if (dpp->data_pattern_options & DP_REPLICATE_PATTERN) { // Replicate the pattern throughout the buffer
 	    	ucp = (unsigned char *)wdp->wd_task.task_datap;
-	    	remaining_length = tdp->td_xfer_size;
+	    	remaining_length = xfer_size;
 	    	while (remaining_length) { 
 				if (dpp->data_pattern_length < remaining_length) 
 		    		pattern_length = dpp->data_pattern_length;
@@ -78,17 +83,17 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 				ucp += pattern_length;
 	    	}
 		} else { // Just put the pattern at the beginning of the buffer once 
-	    	if (dpp->data_pattern_length < (size_t)tdp->td_xfer_size) 
+	    	if (dpp->data_pattern_length < (size_t)xfer_size) 
 				pattern_length = dpp->data_pattern_length;
-	    	else pattern_length = tdp->td_xfer_size;
+	    	else pattern_length = xfer_size;
 	    	memcpy(wdp->wd_task.task_datap,dpp->data_pattern,pattern_length);
 		}
     } else if (dpp->data_pattern_options & DP_LFPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
 		dpp->data_pattern_length = sizeof(lfpat);
 		fprintf(stderr,"LFPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
+		remaining_length = xfer_size;
 		ucp = (unsigned char *)wdp->wd_task.task_datap;
 		while (remaining_length) { 
 	    	if (dpp->data_pattern_length < remaining_length) 
@@ -99,11 +104,11 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	    	ucp += pattern_length;
 		}
     } else if (dpp->data_pattern_options & DP_LTPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
 		dpp->data_pattern_length = sizeof(ltpat);
 		fprintf(stderr,"LTPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
+		remaining_length = xfer_size;
 		ucp = (unsigned char *)wdp->wd_task.task_datap;
 		while (remaining_length) { 
 	    	if (dpp->data_pattern_length < remaining_length) 
@@ -114,11 +119,11 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	    	ucp += pattern_length;
 		}
     } else if (dpp->data_pattern_options & DP_CJTPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
 		dpp->data_pattern_length = sizeof(cjtpat);
 		fprintf(stderr,"CJTPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
+		remaining_length = xfer_size;
 		ucp = (unsigned char *)wdp->wd_task.task_datap;
 		while (remaining_length) { 
 	    	if (dpp->data_pattern_length < remaining_length) 
@@ -129,11 +134,11 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	    	ucp += pattern_length;
 		}
     } else if (dpp->data_pattern_options & DP_CRPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
 		dpp->data_pattern_length = sizeof(crpat);
 		fprintf(stderr,"CRPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
+		remaining_length = xfer_size;
 		ucp = (unsigned char *)wdp->wd_task.task_datap;
 		while (remaining_length) { 
 	    	if (dpp->data_pattern_length < remaining_length) 
@@ -144,11 +149,11 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	    	ucp += pattern_length;
 		}
     } else if (dpp->data_pattern_options & DP_CSPAT_PATTERN) {
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
 		dpp->data_pattern_length = sizeof(cspat);
 		fprintf(stderr,"CSPAT length is %d\n", (int)dpp->data_pattern_length);
-		memset(wdp->wd_task.task_datap,0x00,tdp->td_xfer_size);
-		remaining_length = tdp->td_xfer_size;
+		memset(wdp->wd_task.task_datap,0x00,xfer_size);
+		remaining_length = xfer_size;
 		ucp = (unsigned char *)wdp->wd_task.task_datap;
 		while (remaining_length) { 
 	    	if (dpp->data_pattern_length < remaining_length) 
@@ -158,42 +163,341 @@ xdd_datapattern_buffer_init(worker_data_t *wdp) {
 	    	remaining_length -= pattern_length;
 	    	ucp += pattern_length;
 		}
+    } else if (dpp->data_pattern_options & DP_RANDOM_BY_OFFSET_PATTERN) { 
+		// Nothing to do here - xdd_datapattern_fill() makes the data of each op from its byte offset
     } else { // Otherwise set the entire buffer to the character in "dpp->data_pattern"
-		memset(wdp->wd_task.task_datap,*(dpp->data_pattern),tdp->td_xfer_size);
+		memset(wdp->wd_task.task_datap,*(dpp->data_pattern),xfer_size);
    	}
 		
     return;
 } // end of xdd_datapattern_buffer_init()
+/*----------------------------------------------------------------------------*/
+/* Sequenced data pattern fill kernels
+ * Each 8-byte word of the buffer gets its own byte offset in the target OR'd
+ * with the pattern prefix and XOR'd with the inverse mask (0 or all ones).
+ * The x86 kernels are compiled with the target attribute so that the rest of
+ * xdd does not need AVX, and are only used when the CPU reports the feature.
+ */
+typedef void (*xdd_sequenced_fill_t)(uint64_t *posp, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse);
+
+static void
+xdd_sequenced_fill_scalar(uint64_t *posp, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse) {
+	size_t	j;
+
+	for (j = 0; j + 4 <= words; j += 4) {
+		posp[j]   = ((offset     ) | prefix) ^ inverse;
+		posp[j+1] = ((offset +  8) | prefix) ^ inverse;
+		posp[j+2] = ((offset + 16) | prefix) ^ inverse;
+		posp[j+3] = ((offset + 24) | prefix) ^ inverse;
+		offset += 32;
+	}
+	for (; j < words; j++) {
+		posp[j] = (offset | prefix) ^ inverse;
+		offset += 8;
+	}
+} // End of xdd_sequenced_fill_scalar()
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9)))
+#define XDD_FILL_X86
+#include <immintrin.h>
+
+__attribute__((target("avx2"))) static void
+xdd_sequenced_fill_avx2(uint64_t *posp, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse) {
+	__m256i	pos0, pos1, step, pfx, inv;
+	size_t	j;
+
+	pos0 = _mm256_set_epi64x(offset + 24, offset + 16, offset + 8, offset);
+	pos1 = _mm256_add_epi64(pos0, _mm256_set1_epi64x(32));
+	step = _mm256_set1_epi64x(64);
+	pfx = _mm256_set1_epi64x(prefix);
+	inv = _mm256_set1_epi64x(inverse);
+	for (j = 0; j + 8 <= words; j += 8) {
+		_mm256_storeu_si256((__m256i *)&posp[j], _mm256_xor_si256(_mm256_or_si256(pos0, pfx), inv));
+		_mm256_storeu_si256((__m256i *)&posp[j+4], _mm256_xor_si256(_mm256_or_si256(pos1, pfx), inv));
+		pos0 = _mm256_add_epi64(pos0, step);
+		pos1 = _mm256_add_epi64(pos1, step);
+	}
+	if (j < words)
+		xdd_sequenced_fill_scalar(&posp[j], words - j, offset + (j * 8), prefix, inverse);
+} // End of xdd_sequenced_fill_avx2()
+
+__attribute__((target("avx512f"))) static void
+xdd_sequenced_fill_avx512(uint64_t *posp, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse) {
+	__m512i	pos0, pos1, step, pfx, inv;
+	size_t	j;
+
+	pos0 = _mm512_set_epi64(offset + 56, offset + 48, offset + 40, offset + 32, offset + 24, offset + 16, offset + 8, offset);
+	pos1 = _mm512_add_epi64(pos0, _mm512_set1_epi64(64));
+	step = _mm512_set1_epi64(128);
+	pfx = _mm512_set1_epi64(prefix);
+	inv = _mm512_set1_epi64(inverse);
+	for (j = 0; j + 16 <= words; j += 16) {
+		_mm512_storeu_si512((void *)&posp[j], _mm512_xor_si512(_mm512_or_si512(pos0, pfx), inv));
+		_mm512_storeu_si512((void *)&posp[j+8], _mm512_xor_si512(_mm512_or_si512(pos1, pfx), inv));
+		pos0 = _mm512_add_epi64(pos0, step);
+		pos1 = _mm512_add_epi64(pos1, step);
+	}
+	if (j < words)
+		xdd_sequenced_fill_scalar(&posp[j], words - j, offset + (j * 8), prefix, inverse);
+} // End of xdd_sequenced_fill_avx512()
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define XDD_FILL_NEON
+#include <arm_neon.h>
+
+static void
+xdd_sequenced_fill_neon(uint64_t *posp, size_t words, uint64_t offset, uint64_t prefix, uint64_t inverse) {
+	uint64x2_t	pos0, pos1, step, pfx, inv;
+	uint64_t	init[2];
+	size_t		j;
+
+	init[0] = offset;
+	init[1] = offset + 8;
+	pos0 = vld1q_u64(init);
+	pos1 = vaddq_u64(pos0, vdupq_n_u64(16));
+	step = vdupq_n_u64(32);
+	pfx = vdupq_n_u64(prefix);
+	inv = vdupq_n_u64(inverse);
+	for (j = 0; j + 4 <= words; j += 4) {
+		vst1q_u64(&posp[j], veorq_u64(vorrq_u64(pos0, pfx), inv));
+		vst1q_u64(&posp[j+2], veorq_u64(vorrq_u64(pos1, pfx), inv));
+		pos0 = vaddq_u64(pos0, step);
+		pos1 = vaddq_u64(pos1, step);
+	}
+	if (j < words)
+		xdd_sequenced_fill_scalar(&posp[j], words - j, offset + (j * 8), prefix, inverse);
+} // End of xdd_sequenced_fill_neon()
+#endif
+
+static xdd_sequenced_fill_t	xdd_sequenced_fill = xdd_sequenced_fill_scalar;
+static pthread_once_t		xdd_sequenced_fill_once = PTHREAD_ONCE_INIT;
+
+/*----------------------------------------------------------------------------*/
+/* xdd_sequenced_fill_select() - Pick the widest fill kernel this CPU can run.
+ * Called once through pthread_once() by the first Worker Thread that fills 
+ * a buffer.
+ */
+static void
+xdd_sequenced_fill_select(void) {
+#if defined(XDD_FILL_X86)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f"))
+		xdd_sequenced_fill = xdd_sequenced_fill_avx512;
+	else if (__builtin_cpu_supports("avx2"))
+		xdd_sequenced_fill = xdd_sequenced_fill_avx2;
+#elif defined(XDD_FILL_NEON)
+	xdd_sequenced_fill = xdd_sequenced_fill_neon;
+#endif
+} // End of xdd_sequenced_fill_select()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_offset_duplicate() - Decide whether a chunk of the random by
+ * offset data pattern is a duplicate. The first chunk of each group of
+ * DP_DEDUPE_GROUP_CHUNKS chunks never is so that every duplicate has an
+ * earlier chunk in its group to repeat.
+ */
+static int
+xdd_random_offset_duplicate(xint_data_pattern_t *dpp, uint64_t key, uint64_t chunk) {
+	uint64_t	h;					// Hash that decides if a chunk is a duplicate
+
+
+	if ((chunk % DP_DEDUPE_GROUP_CHUNKS) == 0)
+		return(0);
+	h = xdd_random_offset_word(~key, chunk << 3);
+	return(((double)(h >> 11) * (1.0 / 9007199254740992.0)) < dpp->data_pattern_dedupe_ratio); // 53 bits of h as a fraction
+} // End of xdd_random_offset_duplicate()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_offset_source_chunk() - Return the chunk whose data a chunk of
+ * the random by offset data pattern holds. That is the chunk itself unless
+ * it is a duplicate. A duplicate picks an earlier chunk of its group and 
+ * walks back from there to the nearest chunk that is not a duplicate, so 
+ * every duplicate repeats data that is already in the target and the share
+ * of duplicate chunks is the dedupe ratio whatever the size of the target.
+ */
+static uint64_t
+xdd_random_offset_source_chunk(xint_data_pattern_t *dpp, uint64_t key, uint64_t chunk) {
+	uint64_t	first;				// First chunk of the group of this chunk
+
+
+	if (!xdd_random_offset_duplicate(dpp, key, chunk))
+		return(chunk);
+	first = chunk - (chunk % DP_DEDUPE_GROUP_CHUNKS);
+	chunk = first + (xdd_random_offset_word(~key, (chunk << 3) + 4) % (chunk - first));
+	while (xdd_random_offset_duplicate(dpp, key, chunk))
+		chunk--;
+	return(chunk);
+} // End of xdd_random_offset_source_chunk()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_offset_fill() - Put the random by offset data pattern for
+ * the specified byte offset of the target into a buffer of "words" 8-byte words. 
+ * The data is made one chunk of DP_CHUNK_SIZE bytes at a time:
+ *   - The first DP_CHUNK_SIZE/compress_ratio bytes of a chunk are random and
+ *     the rest of the chunk is zero so that a compressor gets about the 
+ *     requested ratio.
+ *   - A chunk is a duplicate with a probability of the dedupe ratio. A duplicate
+ *     chunk gets the data of an earlier chunk - see xdd_random_offset_source_chunk().
+ * Both decisions depend only on the key and the chunk number so the verify
+ * routine can make the same data again with this same subroutine. 
+ * Without a compress or dedupe ratio every word is xdd_random_offset_word() 
+ * of its own byte offset.
+ * The byte offset has to be a multiple of 8 - xdd_random_offset_fill_bytes()
+ * takes care of any other byte offset or size.
+ */
+void
+xdd_random_offset_fill(xint_data_pattern_t *dpp, uint64_t key, uint64_t *bufp, uint64_t byte_offset, size_t words) {
+	uint64_t	chunk;				// Chunk number of the current word
+	uint64_t	in_chunk;			// Byte offset of the current word in its chunk
+	uint64_t	base;				// Byte offset the data of this chunk is made from
+	uint64_t	random_bytes;		// Number of random bytes at the start of every chunk
+	uint64_t	offset;
+	size_t		j, n;
+
+
+	random_bytes = DP_CHUNK_SIZE;
+	if (dpp->data_pattern_compress_ratio > 1.0) {
+		random_bytes = (uint64_t)(DP_CHUNK_SIZE / dpp->data_pattern_compress_ratio);
+		random_bytes = (random_bytes + sizeof(uint64_t) - 1) & ~(uint64_t)(sizeof(uint64_t) - 1);
+	}
+	while (words > 0) {
+		chunk = byte_offset / DP_CHUNK_SIZE;
+		in_chunk = byte_offset % DP_CHUNK_SIZE;
+		n = (DP_CHUNK_SIZE - in_chunk) / sizeof(uint64_t);
+		if (n > words) 
+			n = words;
+		base = chunk * DP_CHUNK_SIZE;
+		if (dpp->data_pattern_dedupe_ratio > 0.0)
+			base = xdd_random_offset_source_chunk(dpp, key, chunk) * DP_CHUNK_SIZE;
+		for (j = 0; j < n; j++) {
+			offset = in_chunk + (j * sizeof(uint64_t));
+			bufp[j] = (offset < random_bytes) ? xdd_random_offset_word(key, base + offset) : 0;
+		}
+		bufp += n;
+		words -= n;
+		byte_offset += n * sizeof(uint64_t);
+	}
+} // End of xdd_random_offset_fill()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_offset_fill_bytes() - Put the random by offset data pattern for
+ * the specified byte offset of the target into a buffer of "bytes" bytes.
+ * Neither the byte offset nor the size has to be a multiple of 8 bytes: the
+ * byte at byte offset N of the target is always byte N%8 of the word that
+ * xdd_random_offset_fill() makes for byte offset N-(N%8), so a partial word
+ * at either end of the buffer is cut from its whole word. The whole words 
+ * in between go straight into the buffer when it is word aligned.
+ */
+void
+xdd_random_offset_fill_bytes(xint_data_pattern_t *dpp, uint64_t key, unsigned char *bufp, uint64_t byte_offset, size_t bytes) {
+	uint64_t	line[64];			// Words made for an unaligned buffer
+	size_t		skip;				// Bytes of the first word that come before the buffer
+	size_t		n, m, words;
+
+
+	skip = byte_offset % sizeof(uint64_t);
+	if (skip && bytes) {
+		// A partial word at the start
+		xdd_random_offset_fill(dpp, key, line, byte_offset - skip, 1);
+		n = sizeof(uint64_t) - skip;
+		if (n > bytes)
+			n = bytes;
+		memcpy(bufp, (unsigned char *)line + skip, n);
+		bufp += n;
+		bytes -= n;
+		byte_offset += n;
+	}
+	words = bytes / sizeof(uint64_t);
+	if (((uintptr_t)bufp % sizeof(uint64_t)) == 0) {
+		xdd_random_offset_fill(dpp, key, (uint64_t *)bufp, byte_offset, words);
+	} else {
+		for (n = 0; n < words; n += m) {
+			m = words - n;
+			if (m > 64)
+				m = 64;
+			xdd_random_offset_fill(dpp, key, line, byte_offset + (n * sizeof(uint64_t)), m);
+			memcpy(bufp + (n * sizeof(uint64_t)), line, m * sizeof(uint64_t));
+		}
+	}
+	bufp += words * sizeof(uint64_t);
+	bytes -= words * sizeof(uint64_t);
+	byte_offset += words * sizeof(uint64_t);
+	if (bytes) {
+		// A partial word at the end
+		xdd_random_offset_fill(dpp, key, line, byte_offset, 1);
+		memcpy(bufp, line, bytes);
+	}
+} // End of xdd_random_offset_fill_bytes()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_datapattern_fill_buffer() - Fill "xfer_size" bytes of a buffer with the
+ * data of a data pattern that changes from op to op for the specified byte 
+ * offset. This is used by xdd_datapattern_fill() and by the prefill thread.
+ */
+void
+xdd_datapattern_fill_buffer(target_data_t *tdp, unsigned char *bufp, uint64_t byte_offset, size_t xfer_size) {
+	uint64_t		inverse;			// XOR mask - all ones for an inverse pattern
+	uint64_t		key;				// Key of the random by offset pattern
+	uint64_t		word;				// Pattern word of a partial word at the end of the buffer
+	size_t			words;				// Number of whole words in the buffer
+
+
+	/* Sequenced Data Pattern */
+	if (tdp->td_dpp->data_pattern_options & DP_SEQUENCED_PATTERN) {
+		pthread_once(&xdd_sequenced_fill_once, xdd_sequenced_fill_select);
+		inverse = (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN) ? 0xffffffffffffffffULL : 0; // 1's compliment of the pattern
+		words = xfer_size / sizeof(uint64_t);
+		xdd_sequenced_fill((uint64_t *)bufp,
+			words,
+			byte_offset,
+			tdp->td_dpp->data_pattern_prefix_binary,
+			inverse);
+		// Finish a partial word at the end of the buffer a byte at a time
+		if (xfer_size % sizeof(uint64_t)) {
+			word = ((byte_offset + (words * sizeof(uint64_t))) | tdp->td_dpp->data_pattern_prefix_binary) ^ inverse;
+			memcpy(bufp + (words * sizeof(uint64_t)), &word, xfer_size % sizeof(uint64_t));
+		}
+	} else if (tdp->td_dpp->data_pattern_options & DP_RANDOM_BY_OFFSET_PATTERN) {
+		/* Random data keyed by seed, target, and byte offset */
+		key = xdd_random_offset_key(tdp->td_dpp->data_pattern_seed, tdp->td_target_number);
+		xdd_random_offset_fill_bytes(tdp->td_dpp, key, bufp, byte_offset, xfer_size);
+	}
+} // End of xdd_datapattern_fill_buffer() 
+
 /*----------------------------------------------------------------------------*/
 /* xdd_datapattern_fill() - This subroutine will fill the buffer with a 
  * specific pattern. 
  * This routine is called within the inner I/O loop for every I/O if the data
- * pattern changes from IO to IO
+ * pattern changes from IO to IO. Only the bytes of the current task are 
+ * filled. The time spent is handed to xdd_worker_thread_update_target_counters()
+ * through the counters of the Worker Thread.
+ * With -prefill the buffer normally comes already filled from the prefill ring.
  */
 void
 xdd_datapattern_fill(worker_data_t *wdp) {
 	target_data_t	*tdp;
-	size_t  		j;					// random variables 
-	uint64_t 		*posp;             	// Position Pointer 
 	nclk_t			start_time;			// Used for calculating elapsed times of ops
 	nclk_t			end_time;			// Used for calculating elapsed times of ops
 
 
 	tdp = wdp->wd_tdp;
-	/* Sequenced Data Pattern */
-	if (tdp->td_dpp->data_pattern_options & DP_SEQUENCED_PATTERN) {
+	// A buffer traded in by -verifythreads holds the data of a read - put the pattern back
+	if (wdp->wd_buf_pattern_stale) {
+		wdp->wd_buf_pattern_stale = 0;
 		nclk_now(&start_time);
-		posp = (uint64_t *)wdp->wd_task.task_datap;
-		for (j=0; j<(tdp->td_xfer_size/sizeof(wdp->wd_task.task_byte_offset)); j++) {
-			*posp = wdp->wd_task.task_byte_offset + (j * sizeof(wdp->wd_task.task_byte_offset));
-			*posp |= tdp->td_dpp->data_pattern_prefix_binary;
-			if (tdp->td_dpp->data_pattern_options & DP_INVERSE_PATTERN)
-				*posp ^= 0xffffffffffffffffLL; // 1's compliment of the pattern
-			posp++;
-		}
+		xdd_datapattern_buffer_init(wdp);
 		nclk_now(&end_time);
-// FIXME ????		wdp->wd_accumulated_pattern_fill_time = (end_time - start_time);
+		wdp->wd_counters.tc_current_pattern_fill_time += (end_time - start_time);
 	}
+	if (!(tdp->td_dpp->data_pattern_options & (DP_SEQUENCED_PATTERN | DP_RANDOM_BY_OFFSET_PATTERN)))
+		return;
+	if (tdp->td_pfp && (xdd_prefill_take(wdp) == 0))
+		return;
+	nclk_now(&start_time);
+	xdd_datapattern_fill_buffer(tdp, wdp->wd_task.task_datap, (uint64_t)wdp->wd_task.task_byte_offset, wdp->wd_task.task_xfer_size);
+	nclk_now(&end_time);
+	wdp->wd_counters.tc_current_pattern_fill_time += (end_time - start_time);
 } // End of xdd_datapattern_fill() 
 
  
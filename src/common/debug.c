@@ -441,6 +441,8 @@ xdd_show_e2e_header(xdd_e2e_header_t *e2ehp) {
     fprintf(stderr,"\t\txdd_show_e2e_header: nclk_t     e2eh_recv_time=%lld\n",(unsigned long long int)e2ehp->e2eh_recv_time);             // Time this packet was received in global nano seconds
     fprintf(stderr,"\t\txdd_show_e2e_header: int64_t    e2eh_byte_offset=%lld\n",(long long int)e2ehp->e2eh_byte_offset);           // Offset relative to the beginning of the file of where this data belongs
     fprintf(stderr,"\t\txdd_show_e2e_header: int64_t    e2eh_data_length=%lld\n",(long long int)e2ehp->e2eh_data_length);           // Length of the user data in bytes for this operation
+    fprintf(stderr,"\t\txdd_show_e2e_header: uint32_t   e2eh_flags=0x%08x\n",e2ehp->e2eh_flags);                 // XDD_E2E_FLAG_* bits
+    fprintf(stderr,"\t\txdd_show_e2e_header: uint32_t   e2eh_data_crc=0x%08x\n",e2ehp->e2eh_data_crc);           // CRC32C of the user data
     fprintf(stderr,"\txdd_show_e2e_header:********* End of E2E Header Data at 0x%p **********\n",e2ehp);
 
 } // End of xdd_show_e2e_header()
@@ -525,6 +527,8 @@ xdd_show_ts_table(xint_timestamp_t *ts_tablep, int target_number) {
 #define TS_TRIGOP             0x00000800 /**< Time stamp trigger operation number */
 #define TS_TRIGGERED          0x00001000 /**< Time stamping has been triggered */
 #define TS_SUPPRESS_OUTPUT    0x00002000 /**< Suppress timestamp output */
+#define TS_STREAM             0x00004000 /**< Stream the time stamp entries to the dump file during the run */
+#define TS_COMPACT            0x00008000 /**< Write the dump file in the compact format */
 #define DEFAULT_TS_OPTIONS 0x00000000
 	option_string[0]='\0';
 	if (ts_tablep->ts_options & TS_NORMALIZE)
@@ -555,6 +559,10 @@ xdd_show_ts_table(xint_timestamp_t *ts_tablep, int target_number) {
 		strcat(option_string,"TS_TRIGGERED ");
 	if (ts_tablep->ts_options & TS_SUPPRESS_OUTPUT)
 		strcat(option_string,"TS_SUPPRESS_OUTPUT ");
+	if (ts_tablep->ts_options & TS_STREAM)
+		strcat(option_string,"TS_STREAM ");
+	if (ts_tablep->ts_options & TS_COMPACT)
+		strcat(option_string,"TS_COMPACT ");
 	fprintf(stderr,"xdd_show_ts_table: uint64_t        ts_options=0x%016llx: '%s'\n",(unsigned long long int)ts_tablep->ts_options,option_string); // Time Stamping Options 
 	fprintf(stderr,"xdd_show_ts_table: int64_t         ts_current_entry=%lld\n",(long long int)ts_tablep->ts_current_entry); 		// Index into the Timestamp Table of the current entry
 	fprintf(stderr,"xdd_show_ts_table: int64_t         ts_size=%lld\n",(long long int)ts_tablep->ts_size);  						// Time Stamping Size in number of entries 
@@ -17,7 +17,7 @@
  *
  * +----//----------------------+----------------------------------------+
  * |             |  E2E Header  |   Data ---- N bytes ----               |
- * |             |<--64 bytes-->|<< Start of data buffer is Page Aligned |
+ * |             |<--72 bytes-->|<< Start of data buffer is Page Aligned |
  * |<---//----PAGE_SIZE bytes-->|                                        |
  * +----//----------------------+----------------------------------------+
  *
@@ -40,6 +40,8 @@ struct xdd_e2e_header {
 	nclk_t  	e2eh_recv_time; 			// Time this packet was received in global nano seconds 
 	int64_t  	e2eh_byte_offset; 			// Offset relative to the beginning of the file of where this data belongs
 	int64_t  	e2eh_data_length; 			// Length of the user data in bytes for this operation 
+	uint32_t 	e2eh_flags; 				// XDD_E2E_FLAG_* bits
+	uint32_t 	e2eh_data_crc; 				// CRC32C of the user data if XDD_E2E_FLAG_CRC is set
 };
 typedef struct xdd_e2e_header xdd_e2e_header_t;
 
@@ -115,6 +117,10 @@ struct xint_e2e {
 	int32_t				e2e_recv_status; 		// Current Recv status
 #define XDD_E2E_DATA_READY 	0xDADADADA 			// The magic number that should appear at the beginning of each message indicating data is present
 #define XDD_E2E_EOF 	0xE0F0E0F0 				// The magic number that should appear in a message signaling and End of File
+#define XDD_E2E_HOLE 	0x401E401E 				// The magic number of a header-only message describing a hole in a sparse source file
+#define XDD_E2E_RESEND 	0x5E5D5E5D 				// The magic number of a message from the destination asking for the data of a message to be sent again
+#define XDD_E2E_FLAG_CRC 		0x00000001 		// The data of this message has a CRC32C in e2eh_data_crc - the destination will ask for it again if it does not match
+#define XDD_E2E_FLAG_RESENT 	0x00000002 		// This message is the answer to an XDD_E2E_RESEND
 	int64_t				e2e_msg_sequence_number;// The Message Sequence Number of the most recent message sent or to be received
 	int32_t				e2e_msg_sent; 			// The number of messages sent 
 	int32_t				e2e_msg_recv; 			// The number of messages received 
@@ -129,6 +135,11 @@ struct xint_e2e {
 	nclk_t				e2e_first_packet_received_this_run;// Time that the first packet was received by the destination from the source
 	nclk_t				e2e_last_packet_received_this_run;// Time that the last packet was received by the destination from the source
 	nclk_t				e2e_sr_time; 			// Time spent sending or receiving data for End-to-End operation
+	sd_t				e2e_last_csd; 			// The client socket descriptor the most recent message was received on - replies go back on it
+	int32_t				e2e_resends_outstanding;// Number of messages this destination Worker Thread asked to be sent again and has not yet received
+	int64_t				e2e_crc_msgs; 			// Number of messages whose data CRC32C was checked - kept in the E2E struct of the Target
+	int64_t				e2e_crc_errors; 		// Number of messages whose data did not match their CRC32C
+	int64_t				e2e_resends; 			// Number of messages sent again - asked for by the destination or sent by the source
 	int32_t				e2e_address_table_host_count;	// Cumulative number of hosts represented in the e2e address table
 	int32_t				e2e_address_table_port_count;	// Cumulative number of ports represented in the e2e address table
 	int32_t				e2e_address_table_next_entry;	// Next available entry in the e2e_address_table
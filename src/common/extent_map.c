@@ -0,0 +1,223 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that read the extent map of a target
+ * file so that the seek list can follow the physical layout of the file.
+ */
+#include "xint.h"
+#if defined LINUX
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#include <linux/fiemap.h>
+#endif
+
+#define XDD_FIEMAP_BATCH 256 /* Number of extents requested from the file system at a time */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_extent_compare_physical() - qsort() helper that orders extents by
+ * their physical address.
+ */
+static int
+xdd_extent_compare_physical(const void *a, const void *b) {
+	const seek_extent_t *ea = (const seek_extent_t *)a;
+	const seek_extent_t *eb = (const seek_extent_t *)b;
+
+	if (ea->physical < eb->physical) return(-1);
+	if (ea->physical > eb->physical) return(1);
+	return(0);
+} /* end of xdd_extent_compare_physical() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_extent_map_read() - get the extents of the target file from the file
+ * system with the FIEMAP ioctl. The extents come back in file offset order.
+ * Unwritten and delayed allocation extents are left out.
+ * Return value is the number of extents or -1 if the map cannot be read.
+ */
+static int32_t
+xdd_extent_map_read(target_data_t *tdp) {
+#if defined LINUX
+	struct fiemap	*fmp;		/* FIEMAP request and reply */
+	struct fiemap_extent *fep;	/* Current extent of the reply */
+	seekhdr_t		*sp;		/* Seek header of this target */
+	seek_extent_t	*ep;		/* Extents of the file */
+	int32_t			allocated;	/* Number of entries allocated in ep */
+	int32_t			n;			/* Number of extents so far */
+	uint32_t		i;
+	uint64_t		start;		/* File offset to ask for next */
+	int				done;
+
+
+	sp = &tdp->td_seekhdr;
+	fmp = (struct fiemap *)malloc(sizeof(struct fiemap) + (XDD_FIEMAP_BATCH * sizeof(struct fiemap_extent)));
+	if (fmp == NULL) {
+		fprintf(xgp->errout,"%s: xdd_extent_map_read: ERROR: Cannot allocate memory for the extent map of target %d\n",
+			xgp->progname, tdp->td_target_number);
+		return(-1);
+	}
+	ep = NULL;
+	allocated = 0;
+	n = 0;
+	start = 0;
+	done = 0;
+	while (!done) {
+		memset(fmp, 0, sizeof(struct fiemap));
+		fmp->fm_start = start;
+		fmp->fm_length = FIEMAP_MAX_OFFSET - start;
+		fmp->fm_flags = FIEMAP_FLAG_SYNC;
+		fmp->fm_extent_count = XDD_FIEMAP_BATCH;
+		if (ioctl(tdp->td_file_desc, FS_IOC_FIEMAP, fmp) < 0) {
+			fprintf(xgp->errout,"%s: xdd_extent_map_read: ERROR: Cannot get the extent map of target %d name '%s'\n",
+				xgp->progname, tdp->td_target_number, tdp->td_target_full_pathname);
+			perror("Reason");
+			free(fmp);
+			free(ep);
+			sp->seek_extents = NULL;
+			return(-1);
+		}
+		if (fmp->fm_mapped_extents == 0)
+			break;
+		if ((n + (int32_t)fmp->fm_mapped_extents) > allocated) {
+			allocated = (allocated == 0) ? XDD_FIEMAP_BATCH : (allocated * 2);
+			while (allocated < (n + (int32_t)fmp->fm_mapped_extents))
+				allocated *= 2;
+			sp->seek_extents = (seek_extent_t *)realloc(ep, allocated * sizeof(seek_extent_t));
+			if (sp->seek_extents == NULL) {
+				fprintf(xgp->errout,"%s: xdd_extent_map_read: ERROR: Cannot allocate memory for %d extents of target %d\n",
+					xgp->progname, allocated, tdp->td_target_number);
+				free(fmp);
+				free(ep);
+				return(-1);
+			}
+			ep = sp->seek_extents;
+		}
+		for (i = 0; i < fmp->fm_mapped_extents; i++) {
+			fep = &fmp->fm_extents[i];
+			if (fep->fe_flags & FIEMAP_EXTENT_LAST)
+				done = 1;
+			/* Unwritten and delayed allocation extents hold no data on the media */
+			if (fep->fe_flags & (FIEMAP_EXTENT_UNWRITTEN | FIEMAP_EXTENT_DELALLOC))
+				continue;
+			memset(&ep[n], 0, sizeof(seek_extent_t));
+			ep[n].logical = fep->fe_logical;
+			ep[n].physical = fep->fe_physical;
+			ep[n].length = fep->fe_length;
+			ep[n].flags = fep->fe_flags;
+			n++;
+		}
+		fep = &fmp->fm_extents[fmp->fm_mapped_extents - 1];
+		start = fep->fe_logical + fep->fe_length;
+	}
+	free(fmp);
+	sp->seek_extents = ep;
+	return(n);
+#else
+	fprintf(xgp->errout,"%s: xdd_extent_map_read: ERROR: Extent maps are not supported on this platform - target %d\n",
+		xgp->progname, tdp->td_target_number);
+	return(-1);
+#endif
+} /* end of xdd_extent_map_read() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_extent_map_init() - Read the extent map of the target file and get it
+ * ready for xdd_init_seek_list() to walk.
+ * The extents are clipped to the physical region given with
+ * "-seek extentregion" and trimmed to whole blocks. The number of places
+ * where the file jumps to a new physical location is counted in file offset
+ * order before the extents are sorted for the physical order.
+ * Return value is the number of usable extents, 0 if there are none,
+ * or -1 if the extent map could not be read.
+ */
+int32_t
+xdd_extent_map_init(target_data_t *tdp) {
+	seekhdr_t		*sp;		/* Seek header of this target */
+	seek_extent_t	*ep;		/* Extents of the file */
+	int32_t			n;			/* Number of extents read */
+	int32_t			i, j;
+	uint64_t		region_end;	/* Upper physical limit in bytes */
+	uint64_t		start, end;	/* Physical range of the clipped extent */
+	uint64_t		skew;		/* Bytes to the next block boundary */
+
+
+	sp = &tdp->td_seekhdr;
+	sp->seek_num_extents = 0;
+	sp->seek_extent_discontiguities = 0;
+	n = xdd_extent_map_read(tdp);
+	if (n <= 0)
+		return(n);
+	ep = sp->seek_extents;
+
+	/* Count the physical discontiguities in file offset order */
+	for (i = 1; i < n; i++)
+		if (ep[i].physical != (ep[i-1].physical + ep[i-1].length))
+			sp->seek_extent_discontiguities++;
+
+	/* Clip each extent to the physical region and to whole blocks */
+	region_end = (sp->seek_extent_region_end > 0) ? sp->seek_extent_region_end : (uint64_t)-1;
+	j = 0;
+	for (i = 0; i < n; i++) {
+		start = (ep[i].physical > sp->seek_extent_region_start) ? ep[i].physical : sp->seek_extent_region_start;
+		end = ((ep[i].physical + ep[i].length) < region_end) ? (ep[i].physical + ep[i].length) : region_end;
+		if (start >= end)
+			continue;
+		ep[j] = ep[i];
+		ep[j].logical += (start - ep[i].physical);
+		ep[j].physical = start;
+		ep[j].length = end - start;
+		skew = (tdp->td_block_size - (ep[j].logical % tdp->td_block_size)) % tdp->td_block_size;
+		if (skew >= ep[j].length)
+			continue;
+		ep[j].logical += skew;
+		ep[j].physical += skew;
+		ep[j].length -= skew;
+		ep[j].length -= (ep[j].length % tdp->td_block_size);
+		if (ep[j].length == 0)
+			continue;
+		j++;
+	}
+	sp->seek_num_extents = j;
+
+	if (sp->seek_extent_order == SO_EXTENT_ORDER_PHYSICAL)
+		qsort(ep, sp->seek_num_extents, sizeof(seek_extent_t), xdd_extent_compare_physical);
+
+	if (xgp->global_options & GO_VERBOSE)
+		fprintf(xgp->output,"%s: Target %d has %d extents, %d physical discontiguities, %d extents in use\n",
+			xgp->progname, tdp->td_target_number, n, sp->seek_extent_discontiguities, sp->seek_num_extents);
+	return(sp->seek_num_extents);
+} /* end of xdd_extent_map_init() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_extent_map_free() - Release the extent map of a target once the run
+ * results that report on each extent have been displayed.
+ */
+void
+xdd_extent_map_free(target_data_t *tdp) {
+	seekhdr_t		*sp;		/* Seek header of this target */
+
+
+	sp = &tdp->td_seekhdr;
+	if (sp->seek_extents)
+		free(sp->seek_extents);
+	sp->seek_extents = NULL;
+	sp->seek_num_extents = 0;
+} /* end of xdd_extent_map_free() */
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -7,9 +7,11 @@ COMMON_SRC := $(DIR)/access_pattern.c \
 	$(DIR)/barrier.c \
 	$(DIR)/datapatterns.c \
 	$(DIR)/debug.c \
+	$(DIR)/extent_map.c \
 	$(DIR)/memory.c \
 	$(DIR)/processor.c \
 	$(DIR)/target_data.c \
 	$(DIR)/timestamp.c \
+	$(DIR)/timestamp_compact.c \
 	$(DIR)/xint_global_data.c \
 	$(DIR)/xint_nclk.c
@@ -40,6 +40,7 @@ typedef struct xdd_func xdd_func_t;
 // Prototypes required by the parse_table() compilation
 int xddfunc_blocksize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_bytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_checksum(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_combinedout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_congestion(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_cookie(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -50,6 +51,7 @@ int xddfunc_debug(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags)
 int xddfunc_deletefile(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_devicefile(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_dio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_dispatchstats(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_dryrun(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_endtoend(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_errout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -58,11 +60,14 @@ int xddfunc_flushwrite(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t f
 int xddfunc_fullhelp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_heartbeat(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_help(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_histogram(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_id(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_interactive(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_json(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_kbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_lockstep(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_looseordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_manifest(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_maxall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_maxerrors(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_max_errors_to_print(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -70,6 +75,7 @@ int xddfunc_maxpri(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 int xddfunc_mbytes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_memalign(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_memory_usage(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_metrics(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_minall(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_multipath(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_nobarrier(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -87,12 +93,14 @@ int xddfunc_passes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags
 int xddfunc_passoffset(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_percentcpu(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_preallocate(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_prefill(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_pretruncate(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_processlock(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_processor(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_queuedepth(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_randomize(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_readafterwrite(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_readbackdelay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_reallyverbose(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_recreatefiles(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_reopen(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -106,12 +114,16 @@ int xddfunc_rwratio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flag
 int xddfunc_seek(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_setup(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_sgio(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_sharedfile(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_sharedmemory(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_shmstats(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_singleproc(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags); 
+int xddfunc_sparse(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_startdelay(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_startoffset(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_starttime(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_starttrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_statetimes(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_stoponerror(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_stoptrigger(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_serialordering(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
@@ -130,9 +142,11 @@ int xddfunc_targetout(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t fl
 int xddfunc_throttle(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_timelimit(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_timerinfo(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
+int xddfunc_timeseries(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_timeserver(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_timestamp(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags); 
 int xddfunc_verify(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags); 
+int xddfunc_verifythreads(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags); 
 int xddfunc_unverbose(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_verbose(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
 int xddfunc_version(xdd_plan_t *planp, int32_t argc, char *argv[], uint32_t flags);
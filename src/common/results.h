@@ -141,6 +141,9 @@ struct results {
 	double		lowest_iops;			// Lowest individual op I/O Operations per second 
 	double		lowest_read_iops;		// Lowest individual op read I/O Operations per second 
 	double		lowest_write_iops;		// Lowest individual op write I/O Operations per second 
+
+	// Latency histograms - Only used when -histogram or a percentile format identifier is specified
+	struct xint_histograms	*hgp;		// Histograms of the op times of this pass or run, NULL if there are none
 }; 
 typedef struct results results_t; 
 
@@ -161,6 +164,12 @@ void xdd_results_fmt_iops(results_t *rp);
 void xdd_results_fmt_read_iops(results_t *rp);
 void xdd_results_fmt_write_iops(results_t *rp);
 void xdd_results_fmt_latency(results_t *rp);
+void xdd_results_fmt_p50_latency(results_t *rp);
+void xdd_results_fmt_p90_latency(results_t *rp);
+void xdd_results_fmt_p99_latency(results_t *rp);
+void xdd_results_fmt_p999_latency(results_t *rp);
+void xdd_results_fmt_p9999_latency(results_t *rp);
+void xdd_results_fmt_max_latency(results_t *rp);
 void xdd_results_fmt_elapsed_time_from_1st_op(results_t *rp);
 void xdd_results_fmt_elapsed_time_from_pass_start(results_t *rp);
 void xdd_results_fmt_elapsed_over_head_time(results_t *rp);
@@ -126,6 +126,9 @@ xdd_init_new_target_data(target_data_t *tdp, int32_t n) {
  */
 void
 xdd_calculate_xfer_info(target_data_t *tdp) {
+	int64_t	xfer_size;	// Average number of bytes per request
+
+
 	// The following calculates the number of I/O requests (numreqs) to issue to a "target"
 	// This value represents the total number of I/O operations that will be performed on this target.
 	/* Now lets get down to business... */
@@ -137,8 +140,16 @@ xdd_calculate_xfer_info(target_data_t *tdp) {
 		tdp->td_target_bytes_to_xfer_per_pass = 0;
 		return;
 	}
+	// With a request size distribution the number of ops is based on the mean request size.
+	// The exact number of bytes per pass is filled in once the seek list has been generated.
+	xfer_size = tdp->td_xfer_size;
+	if (tdp->td_seekhdr.seek_num_size_classes > 0) {
+		xfer_size = xdd_size_distribution_init(tdp);
+		if (xfer_size <= 0) 
+			xfer_size = tdp->td_xfer_size;
+	}
 	if (tdp->td_numreqs) 
-		tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)(tdp->td_numreqs * tdp->td_xfer_size);
+		tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)(tdp->td_numreqs * xfer_size);
 	else if (tdp->td_bytes)
 		tdp->td_target_bytes_to_xfer_per_pass = (uint64_t)tdp->td_bytes;
 	else { // Yikes - something was not specified
@@ -164,12 +175,12 @@ xdd_calculate_xfer_info(target_data_t *tdp) {
 	}
 
 	// This calculates the number of iosize (or smaller) operations that need to be performed. 
-	tdp->td_target_ops = tdp->td_target_bytes_to_xfer_per_pass / tdp->td_xfer_size;
+	tdp->td_target_ops = tdp->td_target_bytes_to_xfer_per_pass / xfer_size;
 
  	// In the event the number of bytes to transfer is not an integer multiple of iosized requests then 
  	// the total number of ops is incremented by 1 and the last I/O op will be the something less than
 	// than the normal iosize.
-	if (tdp->td_target_bytes_to_xfer_per_pass % tdp->td_xfer_size) 
+	if (tdp->td_target_bytes_to_xfer_per_pass % xfer_size) 
 		tdp->td_target_ops++;
 	
 } // End of xdd_calculate_xfer_info()
@@ -310,8 +321,77 @@ xdd_build_target_data_substructure(xdd_plan_t* planp) {
 		} // End of FOR loop that adds all Worker_Datas to a Target_Data linked list
 
 	} // End of FOR loop that builds Worker_Datas for each Target_Data
+
+	// Lay the targets out in a shared file now that the size of each target's pass is known
+	if (planp->plan_options & (PLAN_SHARED_FILE_STRIDED | PLAN_SHARED_FILE_SEGMENTED))
+		xdd_shared_file_layout(planp);
 } /* End of xdd_build_target_data_substructure() */
 
+/*----------------------------------------------------------------------------*/
+/* xdd_shared_file_layout() - set up the target offset so that all the targets
+ * share a single file (N-to-1) the way parallel applications do. 
+ * For a "strided" layout the targets take turns: request i of target t goes to
+ * slot (i * number_of_targets) + t of the file. The target offset becomes one
+ * request and xdd_init_seek_list() leaves a gap of the other targets' requests
+ * between the requests of each target.
+ * For a "segmented" layout each target owns one contiguous segment of the file
+ * that is large enough for the largest pass of any target. 
+ * Any -targetoffset value is replaced.
+ */
+void
+xdd_shared_file_layout(xdd_plan_t *planp) {
+	target_data_t	*tdp;			// Pointer to the current target
+	target_data_t	*tdp0;			// Pointer to target 0
+	int				target_number;	// Current target number
+	uint64_t		extent;			// Bytes one target can touch in a pass
+	uint64_t		segment;		// Size of a segment in bytes
+	int32_t			reqsize_high;	// Largest request size in blocks
+	int				i;				// Size class index
+
+
+	tdp0 = planp->target_datap[0];
+	segment = 0;
+	for (target_number = 0; target_number < planp->number_of_targets; target_number++) {
+		tdp = planp->target_datap[target_number];
+		if (tdp->td_block_size != tdp0->td_block_size) {
+			fprintf(xgp->errout,"%s: xdd_shared_file_layout: ERROR: all targets of a shared file need the same block size - target %d has %d, target 0 has %d\n",
+				xgp->progname, target_number, tdp->td_block_size, tdp0->td_block_size);
+			planp->plan_options &= ~(PLAN_SHARED_FILE_STRIDED | PLAN_SHARED_FILE_SEGMENTED);
+			return;
+		}
+		if ((planp->plan_options & PLAN_SHARED_FILE_STRIDED) && 
+			((tdp->td_reqsize != tdp0->td_reqsize) || (tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE))) {
+			fprintf(xgp->errout,"%s: xdd_shared_file_layout: ERROR: a strided shared file needs the same fixed request size for all targets - target %d differs\n",
+				xgp->progname, target_number);
+			planp->plan_options &= ~PLAN_SHARED_FILE_STRIDED;
+			return;
+		}
+		// A request size distribution can use more than the average number of bytes per pass
+		extent = tdp->td_target_bytes_to_xfer_per_pass;
+		if (tdp->td_seekhdr.seek_options & SO_SEEK_VARSIZE) {
+			reqsize_high = tdp->td_reqsize;
+			for (i = 0; i < tdp->td_seekhdr.seek_num_size_classes; i++)
+				if (tdp->td_seekhdr.seek_size_classes[i].reqsize > reqsize_high)
+					reqsize_high = tdp->td_seekhdr.seek_size_classes[i].reqsize;
+			extent = (uint64_t)tdp->td_target_ops * reqsize_high * tdp->td_block_size;
+		}
+		if (extent > segment)
+			segment = extent;
+	}
+	if (planp->plan_options & PLAN_SHARED_FILE_STRIDED) {
+		planp->target_offset = tdp0->td_reqsize;
+	} else { 
+		planp->target_offset = (segment + tdp0->td_block_size - 1) / tdp0->td_block_size;
+	}
+	if (xgp->global_options & GO_VERBOSE)
+		fprintf(xgp->output,"%s: %s shared file layout for %d targets, target offset is %llu %d-byte blocks\n",
+			xgp->progname,
+			(planp->plan_options & PLAN_SHARED_FILE_STRIDED)?"Strided":"Segmented",
+			planp->number_of_targets,
+			(unsigned long long)planp->target_offset,
+			tdp0->td_block_size);
+} /* End of xdd_shared_file_layout() */
+
 /*----------------------------------------------------------------------------*/
 /* xdd_build_target_data_substructure_e2e()									  */
 // If this is an end-to-end operation, figure out the number of Worker Threads 
@@ -50,6 +50,8 @@ xdd_ts_setup(target_data_t *tdp) {
 	size_t 	    tt_entries; /* number of entries in the time stamp table */
 	int32_t 	tt_bytes; /* size of time stamp table in bytes */
 	int32_t		ts_filename_size; // Number of bytes in the size of the file name
+	int64_t		stream_entries; // Number of scratch entries needed by -ts stream
+	int64_t		sample_entries; // Number of scratch entries needed by -ts sample
 
 
 
@@ -67,8 +69,14 @@ xdd_ts_setup(target_data_t *tdp) {
 	}
 
 	/* Calculate size of the time stamp table and malloc it */
+	/* When the entries are streamed to the dump file each Worker Thread only needs one */
+	stream_entries = xdd_ts_stream_setup(tdp);
+	/* The ops that are not sampled use scratch entries after the end of the table */
+	sample_entries = xdd_ts_sample_setup(tdp);
 	tt_entries = tsp->ts_size; 
-	if (tt_entries < ((tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth)) { /* Display a NOTICE message if ts_wrap or ts_oneshot have not been specified to compensate for a short time stamp buffer */
+	if (stream_entries > 0)
+		tt_entries = stream_entries;
+	else if ((tsp->ts_sample_mode == XDD_TS_SAMPLE_NONE) && (tt_entries < ((tdp->td_planp->passes * tdp->td_target_ops) + tdp->td_queue_depth))) { /* Display a NOTICE message if ts_wrap or ts_oneshot have not been specified to compensate for a short time stamp buffer */
 		if (((tsp->ts_options & TS_WRAP) == 0) &&
 			((tsp->ts_options & TS_ONESHOT) == 0)) {
 			fprintf(xgp->errout,"%s: ***NOTICE*** The size specified for timestamp table for target %d is too small - enabling time stamp wrapping to compensate\n",xgp->progname,tdp->td_target_number);
@@ -77,7 +85,8 @@ xdd_ts_setup(target_data_t *tdp) {
 		}
 	}
 	/* calculate the total size in bytes of the time stamp table */
-	tt_bytes = (int)((sizeof(struct xdd_ts_header)) + (tt_entries * sizeof(struct xdd_ts_tte)));
+	tsp->ts_scratch_entry = tt_entries;
+	tt_bytes = (int)((sizeof(struct xdd_ts_header)) + ((tt_entries + sample_entries) * sizeof(struct xdd_ts_tte)));
 #if (LINUX || SOLARIS || AIX || DARWIN)
 	tdp->td_ts_table.ts_hdrp = (struct xdd_ts_header *)valloc(tt_bytes);
 if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_setup: Target: %d: Worker: -: TS INITIALIZATION td_ts_table.ts_hdrp: %p: %d: entries\n ", (long long int)pclk_now(),tdp->td_target_number,tdp->td_ts_table.ts_hdrp,(int)tt_entries);
@@ -107,7 +116,7 @@ if (xgp->global_options & GO_DEBUG_TS) fprintf(stderr,"DEBUG_TS: %lld: xdd_ts_se
 	xdd_ts_overhead(tdp->td_ts_table.ts_hdrp);
 
         /* Set the XDD Version into the timestamp header */
-        tdp->td_ts_table.ts_hdrp->tsh_magic = 0xDEADBEEF;
+        tdp->td_ts_table.ts_hdrp->tsh_magic = XDD_TS_MAGIC;
         snprintf(tdp->td_ts_table.ts_hdrp->tsh_version, sizeof(tdp->td_ts_table.ts_hdrp->tsh_version), "%s", PACKAGE_STRING);
         
 	/* init entries in the trace table header */
@@ -167,6 +176,119 @@ if (xgp->global_options & GO_DEBUG_TS) xdd_show_ts_table(&tdp->td_ts_table, tdp-
 	return;
 } /* end of xdd_ts_setup() */
 /*----------------------------------------------------------------------------*/
+/* xdd_ts_assign_entry() - Give a Worker Thread the time stamp entry for the
+ * op it is about to do. This is called by the Target Thread when it assigns
+ * a task and time stamping is on.
+ * Return values: Pointer to the entry
+ */
+xdd_ts_tte_t *
+xdd_ts_assign_entry(worker_data_t *wdp) {
+	xint_timestamp_t	*tsp;
+	xdd_ts_tte_t		*ttep;
+
+
+	tsp = &wdp->wd_tdp->td_ts_table;
+	// With -ts sample most ops only count down to the next sampling decision
+	if (tsp->ts_sample_mode && ((--tsp->ts_sample_countdown > 0) || !xdd_ts_sample_op(tsp)))
+		return(xdd_ts_sample_skip(wdp));
+	wdp->wd_ts_skip = 0;
+	if (tsp->ts_options & TS_STREAM) // Each Worker Thread reuses an entry of its own
+		return(xdd_ts_stream_assign(wdp));
+	wdp->wd_ts_entry = tsp->ts_current_entry;	
+	ttep = &tsp->ts_hdrp->tsh_tte[wdp->wd_ts_entry];
+	tsp->ts_current_entry++;
+	if (tsp->ts_options & TS_ONESHOT) { // Check to see if we are at the end of the ts buffer
+		if (tsp->ts_current_entry == tsp->ts_size)
+			tsp->ts_options &= ~TS_ON; // Turn off Time Stamping now that we are at the end of the time stamp buffer
+	} else if (tsp->ts_options & TS_WRAP) {
+		tsp->ts_current_entry = 0; // Wrap to the beginning of the time stamp buffer
+	}
+	return(ttep);
+} /* end of xdd_ts_assign_entry() */
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_write_compact() - write the header and the timestamp entries to a
+ * file in the compact format. The entries of each Worker Thread go into
+ * blocks of their own. The entries are first sorted by Worker Thread with a
+ * counting sort of their indices, so the table is read a fixed number of
+ * times however many Worker Threads there are.
+ * Return values: Number of bytes written or -1 if there was an error
+ */
+static int64_t
+xdd_ts_write_compact(target_data_t *tdp, int ttfd) {
+	xdd_ts_header_t	*ts_hdrp;	// Pointer to the time stamp table header
+	xdd_ts_header_t	header;		// Copy of the header with the compact magic number
+	xdd_ts_tte_t	*blockp;	// Entries of the block being filled
+	int64_t			*firstp;	// Index in orderp of the first entry of each Worker Thread
+	int64_t			*orderp;	// Indices of the entries sorted by Worker Thread
+	int64_t			count;		// Number of entries in the block being filled
+	int64_t			bytes;		// Number of bytes written so far
+	int64_t			status;
+	int64_t			i;
+	int32_t			worker;
+	int32_t			max_worker;
+	uint16_t		fields;
+
+
+	ts_hdrp = tdp->td_ts_table.ts_hdrp;
+	memcpy(&header, ts_hdrp, XDD_TS_HEADER_SIZE);
+	header.tsh_magic = XDD_TS_COMPACT_MAGIC;
+	if (write(ttfd, &header, XDD_TS_HEADER_SIZE) != (ssize_t)XDD_TS_HEADER_SIZE)
+		return(-1);
+	bytes = XDD_TS_HEADER_SIZE;
+
+	fields = xdd_ts_compact_fields(tdp);
+	max_worker = 0;
+	for (i = 0; i < ts_hdrp->tsh_numents; i++)
+		if (ts_hdrp->tsh_tte[i].tte_worker_thread_number > max_worker)
+			max_worker = ts_hdrp->tsh_tte[i].tte_worker_thread_number;
+	blockp = (xdd_ts_tte_t *)malloc(sizeof(xdd_ts_tte_t) * XDD_TS_COMPACT_BLOCK_ENTRIES);
+	firstp = (int64_t *)calloc(max_worker + 2, sizeof(int64_t));
+	orderp = (int64_t *)malloc(sizeof(int64_t) * (ts_hdrp->tsh_numents + 1));
+	if ((blockp == NULL) || (firstp == NULL) || (orderp == NULL)) {
+		free(blockp);
+		free(firstp);
+		free(orderp);
+		return(-1);
+	}
+
+	// Count the entries of each Worker Thread, then turn the counts into where each one starts
+	for (i = 0; i < ts_hdrp->tsh_numents; i++)
+		if (ts_hdrp->tsh_tte[i].tte_worker_thread_number >= 0)
+			firstp[ts_hdrp->tsh_tte[i].tte_worker_thread_number + 1]++;
+	for (worker = 0; worker <= max_worker; worker++)
+		firstp[worker + 1] += firstp[worker];
+	// Put the entries in place in the order they were taken, using firstp as the next free slot
+	for (i = 0; i < ts_hdrp->tsh_numents; i++)
+		if (ts_hdrp->tsh_tte[i].tte_worker_thread_number >= 0)
+			orderp[firstp[ts_hdrp->tsh_tte[i].tte_worker_thread_number]++] = i;
+
+	// firstp[worker] is now where the next Worker Thread starts
+	i = 0;
+	for (worker = 0; worker <= max_worker; worker++) {
+		count = 0;
+		for ( ; i <= firstp[worker]; i++) {
+			if ((count == XDD_TS_COMPACT_BLOCK_ENTRIES) || ((i == firstp[worker]) && (count > 0))) {
+				status = xdd_ts_compact_write_block(ttfd, blockp, count, fields);
+				if (status < 0) {
+					free(blockp);
+					free(firstp);
+					free(orderp);
+					return(-1);
+				}
+				bytes += status;
+				count = 0;
+			}
+			if (i < firstp[worker])
+				blockp[count++] = ts_hdrp->tsh_tte[orderp[i]];
+		}
+		i = firstp[worker];
+	}
+	free(blockp);
+	free(firstp);
+	free(orderp);
+	return(bytes);
+} /* end of xdd_ts_write_compact() */
+/*----------------------------------------------------------------------------*/
 /* xdd_ts_write() - write the timestamp entried to a file. 
  */
 void
@@ -182,16 +304,21 @@ xdd_ts_write(target_data_t *tdp) {
 	ts_hdrp = tsp->ts_hdrp;
 	if ((tsp->ts_options & TS_DUMP) == 0)  /* dump only if DUMP was specified */
 		return;
-	ttfd = open(tsp->ts_binary_filename,O_WRONLY|O_CREAT,0666);
+	ttfd = open(tsp->ts_binary_filename,O_WRONLY|O_CREAT|O_TRUNC,0666);
 	if (ttfd < 0) {
 		fprintf(xgp->errout,"%s: cannot open timestamp table binary output file %s\n", xgp->progname,tsp->ts_binary_filename);
 		fflush(xgp->errout);
 		perror("reason");
 		return;
 	}
-	newsize = sizeof(struct xdd_ts_header) + (sizeof(struct xdd_ts_tte) * ts_hdrp->tsh_numents);
-	i = write(ttfd,ts_hdrp,newsize);
-	if (i != newsize) {
+	if (tsp->ts_options & TS_COMPACT) {
+		newsize = xdd_ts_write_compact(tdp, ttfd);
+		i = (newsize < 0) ? -1 : 0;
+	} else {
+		newsize = sizeof(struct xdd_ts_header) + (sizeof(struct xdd_ts_tte) * ts_hdrp->tsh_numents);
+		i = (write(ttfd,ts_hdrp,newsize) == newsize) ? 0 : -1;
+	}
+	if (i < 0) {
 		fprintf(xgp->errout,"(%d) %s: cannot write timestamp table binary output file %s\n", tdp->td_target_number, xgp->progname,tsp->ts_binary_filename);
 		fflush(xgp->errout);
 		perror("reason");
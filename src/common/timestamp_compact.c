@@ -0,0 +1,323 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+/*
+ * This file contains the subroutines that write and read the compact
+ * time stamp dump format used by -ts compact. See struct xdd_ts_block in
+ * xint_timestamp.h for the layout.
+ * These subroutines do not use the global data so that read_tsdumps can be
+ * linked with this file as well.
+ */
+#include "xint.h"
+
+/*----------------------------------------------------------------------------*/
+/* Varints and zigzag encoding
+ * A varint holds 7 bits in each byte, least significant first, with the top
+ * bit set on all but the last byte. Zigzag maps signed values of small
+ * magnitude to small unsigned values: 0, -1, 1, -2, 2 ... -> 0, 1, 2, 3, 4 ...
+ */
+static unsigned char *
+xdd_ts_put_varint(unsigned char *cp, uint64_t value) {
+	while (value >= 0x80) {
+		*cp++ = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	*cp++ = (unsigned char)value;
+	return(cp);
+} // End of xdd_ts_put_varint()
+
+static unsigned char *
+xdd_ts_put_signed(unsigned char *cp, int64_t value) {
+	return(xdd_ts_put_varint(cp, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63)));
+} // End of xdd_ts_put_signed()
+
+// Return NULL if the varint runs past the end
+static unsigned char *
+xdd_ts_get_varint(unsigned char *cp, unsigned char *endp, uint64_t *valuep) {
+	uint64_t	value;
+	int			shift;
+
+
+	value = 0;
+	for (shift = 0; shift < 64; shift += 7) {
+		if (cp >= endp)
+			return(NULL);
+		value |= (uint64_t)(*cp & 0x7f) << shift;
+		if (!(*cp++ & 0x80)) {
+			*valuep = value;
+			return(cp);
+		}
+	}
+	return(NULL);
+} // End of xdd_ts_get_varint()
+
+static unsigned char *
+xdd_ts_get_signed(unsigned char *cp, unsigned char *endp, int64_t *valuep) {
+	uint64_t	value;
+
+
+	cp = xdd_ts_get_varint(cp, endp, &value);
+	if (cp)
+		*valuep = (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+	return(cp);
+} // End of xdd_ts_get_signed()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_compact_fields() - Return the fields worth keeping for a target
+ */
+uint16_t
+xdd_ts_compact_fields(target_data_t *tdp) {
+	uint16_t	fields;
+
+
+	fields = XDD_TS_FIELD_CPU;
+	if (tdp->td_target_options & TO_ENDTOEND)
+		fields |= XDD_TS_FIELD_NET;
+	if (!(tdp->td_target_options & TO_E2E_DESTINATION)) // The Destination Side does not set up tasks
+		fields |= XDD_TS_FIELD_DISPATCH;
+	return(fields);
+} // End of xdd_ts_compact_fields()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_compact_encode() - Encode entries of one Worker Thread.
+ * The buffer must have room for count * XDD_TS_COMPACT_MAX_ENTRY_BYTES bytes.
+ * Return values: Number of bytes used
+ */
+size_t
+xdd_ts_compact_encode(xdd_ts_tte_t *ttep, int64_t count, uint16_t fields, unsigned char *bufp) {
+	xdd_ts_tte_t	prev;	// The entry before this one - all zero for the first
+	unsigned char	*cp;
+	int64_t			i;
+
+
+	memset(&prev, 0, sizeof(prev));
+	cp = bufp;
+	for (i = 0; i < count; i++, ttep++) {
+		*cp++ = (unsigned char)ttep->tte_op_type;
+		cp = xdd_ts_put_signed(cp, (int64_t)ttep->tte_pass_number - prev.tte_pass_number);
+		cp = xdd_ts_put_signed(cp, ttep->tte_op_number - prev.tte_op_number);
+		cp = xdd_ts_put_signed(cp, ttep->tte_byte_offset - (prev.tte_byte_offset + prev.tte_disk_xfer_size));
+		cp = xdd_ts_put_signed(cp, (int64_t)ttep->tte_disk_xfer_size - prev.tte_disk_xfer_size);
+		cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_disk_start - prev.tte_disk_start));
+		cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_disk_end - ttep->tte_disk_start));
+		if (fields & XDD_TS_FIELD_CPU) {
+			cp = xdd_ts_put_signed(cp, ttep->tte_disk_processor_start);
+			cp = xdd_ts_put_signed(cp, (int64_t)ttep->tte_disk_processor_end - ttep->tte_disk_processor_start);
+		}
+		if (fields & XDD_TS_FIELD_NET) {
+			cp = xdd_ts_put_signed(cp, (int64_t)ttep->tte_net_xfer_size - prev.tte_net_xfer_size);
+			cp = xdd_ts_put_signed(cp, ttep->tte_net_xfer_calls);
+			cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_net_start - prev.tte_net_start));
+			cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_net_end - ttep->tte_net_start));
+			if (fields & XDD_TS_FIELD_CPU) {
+				cp = xdd_ts_put_signed(cp, ttep->tte_net_processor_start);
+				cp = xdd_ts_put_signed(cp, (int64_t)ttep->tte_net_processor_end - ttep->tte_net_processor_start);
+			}
+		}
+		if (fields & XDD_TS_FIELD_KERNEL) {
+			cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_disk_start_k - ttep->tte_disk_start));
+			cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_disk_end_k - ttep->tte_disk_end));
+			if (fields & XDD_TS_FIELD_NET) {
+				cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_net_start_k - ttep->tte_net_start));
+				cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_net_end_k - ttep->tte_net_end));
+			}
+		}
+		if (fields & XDD_TS_FIELD_DISPATCH) {
+			cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_disk_start - ttep->tte_task_setup));
+			cp = xdd_ts_put_signed(cp, (int64_t)(ttep->tte_worker_wakeup - ttep->tte_task_setup));
+		}
+		prev = *ttep;
+	}
+	return(cp - bufp);
+} // End of xdd_ts_compact_encode()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_compact_decode() - Decode the entries of a block
+ * Return values: 0 is good, -1 if the block is damaged
+ */
+int32_t
+xdd_ts_compact_decode(xdd_ts_block_t *tsbp, unsigned char *bufp, xdd_ts_tte_t *ttep) {
+	xdd_ts_tte_t	prev;
+	unsigned char	*cp;
+	unsigned char	*endp;
+	int64_t			v[4];
+	int64_t			i;
+
+
+	memset(&prev, 0, sizeof(prev));
+	cp = bufp;
+	endp = bufp + tsbp->tsb_bytes;
+	for (i = 0; i < tsbp->tsb_entries; i++, ttep++) {
+		memset(ttep, 0, sizeof(*ttep));
+		if (cp >= endp)
+			return(-1);
+		ttep->tte_op_type = (char)*cp++;
+		ttep->tte_worker_thread_number = tsbp->tsb_worker_thread_number;
+		ttep->tte_thread_id = tsbp->tsb_thread_id;
+		if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+		ttep->tte_pass_number = (short)(prev.tte_pass_number + v[0]);
+		if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+		ttep->tte_op_number = prev.tte_op_number + v[0];
+		if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+		ttep->tte_byte_offset = prev.tte_byte_offset + prev.tte_disk_xfer_size + v[0];
+		if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+		ttep->tte_disk_xfer_size = (int32_t)(prev.tte_disk_xfer_size + v[0]);
+		if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+		ttep->tte_disk_start = prev.tte_disk_start + v[0];
+		if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+		ttep->tte_disk_end = ttep->tte_disk_start + v[0];
+		if (tsbp->tsb_fields & XDD_TS_FIELD_CPU) {
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[1]))) return(-1);
+			ttep->tte_disk_processor_start = (short)v[0];
+			ttep->tte_disk_processor_end = (short)(v[0] + v[1]);
+		}
+		if (tsbp->tsb_fields & XDD_TS_FIELD_NET) {
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[1]))) return(-1);
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[2]))) return(-1);
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[3]))) return(-1);
+			ttep->tte_net_xfer_size = (int32_t)(prev.tte_net_xfer_size + v[0]);
+			ttep->tte_net_xfer_calls = (int32_t)v[1];
+			ttep->tte_net_start = prev.tte_net_start + v[2];
+			ttep->tte_net_end = ttep->tte_net_start + v[3];
+			if (tsbp->tsb_fields & XDD_TS_FIELD_CPU) {
+				if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+				if (!(cp = xdd_ts_get_signed(cp, endp, &v[1]))) return(-1);
+				ttep->tte_net_processor_start = (short)v[0];
+				ttep->tte_net_processor_end = (short)(v[0] + v[1]);
+			}
+		}
+		if (tsbp->tsb_fields & XDD_TS_FIELD_KERNEL) {
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[1]))) return(-1);
+			ttep->tte_disk_start_k = ttep->tte_disk_start + v[0];
+			ttep->tte_disk_end_k = ttep->tte_disk_end + v[1];
+			if (tsbp->tsb_fields & XDD_TS_FIELD_NET) {
+				if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+				if (!(cp = xdd_ts_get_signed(cp, endp, &v[1]))) return(-1);
+				ttep->tte_net_start_k = ttep->tte_net_start + v[0];
+				ttep->tte_net_end_k = ttep->tte_net_end + v[1];
+			}
+		}
+		if (tsbp->tsb_fields & XDD_TS_FIELD_DISPATCH) {
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[0]))) return(-1);
+			if (!(cp = xdd_ts_get_signed(cp, endp, &v[1]))) return(-1);
+			ttep->tte_task_setup = ttep->tte_disk_start - v[0];
+			ttep->tte_worker_wakeup = ttep->tte_task_setup + v[1];
+		}
+		prev = *ttep;
+	}
+	return((cp == endp) ? 0 : -1);
+} // End of xdd_ts_compact_decode()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_compact_write_block() - Write entries of one Worker Thread to a
+ * dump file as a block
+ * Return values: Number of bytes written or -1 if the write failed
+ */
+int64_t
+xdd_ts_compact_write_block(int fd, xdd_ts_tte_t *ttep, int64_t count, uint16_t fields) {
+	xdd_ts_block_t	*tsbp;
+	unsigned char	*bufp;
+	size_t			bytes;
+	ssize_t			status;
+
+
+	if (count <= 0)
+		return(0);
+	bufp = (unsigned char *)malloc(sizeof(xdd_ts_block_t) + (count * XDD_TS_COMPACT_MAX_ENTRY_BYTES));
+	if (bufp == NULL)
+		return(-1);
+	tsbp = (xdd_ts_block_t *)bufp;
+	memset(tsbp, 0, sizeof(*tsbp));
+	tsbp->tsb_magic = XDD_TS_BLOCK_MAGIC;
+	tsbp->tsb_version = XDD_TS_COMPACT_VERSION;
+	tsbp->tsb_fields = fields;
+	tsbp->tsb_worker_thread_number = ttep->tte_worker_thread_number;
+	tsbp->tsb_thread_id = ttep->tte_thread_id;
+	tsbp->tsb_entries = count;
+	tsbp->tsb_bytes = xdd_ts_compact_encode(ttep, count, fields, bufp + sizeof(xdd_ts_block_t));
+	bytes = sizeof(xdd_ts_block_t) + tsbp->tsb_bytes;
+	status = write(fd, bufp, bytes);
+	free(bufp);
+	if (status != (ssize_t)bytes)
+		return(-1);
+	return(bytes);
+} // End of xdd_ts_compact_write_block()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_ts_compact_expand() - Turn the contents of a compact dump file into a
+ * time stamp header followed by an array of all its entries, the same as
+ * what a dump file of the raw format holds.
+ * Return values: Pointer to the malloc'd header or NULL if the file is damaged
+ *                or there is no memory. *sizep gets the size in bytes.
+ */
+xdd_ts_header_t *
+xdd_ts_compact_expand(unsigned char *filep, size_t file_size, size_t *sizep) {
+	xdd_ts_header_t	*ts_hdrp;
+	xdd_ts_block_t	tsb;
+	unsigned char	*cp;
+	unsigned char	*endp;
+	int64_t			entries;
+	int64_t			n;
+	size_t			size;
+
+
+	if (file_size < XDD_TS_HEADER_SIZE)
+		return(NULL);
+	endp = filep + file_size;
+
+	// Count the entries of the blocks first
+	entries = 0;
+	for (cp = filep + XDD_TS_HEADER_SIZE; cp < endp; cp += sizeof(tsb) + tsb.tsb_bytes) {
+		if ((size_t)(endp - cp) < sizeof(tsb))
+			return(NULL);
+		memcpy(&tsb, cp, sizeof(tsb));
+		if ((tsb.tsb_magic != XDD_TS_BLOCK_MAGIC) || (tsb.tsb_version > XDD_TS_COMPACT_VERSION) ||
+			(tsb.tsb_entries < 0) || (tsb.tsb_bytes < 0) || (tsb.tsb_bytes > (endp - cp) - (int64_t)sizeof(tsb)))
+			return(NULL);
+		entries += tsb.tsb_entries;
+	}
+
+	size = XDD_TS_HEADER_SIZE + ((entries > 0 ? entries : 1) * sizeof(xdd_ts_tte_t));
+	ts_hdrp = (xdd_ts_header_t *)malloc(size);
+	if (ts_hdrp == NULL)
+		return(NULL);
+	memcpy(ts_hdrp, filep, XDD_TS_HEADER_SIZE);
+	n = 0;
+	for (cp = filep + XDD_TS_HEADER_SIZE; cp < endp; cp += sizeof(tsb) + tsb.tsb_bytes) {
+		memcpy(&tsb, cp, sizeof(tsb));
+		if (xdd_ts_compact_decode(&tsb, cp + sizeof(tsb), &ts_hdrp->tsh_tte[n])) {
+			free(ts_hdrp);
+			return(NULL);
+		}
+		n += tsb.tsb_entries;
+	}
+	ts_hdrp->tsh_magic = XDD_TS_MAGIC;
+	ts_hdrp->tsh_numents = entries;
+	ts_hdrp->tsh_tt_size = entries;
+	ts_hdrp->tsh_tt_bytes = XDD_TS_HEADER_SIZE + (entries * sizeof(xdd_ts_tte_t));
+	*sizep = size;
+	return(ts_hdrp);
+} // End of xdd_ts_compact_expand()
+
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,62 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_CHECKSUM_H
+#define XINT_CHECKSUM_H
+
+// Checksum algorithms used by -verify checksum
+#define XDD_CHECKSUM_CRC32C		0	// CRC32C (Castagnoli) - hardware assisted when the CPU has it
+#define XDD_CHECKSUM_XXH64		1	// 64-bit xxHash - fast non-cryptographic hash
+
+#define XDD_CHECKSUM_FILE_MAGIC		0x31304d5343444458ULL	// "XDDCSM01" 
+#define XDD_CHECKSUM_FILE_VERSION	1
+
+/** Header of a checksum table file. It is followed by the checksums of
+ * csf_num_blocks blocks and then by one "valid" byte per block. */
+struct xint_checksum_file_header {
+	uint64_t	csf_magic;			// XDD_CHECKSUM_FILE_MAGIC
+	uint32_t	csf_version;		// XDD_CHECKSUM_FILE_VERSION
+	uint32_t	csf_algorithm;		// XDD_CHECKSUM_CRC32C or XDD_CHECKSUM_XXH64
+	uint32_t	csf_block_size;		// Bytes covered by each checksum
+	uint32_t	csf_target_number;	// Target that wrote the table
+	int64_t		csf_first_block;	// Block number of the first checksum in the table
+	int64_t		csf_num_blocks;		// Number of checksums in the table
+};
+typedef struct xint_checksum_file_header xint_checksum_file_header_t;
+
+/** Per-block checksum table of a target for -verify checksum */
+struct xint_checksum {
+	int32_t		cs_algorithm;		// XDD_CHECKSUM_CRC32C or XDD_CHECKSUM_XXH64
+	char		*cs_filename;		// Checksum table file - loaded at start and saved at the end of the run 
+	int64_t		cs_first_block;		// Block number of the first entry in the table
+	int64_t		cs_num_blocks;		// Number of entries in the table
+	uint64_t	*cs_sums;			// Checksum of each block
+	unsigned char	*cs_valid;		// Non-zero if the checksum of a block is known
+	// The following counters are updated under td_counters_mutex
+	uint64_t	cs_blocks_recorded;	// Number of block checksums computed on writes
+	uint64_t	cs_blocks_verified;	// Number of blocks read that matched their checksum
+	uint64_t	cs_blocks_unknown;	// Number of blocks read that have no checksum in the table
+	int64_t		cs_errors;			// Number of blocks read that did not match their checksum
+};
+typedef struct xint_checksum xint_checksum_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -0,0 +1,70 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_COMPOUND_H
+#define XINT_COMPOUND_H
+
+/** A write that is waiting for its readback */
+struct xint_readback {
+	int64_t		rb_op_number;		// Op number of the write
+	off_t		rb_byte_offset;		// Where the write went
+	size_t		rb_xfer_size;		// Number of bytes written
+	uint64_t	rb_checksum;		// CRC32C of the data written
+	nclk_t		rb_write_time;		// Time the write took
+};
+typedef struct xint_readback xint_readback_t;
+
+/** Compound op state of a Worker Thread */
+struct xint_compound_worker {
+	unsigned char	*cw_bufp;			// Buffer the RMW reads and the readbacks go into
+	nclk_t			cw_read_time;		// Time of the read of the current RMW op
+	xint_readback_t	*cw_ring;			// Writes waiting for their readback - oldest first
+	int32_t			cw_ring_size;		// Number of entries in the ring
+	int32_t			cw_head;			// Oldest entry
+	int32_t			cw_count;			// Number of entries in use
+};
+typedef struct xint_compound_worker xint_compound_worker_t;
+
+/** Compound ops of a target used by -op rmw and -op writeverify
+ * A read-modify-write reads the blocks of a write op before writing them.
+ * A write-verify writes the blocks and reads them back after the target has
+ * done co_readback_delay more ops, checking that the data did not get lost.
+ * Each is counted as one op of the target; the times of its reads and writes
+ * are kept here as well.
+ */
+struct xint_compound {
+	char		co_op;					// SO_OP_READ_MODIFY_WRITE, SO_OP_WRITE_VERIFY, or 0
+	int64_t		co_readback_delay;		// Number of ops of the target between a write and its readback
+	uint64_t	co_rmw_ops;				// Number of read-modify-write ops
+	nclk_t		co_rmw_time;			// Time of the read-modify-write ops
+	nclk_t		co_rmw_read_time;		// Time of their reads
+	nclk_t		co_rmw_write_time;		// Time of their writes
+	uint64_t	co_readback_ops;		// Number of writes that were read back
+	nclk_t		co_readback_time;		// Time of those writes plus their readbacks
+	nclk_t		co_readback_write_time;	// Time of the writes
+	nclk_t		co_readback_read_time;	// Time of the readbacks
+	int64_t		co_readback_errors;		// Number of readbacks that did not match what was written
+	int64_t		co_readback_io_errors;	// Number of readbacks that failed
+};
+typedef struct xint_compound xint_compound_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
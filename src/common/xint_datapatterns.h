@@ -29,6 +29,12 @@
 #define DP_INVERSE_PATTERN             0x0000000000002000ULL  // Apply a 1's compliment to the data pattern 
 #define DP_NAME_PATTERN                0x0000000000004000ULL  // Use the specified name at the beginning of the data pattern
 #define DP_RANDOM_BY_TARGET_PATTERN    0x0000000000008000ULL  // Use random data pattern for write operations, seed by target number
+#define DP_RANDOM_BY_OFFSET_PATTERN    0x0000000000010000ULL  // Random data generated for every op from the seed, target number, and byte offset
+
+// The random by offset data pattern is made of chunks of this size. 
+// The compression ratio applies within a chunk and the dedupe ratio is the fraction of duplicate chunks.
+#define DP_CHUNK_SIZE                  4096
+#define DP_DEDUPE_GROUP_CHUNKS         1024                   // A duplicate chunk repeats an earlier chunk of its group of this many chunks
 
 struct xint_data_pattern {
     // Type of data pattern options to use
@@ -47,8 +53,39 @@ struct xint_data_pattern {
     int32_t data_pattern_name_length;	// Length of the data pattern name string 
     char *data_pattern_filename; 	// Name of a file that contains a data pattern to use 
     int64_t data_pattern_compare_errors;	// Number of content/sequence compare errors from the verify() subroutines
+    uint64_t data_pattern_seed;		// Seed of the random by offset data pattern
+    double data_pattern_compress_ratio;	// Target compression ratio of the random by offset data pattern - 0 or 1 is incompressible
+    double data_pattern_dedupe_ratio;	// Fraction of chunks of the random by offset data pattern that are duplicates - 0.0 to 1.0
 }; 
 typedef struct xint_data_pattern xint_data_pattern_t;
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_offset_word() - The 8-byte word of the random by offset data 
+ * pattern at the specified byte offset of the target. This is the splitmix64
+ * generator used as a counter based generator so that any word can be made
+ * on its own - when writing as well as when verifying - no matter what the 
+ * request size or the order of the operations was.
+ * The key comes from xdd_random_offset_key().
+ */
+static inline uint64_t
+xdd_random_offset_word(uint64_t key, uint64_t byte_offset) {
+	uint64_t	z;
+
+	z = key + (((byte_offset >> 3) + 1) * 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return(z ^ (z >> 31));
+} // End of xdd_random_offset_word()
+
+/*----------------------------------------------------------------------------*/
+/* xdd_random_offset_key() - Mix the seed and the target number into the key 
+ * of the random by offset data pattern
+ */
+static inline uint64_t
+xdd_random_offset_key(uint64_t seed, int32_t target_number) {
+	return(xdd_random_offset_word(seed, ((uint64_t)target_number) << 3));
+} // End of xdd_random_offset_key()
+
 #ifdef XDD_DATA_PATTERN
 /*----------------------------------------------------------------------------*/
 /* 
@@ -0,0 +1,88 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_HISTOGRAM_H
+#define XINT_HISTOGRAM_H
+
+/*
+ * Log-linear latency histograms used by -histogram
+ * Op times in nanoseconds below 2^XINT_HISTOGRAM_SUB_BUCKET_BITS each get a
+ * bucket of their own. Above that every power of two is split into
+ * XINT_HISTOGRAM_HALF_COUNT buckets of equal width so that a bucket is never
+ * wider than 1/64th of the values in it - better than 1.6% - whatever the
+ * magnitude. Op times of 2^XINT_HISTOGRAM_MAX_BITS nanoseconds (about 18
+ * minutes) or more all go into the last bucket; h_max still has them exactly.
+ *
+ * The read, write, and all histograms hold the time from the issue of an op
+ * to its completion. With -dispatchstats the time an op spends being handed
+ * from the Target Thread to a Worker Thread before it is issued goes into
+ * histograms of its own so that the lag added by xdd can be told apart from
+ * the service time of the device.
+ */
+#define XINT_HISTOGRAM_SUB_BUCKET_BITS	7
+#define XINT_HISTOGRAM_HALF_COUNT		(1 << (XINT_HISTOGRAM_SUB_BUCKET_BITS - 1))
+#define XINT_HISTOGRAM_MAX_BITS			40
+#define XINT_HISTOGRAM_BUCKETS			((XINT_HISTOGRAM_MAX_BITS - XINT_HISTOGRAM_SUB_BUCKET_BITS + 2) * XINT_HISTOGRAM_HALF_COUNT)
+
+/** The op times of one kind of op */
+struct xint_histogram {
+	uint64_t	h_count;						// Number of op times recorded
+	nclk_t		h_min;							// Shortest op time - NCLK_MAX if there are none
+	nclk_t		h_max;							// Longest op time
+	nclk_t		h_total;						// Sum of the op times
+	uint64_t	h_buckets[XINT_HISTOGRAM_BUCKETS];	// Number of op times that fell into each bucket
+};
+typedef struct xint_histogram xint_histogram_t;
+
+/** The histograms of a Worker Thread, a target, or all targets
+ * A Worker Thread only ever updates its own so no locking is needed. The
+ * Results Manager merges them into the target at the end of each pass while
+ * the Worker Threads are idle.
+ * Only the first hs_count histograms are allocated - the -dispatchstats ones
+ * are left off without that option. See xdd_histogram_alloc().
+ */
+#define XINT_HISTOGRAM_READ		0		// Read ops
+#define XINT_HISTOGRAM_WRITE	1		// Write ops
+#define XINT_HISTOGRAM_ALL		2		// Read and write ops
+#define XINT_HISTOGRAM_HANDOFF	3		// From task setup to the wakeup of the Worker Thread - used by -dispatchstats
+#define XINT_HISTOGRAM_PREISSUE	4		// From the wakeup of the Worker Thread to the issue of the op - used by -dispatchstats
+#define XINT_HISTOGRAM_DISPATCH	5		// From task setup to the issue of the op - used by -dispatchstats
+#define XINT_HISTOGRAMS			6
+#define XINT_HISTOGRAMS_BASIC	3		// Number of histograms without -dispatchstats
+struct xint_histograms {
+	int32_t				hs_count;		// Number of histograms in hs_hist
+	xint_histogram_t	hs_hist[XINT_HISTOGRAMS];
+};
+typedef struct xint_histograms xint_histograms_t;
+
+/** What a thread that reports on a run while it goes on saw of a target the
+ * last time it looked. See xdd_histogram_target_look().
+ */
+struct xint_histogram_look {
+	int32_t				hl_pass_done;	// The last look was the one at the end of a pass
+	int64_t				hl_bytes;		// Bytes transferred so far this pass
+	int64_t				hl_ops;			// Ops done so far this pass
+	xint_histogram_t	hl_hist;		// Histogram of all the op times so far this pass
+};
+typedef struct xint_histogram_look xint_histogram_look_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
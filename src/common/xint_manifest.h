@@ -0,0 +1,79 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_MANIFEST_H
+#define XINT_MANIFEST_H
+
+// What a run does with its manifest
+#define XDD_MANIFEST_WRITE		1	// Append a record for every write
+#define XDD_MANIFEST_VERIFY		2	// Verify reads against the records in the manifest
+
+#define XDD_MANIFEST_FILE_MAGIC		0x31304e414d444458ULL	// "XDDMAN01" 
+#define XDD_MANIFEST_FILE_VERSION	1
+#define XDD_MANIFEST_BUFFER_SIZE	(1024*1024)	// Records are appended to the file in chunks of up to this many bytes
+#define XDD_MANIFEST_MAX_BLOCKS		((XDD_MANIFEST_BUFFER_SIZE - sizeof(xint_manifest_record_t)) / sizeof(uint64_t))	// Most blocks in one record
+#define XDD_MANIFEST_SYNC_INTERVAL	BILLION		// Most nanoseconds a record waits in the buffer before the records are flushed
+
+/** Header at the start of a manifest file. It is written by the run that
+ * creates the file; later runs append records after the existing ones. */
+struct xint_manifest_file_header {
+	uint64_t	mfh_magic;			// XDD_MANIFEST_FILE_MAGIC
+	uint32_t	mfh_version;		// XDD_MANIFEST_FILE_VERSION
+	uint32_t	mfh_algorithm;		// XDD_CHECKSUM_CRC32C or XDD_CHECKSUM_XXH64
+	uint32_t	mfh_block_size;		// Bytes covered by each checksum
+	uint32_t	mfh_target_number;	// Target that created the manifest
+	uint64_t	mfh_pattern_options;	// Data pattern options of the run that created the manifest
+	uint64_t	mfh_pattern_seed;	// Seed of the random by offset data pattern of that run
+};
+typedef struct xint_manifest_file_header xint_manifest_file_header_t;
+
+/** One completed write. The record is followed by the checksums of its
+ * mr_num_blocks blocks. Records of later writes of a block supersede 
+ * the earlier ones. */
+struct xint_manifest_record {
+	int64_t		mr_first_block;		// Block number of the first block written
+	uint32_t	mr_num_blocks;		// Number of blocks written
+	uint32_t	mr_generation;		// Run that wrote the blocks - 1 for the run that created the manifest
+	uint32_t	mr_pass;			// Pass of that run that wrote the blocks
+	uint32_t	mr_reserved;
+};
+typedef struct xint_manifest_record xint_manifest_record_t;
+
+/** Write manifest of a target used by -manifest */
+struct xint_manifest {
+	int32_t			mf_mode;			// XDD_MANIFEST_WRITE or XDD_MANIFEST_VERIFY
+	char			*mf_filename;		// The manifest file
+	int				mf_fd;				// File descriptor of the manifest while writing
+	uint32_t		mf_generation;		// Generation of the records of this run
+	pthread_mutex_t	mf_mutex;			// Serializes the record buffer
+	unsigned char	*mf_bufp;			// Records not yet appended to the file
+	size_t			mf_buf_used;		// Number of bytes in the record buffer
+	nclk_t			mf_flush_time;		// When the records were last flushed
+	pthread_mutex_t	mf_flush_mutex;		// Serializes flushes and the flush buffer - taken before mf_mutex
+	unsigned char	*mf_flush_bufp;		// Records being appended to the file while new ones go into mf_bufp
+	uint64_t		mf_records;			// Number of records written or loaded
+	uint64_t		mf_blocks;			// Number of block checksums written or loaded
+	int32_t			mf_errors;			// Number of failed appends to the file
+};
+typedef struct xint_manifest xint_manifest_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
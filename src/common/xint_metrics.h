@@ -0,0 +1,62 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_METRICS_H
+#define XINT_METRICS_H
+
+/*
+ * Metrics endpoint used by -metrics
+ * A low priority server thread answers HTTP requests on a TCP port or a UNIX
+ * socket with the counters, op time histograms, and states of the targets
+ * and Worker Threads in the Prometheus text exposition format. The counters
+ * of a target start over with each pass, so the server thread keeps totals
+ * for the whole run that only ever go up. It reads the Target and Worker
+ * Data without locking them; the Results Manager has it look once more at
+ * the end of each pass before the counters and histograms are emptied.
+ */
+#define XINT_METRICS_POLL_INTERVAL	250000		// Microseconds between checks for shutdown while waiting for a request
+#define XINT_METRICS_REQUEST_SIZE	2048		// Longest HTTP request header read
+#define XINT_METRICS_TIMEOUT		2			// Seconds to wait for a client to send its request or take the answer
+
+/** What the server thread knows of a target */
+struct xint_metrics_target {
+	xint_histogram_look_t	mxt_look;		// Counters and op times so far this pass as of the last look
+	uint64_t			mxt_bytes_total;	// Bytes transferred so far this run
+	uint64_t			mxt_ops_total;		// Ops done so far this run
+	xint_histogram_t	mxt_hist_total;		// Histogram of all the op times so far this run
+};
+typedef struct xint_metrics_target xint_metrics_target_t;
+
+/** Server thread of -metrics */
+struct xint_metrics {
+	pthread_t				mx_thread;		// The server thread
+	pthread_mutex_t			mx_mutex;		// Serializes access to mx_shutdown and the totals
+	int32_t					mx_shutdown;	// Set to tell the server thread to exit
+	int						mx_listen_fd;	// Socket the requests come in on
+	char					*mx_unix_path;	// Path name of the UNIX socket or NULL for TCP
+	xint_histogram_t		mx_hist;		// Scratch histogram of the ops since the last look
+	xint_metrics_target_t	*mx_targets;	// What is known of each target
+	struct xint_plan		*mx_planp;
+};
+typedef struct xint_metrics xint_metrics_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
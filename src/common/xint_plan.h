@@ -26,12 +26,21 @@
 #include "xint_triggers.h"
 #include "xint_datapatterns.h"
 #include "xint_extended_stats.h"
+#include "xint_checksum.h"
+#include "xint_manifest.h"
 #include "xint_throttle.h"
 #include "xint_common.h"
 #include "xint_nclk.h"
 #include "xint_task.h"
 #include "xint_target_counters.h"
 #include "xint_timestamp.h"
+#include "xint_verify_pool.h"
+#include "xint_prefill.h"
+#include "xint_compound.h"
+#include "xint_histogram.h"
+#include "xint_timeseries.h"
+#include "xint_shmstats.h"
+#include "xint_metrics.h"
 #include "xint_td.h"
 #include "xint_wd.h"
 #include "xint_read_after_write.h"
@@ -58,6 +67,16 @@
 #define PLAN_DRYRUN				0x0000000000020000ULL  /* Indicates a dry run - chicken! */
 #define PLAN_HEARTBEAT			0x0000000000040000ULL  /* Indicates that a heartbeat has been requested */
 #define PLAN_AVAILABLE2			0x0000000000080000ULL  /* AVAILABLE */
+#define PLAN_SHARED_FILE_STRIDED	0x0000000000100000ULL  /* N-to-1 shared file - targets interleave their requests */
+#define PLAN_SHARED_FILE_SEGMENTED	0x0000000000200000ULL  /* N-to-1 shared file - each target owns a contiguous segment */
+#define PLAN_SHARED_FILE_FLUSH		0x0000000000400000ULL  /* All targets flush together at the end of each pass */
+#define PLAN_HISTOGRAM			0x0000000000800000ULL  /* Keep latency histograms of the ops of each target */
+#define PLAN_TIMESERIES			0x0000000001000000ULL  /* Write interval statistics of each target to a file */
+#define PLAN_TIMESERIES_BINARY	0x0000000002000000ULL  /* Write the interval statistics as binary records instead of CSV */
+#define PLAN_SHMSTATS			0x0000000004000000ULL  /* Keep live statistics in a shared memory segment */
+#define PLAN_METRICS			0x0000000008000000ULL  /* Answer requests for live metrics in the Prometheus text format */
+#define PLAN_STATE_TIMES		0x0000000010000000ULL  /* Account for the time each Worker Thread spends in each state */
+#define PLAN_DISPATCH_STATS		0x0000000020000000ULL  /* Keep histograms of the time ops take to be handed to a Worker Thread and issued */
 #define PLAN_INTERACTIVE		0x0000000400000000ULL  /* Enter Interactive Mode - oh what FUN! */
 #define PLAN_INTERACTIVE_EXIT	0x0000000800000000ULL  /* Exit Interactive Mode */
 #define PLAN_INTERACTIVE_STOP	0x0000001000000000ULL  /* Stop at various points in Interactive Mode */
@@ -74,6 +93,16 @@ struct xint_plan {
 	nclk_t			pass_delay_accumulated_time;		/* number of high-res clock ticks of accumulated time during all pass delays */
 	char			*ts_binary_filename_prefix; 			/* timestamp filename prefix */
 	char			*ts_output_filename_prefix; 			/* timestamp report output filename prefix */
+	char			*histogram_filename;				/* Name of the file the latency histograms are written to */
+	char			*timeseries_filename;				/* Name of the file the interval statistics are written to */
+	nclk_t			timeseries_interval;				/* Time between interval statistics in nanoseconds */
+	struct xint_timeseries	*timeseriesp;				/* Writer thread of the interval statistics */
+	char			*shmstats_name;						/* Name of the live statistics shared memory segment */
+	struct xint_shmstats	*shmstatsp;					/* Updater thread of the live statistics */
+	char			*metrics_address;					/* Port or UNIX socket the metrics requests come in on */
+	struct xint_metrics	*metricsp;						/* Server thread of the metrics */
+	char			*json_filename;						/* Name of the file the JSON results are written to */
+	FILE			*json_fp;							/* The JSON results file once it is open */
 	uint32_t		restart_frequency;      			/* seconds between restart monitor checks */
 	int32_t			syncio;                 			/* the number of I/Os to perform btw syncs */
 	uint64_t		target_offset;          			/* offset value */
@@ -121,6 +150,8 @@ struct xint_plan {
 
 	xdd_barrier_t	main_targets_syncio_barrier;    	// Barrier for syncio 
 
+	xdd_barrier_t	main_targets_sharedfile_barrier;   	// Barrier for the collective flush of a shared file at the end of a pass
+
 	xdd_barrier_t	main_results_final_barrier;        	// Barrier for the Results Manager to sync with xdd_main after all Target Threads have terminated
 
 	xdd_barrier_t	results_targets_startpass_barrier;	// Barrier for synchronizing target threads - all targets gather here at the beginning of a pass 
@@ -0,0 +1,62 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_PREFILL_H
+#define XINT_PREFILL_H
+
+// States of a slot of the prefill ring
+#define XDD_PREFILL_SLOT_FREE		0	// The buffer may be filled for the next write op
+#define XDD_PREFILL_SLOT_FILLING	1	// The prefill thread is filling the buffer
+#define XDD_PREFILL_SLOT_READY		2	// The buffer holds the data of ps_op_number
+
+/** A buffer of the prefill ring. Op number N uses slot N modulo the number of slots. */
+struct xint_prefill_slot {
+	unsigned char	*ps_bufp;			// The I/O buffer
+	int32_t			ps_state;			// XDD_PREFILL_SLOT_FREE, _FILLING, or _READY
+	int64_t			ps_op_number;		// Op whose data is in the buffer when READY
+	uint64_t		ps_byte_offset;		// Byte offset of that op
+	size_t			ps_xfer_size;		// Number of bytes filled
+};
+typedef struct xint_prefill_slot xint_prefill_slot_t;
+
+/** Write buffer prefill ring of a target used by -prefill */
+struct xint_prefill {
+	int32_t				pf_buffers;			// Number of buffers in the ring
+	int32_t				pf_buf_size;		// Size of each buffer in bytes
+	xint_prefill_slot_t	*pf_slots;			// The ring
+	pthread_t			pf_thread;			// The prefill thread
+	int32_t				pf_started;			// Set once the prefill thread has been created
+	pthread_mutex_t		pf_mutex;			// Serializes access to everything below
+	pthread_cond_t		pf_cond;			// Signaled whenever a slot or the state of the ring changes
+	int32_t				pf_active;			// Set while a pass is running
+	int32_t				pf_shutdown;		// Set to tell the prefill thread to exit
+	int64_t				pf_next_op;			// Next op the prefill thread looks at
+	uint64_t			pf_prefilled;		// Number of buffers handed to Worker Threads already filled
+	uint64_t			pf_inline;			// Number of write ops that had to fill their own buffer
+	uint64_t			pf_waits;			// Number of times a Worker Thread waited for its buffer
+	nclk_t				pf_wait_time;		// Time Worker Threads spent waiting for their buffers
+	nclk_t				pf_fill_time;		// Time the prefill thread spent filling buffers
+	struct xint_target_data	*pf_tdp;		// Target this ring belongs to
+};
+typedef struct xint_prefill xint_prefill_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -22,6 +22,11 @@
 void	xdd_init_seek_list(target_data_t *p);
 void	xdd_save_seek_list(target_data_t *p);
 int32_t	xdd_load_seek_list(target_data_t *p);
+seek_stream_t	*xdd_seek_next_stream(seekhdr_t *sp, int32_t op_index);
+int64_t	xdd_size_distribution_init(target_data_t *tdp);
+int32_t	xdd_size_distribution_pick(target_data_t *tdp, int32_t total_weight);
+seek_size_class_t	*xdd_get_size_class(seekhdr_t *sp, int32_t reqsize);
+seek_extent_t	*xdd_get_seek_extent(seekhdr_t *sp, int64_t op_number);
 
 // barrier.c
 int32_t	xdd_init_barrier_chain(xdd_plan_t* planp);
@@ -31,9 +36,44 @@ int32_t	xdd_init_barrier(xdd_plan_t* planp, struct xdd_barrier *bp, int32_t thre
 void	xdd_destroy_barrier(xdd_plan_t* planp, struct xdd_barrier *bp);
 int32_t	xdd_barrier(struct xdd_barrier *bp, xdd_occupant_t *occupantp, char owner);
 
+// checksum.c
+uint64_t	xdd_checksum_block(int32_t algorithm, const unsigned char *bufp, size_t length);
+char	*xdd_checksum_name(int32_t algorithm);
+int32_t	xdd_checksum_init(target_data_t *tdp);
+void	xdd_checksum_record(worker_data_t *wdp);
+int32_t	xdd_checksum_save(target_data_t *tdp);
+void	xdd_checksum_free(target_data_t *tdp);
+
+// compound.c
+void	xdd_compound_init(target_data_t *tdp);
+int32_t	xdd_compound_rmw_read(worker_data_t *wdp);
+void	xdd_compound_after_io_op(worker_data_t *wdp);
+void	xdd_compound_drain(target_data_t *tdp);
+void	xdd_compound_destroy(target_data_t *tdp);
+void	xdd_compound_display(FILE *out, target_data_t *tdp);
+
 // datapatterns.c
 void	xdd_datapattern_buffer_init(worker_data_t *wdp);
+void	xdd_datapattern_fill_buffer(target_data_t *tdp, unsigned char *bufp, uint64_t byte_offset, size_t xfer_size);
 void	xdd_datapattern_fill(worker_data_t *wdp);
+void	xdd_random_offset_fill(xint_data_pattern_t *dpp, uint64_t key, uint64_t *bufp, uint64_t byte_offset, size_t words);
+void	xdd_random_offset_fill_bytes(xint_data_pattern_t *dpp, uint64_t key, unsigned char *bufp, uint64_t byte_offset, size_t bytes);
+
+// manifest.c
+int32_t	xdd_manifest_init(target_data_t *tdp);
+void	xdd_manifest_record(worker_data_t *wdp);
+void	xdd_manifest_sync(target_data_t *tdp);
+void	xdd_manifest_close(target_data_t *tdp);
+void	xdd_manifest_display(FILE *out, target_data_t *tdp);
+
+// prefill.c
+void	*xdd_prefill_thread(void *data);
+int32_t	xdd_prefill_init(target_data_t *tdp);
+void	xdd_prefill_start_pass(target_data_t *tdp);
+void	xdd_prefill_end_pass(target_data_t *tdp);
+int32_t	xdd_prefill_take(worker_data_t *wdp);
+void	xdd_prefill_destroy(target_data_t *tdp);
+void	xdd_prefill_display(FILE *out, target_data_t *tdp);
 
 // debug.c
 void	xdd_show_plan(xdd_plan_t *planp);
@@ -60,6 +100,10 @@ int32_t	xdd_e2e_dest_receive_data(worker_data_t *wdp);
 int32_t	xdd_e2e_dest_receive_error(worker_data_t *wdp);
 int32_t xdd_e2e_eof_source_side(worker_data_t *wdp);
 int32_t xdd_e2e_eof_destination_side(worker_data_t *wdp);
+int32_t	xdd_e2e_src_check_resend(worker_data_t *wdp);
+int32_t	xdd_e2e_src_wait_eof(worker_data_t *wdp);
+int32_t	xdd_e2e_dest_check(worker_data_t *wdp);
+void	xdd_e2e_checksum_display(FILE *out, target_data_t *tdp);
 
 // end_to_end_init.c
 int32_t	xdd_e2e_target_init(target_data_t *tdp);
@@ -73,6 +117,10 @@ void	xdd_e2e_prt_socket_opts(int skt);
 void	xdd_e2e_err(worker_data_t *wdp, char const *whence, char const *fmt, ...);
 int32_t	xdd_sockets_init(void);
 
+// extent_map.c
+int32_t	xdd_extent_map_init(target_data_t *tdp);
+void	xdd_extent_map_free(target_data_t *tdp);
+
 // global_clock.c
 in_addr_t xdd_init_global_clock_network(char *hostname);
 void	xdd_init_global_clock(nclk_t *nclkp);
@@ -90,6 +138,21 @@ void *xdd_heartbeat(void *data);
 void	xdd_heartbeat_legend(xdd_plan_t* planp, target_data_t *p);
 void	xdd_heartbeat_values(target_data_t *p, int64_t bytes, int64_t ops, double elapsed);
 
+// histogram.c
+nclk_t	xdd_histogram_bucket_low(int index);
+nclk_t	xdd_histogram_bucket_high(int index);
+void	xdd_histogram_reset(xint_histograms_t *hsp);
+xint_histograms_t *xdd_histogram_alloc(int32_t count);
+void	xdd_histogram_format_check(xdd_plan_t *planp);
+int32_t	xdd_histogram_worker_init(worker_data_t *wdp);
+void	xdd_histogram_after_io_op(worker_data_t *wdp);
+void	xdd_histogram_merge(xint_histograms_t *to, xint_histograms_t *from);
+xint_histograms_t *xdd_histogram_target_pass(target_data_t *tdp);
+void	xdd_histogram_target_look(target_data_t *tdp, xint_histogram_look_t *lkp, int pass_end, int64_t *bytesp, int64_t *opsp, xint_histogram_t *ihp);
+nclk_t	xdd_histogram_percentile(xint_histogram_t *hp, double percent);
+void	xdd_histogram_display(FILE *out, target_data_t *tdp, xint_histograms_t *hsp);
+void	xdd_histogram_write(xdd_plan_t *planp);
+
 // info_display.c
 void	xdd_display_kmgt(FILE *out, long long int n, int block_size);
 void	xdd_system_info(xdd_plan_t* planp, FILE *out);
@@ -130,6 +193,8 @@ void	xdd_interactive_show_trace(int32_t tokens, char *cmdline, uint32_t flags, x
 void	xdd_interactive_show_barrier(int32_t tokens, char *cmdline, uint32_t flags, xdd_plan_t *planp);
 
 // io_buffers.c
+unsigned char *xdd_io_buffer_alloc(target_data_t *tdp, int buffer_size);
+void	xdd_io_buffer_free(target_data_t *tdp, unsigned char *bufp, int buffer_size);
 unsigned char *xdd_init_io_buffers(worker_data_t *wdp);
 
 // lockstep.c
@@ -139,6 +204,11 @@ void	xdd_lockstep_before_pass(target_data_t *p);
 int32_t	xdd_lockstep_after_pass(target_data_t *p);
 int32_t xdd_lockstep_check_triggers(worker_data_t *wdp, lockstep_t *lsp);
 
+// metrics.c
+void	xdd_metrics_start(xdd_plan_t *planp);
+void	xdd_metrics_pass_end(xdd_plan_t *planp);
+void	xdd_metrics_stop(xdd_plan_t *planp);
+
 // memory.c
 void	xdd_lock_memory(unsigned char *bp, uint32_t bsize, char *sp);
 void	xdd_unlock_memory(unsigned char *bp, uint32_t bsize, char *sp);
@@ -160,12 +230,19 @@ xint_e2e_t 				*xdd_get_e2ep(void);
 xint_throttle_t 		*xdd_get_throtp(target_data_t *tdp);
 xint_triggers_t 		*xdd_get_trigp(target_data_t *tdp);
 xint_extended_stats_t 	*xdd_get_esp(target_data_t *tdp);
+xint_checksum_t			*xdd_get_csp(target_data_t *tdp);
+xint_manifest_t			*xdd_get_mfp(target_data_t *tdp);
+xint_compound_t			*xdd_get_cop(target_data_t *tdp);
+xint_verify_pool_t		*xdd_get_vpp(target_data_t *tdp);
+xint_prefill_t			*xdd_get_pfp(target_data_t *tdp);
 int32_t					xdd_linux_cpu_count(void);
 int32_t					xdd_cpu_count(void);
 int32_t					xdd_atohex(unsigned char *destp, char *sourcep);
 
 // parse_func.c
 int32_t	xdd_parse_arg_count_check(int32_t args, int32_t argc, char *option);
+int32_t	xdd_parse_size_distribution(seekhdr_t *sp, char *spec);
+int32_t	xdd_parse_seek_streams(seekhdr_t *sp, char *spec);
 
 // nclk.c
 void	nclk_initialize(nclk_t *nclkp);
@@ -192,6 +269,17 @@ void	xdd_calculate_xfer_info(target_data_t *tdp);
 worker_data_t 	*xdd_create_worker_data(target_data_t *tdp, int32_t q);
 void	xdd_build_target_data_substructure(xdd_plan_t* planp);
 void	xdd_build_target_data_substructure_e2e(xdd_plan_t* planp, target_data_t *tdp);
+void	xdd_shared_file_layout(xdd_plan_t *planp);
+
+// worker_state.c
+void	xdd_worker_state_enter(worker_data_t *wdp, uint32_t state);
+void	xdd_worker_state_leave(worker_data_t *wdp, uint32_t state);
+void	xdd_worker_state_task_setup(worker_data_t *wdp);
+void	xdd_worker_state_task_wakeup(worker_data_t *wdp);
+void	xdd_worker_state_before_pass(worker_data_t *wdp);
+void	xdd_worker_state_pass_end(target_data_t *tdp);
+char	*xdd_worker_state_name(int index);
+void	xdd_worker_state_display(FILE *out, target_data_t *tdp);
 
 // worker_thread.c
 void 	*xdd_worker_thread(void *pin);
@@ -209,6 +297,8 @@ int32_t	xdd_worker_thread_release_next_io(worker_data_t *wdp);
 void	xdd_worker_thread_update_local_counters(worker_data_t *wdp);
 void	xdd_worker_thread_update_target_counters(worker_data_t *wdp);
 void	xdd_worker_thread_check_io_status(worker_data_t *wdp);
+int32_t	xdd_sparse_hole_check(worker_data_t *wdp);
+ssize_t	xdd_sparse_punch_hole(worker_data_t *wdp);
 
 // worker_thread_io_for_os.c
 void	xdd_io_for_os(worker_data_t *wdp);
@@ -218,6 +308,7 @@ void	xdd_threshold_after_io_op(worker_data_t *wdp);
 void	xdd_status_after_io_op(worker_data_t *wdp);
 void	xdd_dio_after_io_op(worker_data_t *wdp);
 void	xdd_raw_after_io_op(worker_data_t *wdp);
+void	xdd_verify_after_io_op(worker_data_t *wdp);
 void	xdd_e2e_after_io_op(worker_data_t *wdp);
 void	xdd_extended_stats(worker_data_t *wdp);
 void	xdd_worker_thread_ttd_after_io_op(worker_data_t *wdp);
@@ -287,7 +378,11 @@ void	xdd_results_fmt_e2e_first_read_time(results_t *rp);
 void	xdd_results_fmt_e2e_last_write_time(results_t *rp);
 void	xdd_results_fmt_delimiter(results_t *rp);
 void 	*xdd_results_display(results_t *rp);
-void	xdd_results_format_id_add( char *sp, char *format_stringp  );
+void	xdd_results_format_id_add( char *sp, char **format_stringpp  );
+
+// results_json.c
+void	xdd_results_json_pass(xdd_plan_t *planp, target_data_t *tdp, results_t *trp);
+void	xdd_results_json_run(xdd_plan_t *planp, results_t *crp);
 
 // results_manager.c
 void    *xdd_results_manager(void *data);
@@ -295,6 +390,8 @@ int32_t	xdd_results_manager_init(xdd_plan_t *planp);
 void    *xdd_results_header_display(results_t *tmprp, xdd_plan_t *planp);
 void    *xdd_process_pass_results(xdd_plan_t *planp);
 void    *xdd_process_run_results(xdd_plan_t *planp);
+void    xdd_size_class_results_display(FILE *out, target_data_t *tdp, results_t *tarp);
+void    xdd_extent_results_display(FILE *out, target_data_t *tdp);
 void    xdd_combine_results(results_t *to, results_t *from, xdd_plan_t *planp);
 void    *xdd_extract_pass_results(results_t *rp, target_data_t *p, xdd_plan_t *planp);
 
@@ -308,6 +405,10 @@ int32_t	xdd_sg_read_capacity(worker_data_t *wdp);
 void	xdd_sg_set_reserved_size(target_data_t *tdp, int fd);
 void	xdd_sg_get_version(target_data_t *tdp, int fd);
 
+// shmstats.c
+void	xdd_shmstats_start(xdd_plan_t *planp);
+void	xdd_shmstats_stop(xdd_plan_t *planp);
+
 // signals.c
 void	xdd_signal_handler(int signum, siginfo_t *sip, void *ucp);
 int32_t	xdd_signal_init(xdd_plan_t *planp);
@@ -371,13 +472,38 @@ void	xdd_init_target_data_before_pass(target_data_t *tdp);
 void	xdd_init_worker_data_before_pass(worker_data_t *wdp);
 int32_t	xdd_target_ttd_before_pass(target_data_t *tdp);
 
+// timeseries.c
+void	xdd_timeseries_start(xdd_plan_t *planp);
+void	xdd_timeseries_pass_end(xdd_plan_t *planp);
+void	xdd_timeseries_stop(xdd_plan_t *planp);
+
 // timestamp.c
 void	xdd_ts_overhead(struct xdd_ts_header *ts_hdrp); 
 void	xdd_ts_setup(target_data_t *p);
+xdd_ts_tte_t *xdd_ts_assign_entry(worker_data_t *wdp);
 void	xdd_ts_write(target_data_t *p);
 void	xdd_ts_cleanup(struct xdd_ts_header *ts_hdrp);
 void	xdd_ts_reports(target_data_t *p);
 
+// timestamp_compact.c
+uint16_t	xdd_ts_compact_fields(target_data_t *tdp);
+size_t	xdd_ts_compact_encode(xdd_ts_tte_t *ttep, int64_t count, uint16_t fields, unsigned char *bufp);
+int32_t	xdd_ts_compact_decode(xdd_ts_block_t *tsbp, unsigned char *bufp, xdd_ts_tte_t *ttep);
+int64_t	xdd_ts_compact_write_block(int fd, xdd_ts_tte_t *ttep, int64_t count, uint16_t fields);
+xdd_ts_header_t *xdd_ts_compact_expand(unsigned char *filep, size_t file_size, size_t *sizep);
+
+// timestamp_sample.c
+int64_t	xdd_ts_sample_setup(target_data_t *tdp);
+int32_t	xdd_ts_sample_op(xint_timestamp_t *tsp);
+xdd_ts_tte_t *xdd_ts_sample_skip(worker_data_t *wdp);
+
+// timestamp_stream.c
+int64_t	xdd_ts_stream_setup(target_data_t *tdp);
+xdd_ts_tte_t *xdd_ts_stream_assign(worker_data_t *wdp);
+void	xdd_ts_stream_after_io_op(worker_data_t *wdp);
+int32_t	xdd_ts_stream_start(target_data_t *tdp);
+void	xdd_ts_stream_close(target_data_t *tdp);
+
 // utils.c
 char 	*xdd_getnexttoken(char *tp);
 int 	xdd_tokenize(char *cp);
@@ -388,11 +514,20 @@ double 	xdd_random_float(void);
 int32_t	xdd_verify_checksum(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_hex(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_sequence(worker_data_t *wdp, int64_t current_op);
+int32_t	xdd_verify_random_offset(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_singlechar(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_contents(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify_location(worker_data_t *wdp, int64_t current_op);
 int32_t	xdd_verify(worker_data_t *wdp, int64_t current_op);
 
+// verify_pool.c
+void	*xdd_verify_pool_thread(void *data);
+int32_t	xdd_verify_pool_init(target_data_t *tdp);
+int32_t	xdd_verify_pool_submit(worker_data_t *wdp);
+void	xdd_verify_pool_drain(target_data_t *tdp);
+void	xdd_verify_pool_destroy(target_data_t *tdp);
+void	xdd_verify_pool_display(FILE *out, target_data_t *tdp);
+
 // xdd.c
 int32_t	xdd_start_targets(xdd_plan_t *planp);
 void	xdd_start_results_manager(xdd_plan_t *planp);
@@ -0,0 +1,130 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_SHMSTATS_H
+#define XINT_SHMSTATS_H
+
+/*
+ * Live statistics segment used by -shmstats
+ * An updater thread copies the counters and current state of every target
+ * and Worker Thread into a POSIX shared memory segment every
+ * XINT_SHMSTATS_INTERVAL so that other programs can watch the run by mapping
+ * the segment read-only, e.g. /dev/shm/xdd.<pid> on Linux.
+ *
+ * Layout of the segment:
+ *	xint_shmstats_header_t							at offset 0
+ *	xint_shmstats_target_t[shh_number_of_targets]	at offset shh_header_size
+ *	xint_shmstats_worker_t[shh_number_of_workers]	right after the targets
+ * A reader must use the sizes in the header to step through the records so
+ * that fields added to the end of a record by a later version do not break it.
+ * The Worker Threads of a target are the shs_number_of_workers records
+ * starting at index shs_first_worker.
+ *
+ * Reading a consistent copy:
+ *	1. Read shh_sequence and start over if it is odd (an update is under way)
+ *	2. Copy what is needed
+ *	3. Read shh_sequence again and start over if it changed
+ *
+ * If a segment of the same name already exists xdd leaves it alone, prints
+ * an error, and does the run without live statistics.
+ * The segment name is removed as soon as shh_run_state is set to
+ * XINT_SHMSTATS_RUN_DONE by the last update of a normal exit. A reader that
+ * still has it mapped keeps reading the final values; a reader that opens
+ * the segment by name must treat a missing segment as the end of the run.
+ * All times are in nanoseconds from the start of the run.
+ */
+#define XINT_SHMSTATS_MAGIC			0x58444453	// "XDDS" - first word of the segment
+#define XINT_SHMSTATS_VERSION		1
+#define XINT_SHMSTATS_INTERVAL		(100*MILLION)	// Nanoseconds between updates
+#define XINT_SHMSTATS_NAME_LENGTH	128
+
+#define XINT_SHMSTATS_RUN_STARTING	0	// The targets have not started their first pass
+#define XINT_SHMSTATS_RUN_RUNNING	1	// The targets are doing their passes
+#define XINT_SHMSTATS_RUN_DONE		2	// The run is over and the counters are final
+
+/** Start of the live statistics segment */
+struct xint_shmstats_header {
+	uint32_t			shh_magic;				// XINT_SHMSTATS_MAGIC
+	uint32_t			shh_version;			// XINT_SHMSTATS_VERSION
+	uint32_t			shh_header_size;		// sizeof(xint_shmstats_header_t)
+	uint32_t			shh_target_size;		// sizeof(xint_shmstats_target_t)
+	uint32_t			shh_worker_size;		// sizeof(xint_shmstats_worker_t)
+	int32_t				shh_number_of_targets;
+	int32_t				shh_number_of_workers;
+	int32_t				shh_pid;				// Process ID of xdd
+	volatile uint64_t	shh_sequence;			// Odd while an update is under way
+	uint64_t			shh_update_count;		// Number of updates so far
+	nclk_t				shh_update_time;		// When the last update was done
+	nclk_t				shh_interval;			// Time between updates
+	int32_t				shh_run_state;			// XINT_SHMSTATS_RUN_*
+	int32_t				shh_passes;				// Number of passes of the run
+	char				shh_hostname[XINT_SHMSTATS_NAME_LENGTH];
+};
+typedef struct xint_shmstats_header xint_shmstats_header_t;
+
+/** Live statistics of one target */
+struct xint_shmstats_target {
+	int32_t		shs_target_number;
+	int32_t		shs_pass_number;			// Current pass relative to 1
+	int32_t		shs_queue_depth;
+	int32_t		shs_first_worker;			// Index of the first Worker Thread record of this target
+	int32_t		shs_number_of_workers;
+	int32_t		shs_current_state;			// td_current_state - see TARGET_CURRENT_STATE_*
+	int64_t		shs_bytes;					// Bytes transferred so far this pass
+	int64_t		shs_ops;					// Ops done so far this pass
+	int64_t		shs_target_ops;				// Ops to do each pass
+	nclk_t		shs_pass_start_time;		// When this pass started
+	char		shs_barrier[XDD_BARRIER_MAX_NAME_LENGTH];	// Barrier the Target Thread is in, or empty
+	char		shs_target_name[XINT_SHMSTATS_NAME_LENGTH];	// Possibly shortened from the front
+};
+typedef struct xint_shmstats_target xint_shmstats_target_t;
+
+/** Live statistics of one Worker Thread */
+struct xint_shmstats_worker {
+	int32_t		shw_target_number;
+	int32_t		shw_worker_number;
+	int32_t		shw_thread_id;				// System thread ID
+	uint32_t	shw_current_state;			// wd_current_state - see WORKER_CURRENT_STATE_*
+	int64_t		shw_bytes;					// Bytes transferred so far this pass
+	int64_t		shw_ops;					// Ops done so far this pass
+	int64_t		shw_op_number;				// Op number of the current or last task
+	int64_t		shw_byte_offset;			// Offset of the current or last task
+	char		shw_barrier[XDD_BARRIER_MAX_NAME_LENGTH];	// Barrier the Worker Thread is in, or empty
+};
+typedef struct xint_shmstats_worker xint_shmstats_worker_t;
+
+/** Updater thread of -shmstats */
+struct xint_shmstats {
+	pthread_t					shm_thread;		// The updater thread
+	pthread_mutex_t				shm_mutex;		// Serializes access to shm_shutdown and the segment
+	pthread_cond_t				shm_cond;		// Signaled to tell the updater thread to exit
+	int32_t						shm_shutdown;	// Set to tell the updater thread to exit
+	char						shm_name[XINT_SHMSTATS_NAME_LENGTH];	// Name of the segment
+	size_t						shm_size;		// Size of the segment
+	xint_shmstats_header_t		*shm_hdrp;		// The segment as mapped
+	xint_shmstats_target_t		*shm_targets;
+	xint_shmstats_worker_t		*shm_workers;
+	struct xint_plan			*shm_planp;
+};
+typedef struct xint_shmstats xint_shmstats_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -37,6 +37,7 @@ struct xint_target_counters {
 	nclk_t		tc_current_net_start_time; 		// Start time of the current network op (e2e only)
 	nclk_t		tc_current_net_end_time; 		// End time of the current network op (e2e only)
 	nclk_t		tc_current_net_elapsed_time;	// Elapsed time of the current network op (e2e only)
+	nclk_t		tc_current_pattern_fill_time;	// Time spent filling the data pattern of the current op
 
 	// Accumulated Counters 
 	// Updated in the Target Data structure by each Worker Thread at the completion of an I/O operation
@@ -22,6 +22,10 @@
 #define TASK_OP_TYPE_WRITE		2	// Perform a WRITE operation
 #define TASK_OP_TYPE_NOOP		3	// Perform a NOOP operation
 #define TASK_OP_TYPE_EOF		4	// End-of-File processing when present in the Time Stamp Table
+
+#define TASK_COMPOUND_NONE		0	// A plain op
+#define TASK_COMPOUND_RMW		1	// A WRITE that reads the blocks first
+#define TASK_COMPOUND_READBACK	2	// A WRITE that is read back and checked later
 struct xint_task {
 	char				task_request;				// Type of Task to perform
 	int					task_file_desc;				// File Descriptor
@@ -33,8 +37,12 @@ struct xint_task {
 	off_t				task_byte_offset;			// Offset into the file where this transfer starts
 	uint64_t			task_e2e_sequence_number;	// Sequence number of this task when part of an End-to-End operation
 	nclk_t				task_time_to_issue;			// Time to issue the I/O operation or 0 if not used
+	nclk_t				task_setup_time;			// When the Target Thread set up this task or 0 if not timed
+	nclk_t				task_wakeup_time;			// When the Worker Thread picked up this task
 	ssize_t				task_io_status;				// Returned status of this I/O associated with this task
 	int32_t				task_errno;					// Returned errno of this I/O associated with this task
+	char				task_hole;					// The range of this task is a hole in a sparse file - no data is moved
+	char				task_compound;				// TASK_COMPOUND_NONE, TASK_COMPOUND_RMW, or TASK_COMPOUND_READBACK
 };
 typedef struct xint_task xint_task_t;
 
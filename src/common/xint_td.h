@@ -44,6 +44,9 @@
 #define TO_ORDERING_NETWORK_SERIAL     0x0000100000000000ULL  // Serial Odering method applied to network
 #define TO_ORDERING_STORAGE_LOOSE      0x0000200000000000ULL  // Loose Odering method applied to storage
 #define TO_ORDERING_NETWORK_LOOSE      0x0000400000000000ULL  // Loose Odering method applied to network
+#define TO_SPARSE                      0x0000800000000000ULL  // Skip holes when reading and recreate them on an E2E destination
+#define TO_VERIFY_CHECKSUM             0x0001000000000000ULL  // Checksum each block on write and verify it on read
+#define TO_E2E_CHECKSUM                0x0002000000000000ULL  // End to End - Source puts a CRC32C of the data in each message and resends what the destination asks for
 
 // Per Thread Data Structure - one for each thread 
 struct xint_target_data {
@@ -151,6 +154,9 @@ struct xint_target_data {
 	nclk_t        		td_open_end_time; 			// Time just after the open completes for this target 
 	pthread_mutex_t 	td_counters_mutex; 			// Mutex for locking when updating td_counters
 	struct xint_target_counters	td_counters;		// Pointer to the target counters
+	uint64_t			td_hole_ops;				// Number of ops that found a hole in a sparse file (-sparse) - under td_counters_mutex
+	uint64_t			td_hole_bytes;				// Number of bytes in holes that were skipped rather than read or written
+	uint64_t			td_hole_end;				// Byte offset of the end of the highest hole recreated on an E2E destination
 	struct xint_throttle		*td_throtp;			// Pointer to the throttle sturcture
 	struct xint_e2e				*td_e2ep;			// Pointer to the e2e struct when needed
 	struct xint_extended_stats	*td_esp;			// Extended Stats Structure Pointer
@@ -159,6 +165,12 @@ struct xint_target_data {
 	struct xint_raw				*td_rawp;          	// RAW Data Structure Pointer
 	struct lockstep				*td_lsp;			// Pointer to the lockstep structure used by the lockstep option
 	struct xint_restart			*td_restartp;		// Pointer to the restart structure used by the restart monitor
+	struct xint_checksum		*td_csp;			// Checksum Table Pointer used by -verify checksum
+	struct xint_verify_pool		*td_vpp;			// Verifier thread pool used by -verifythreads
+	struct xint_prefill			*td_pfp;			// Write buffer prefill ring used by -prefill
+	struct xint_manifest		*td_mfp;			// Write manifest used by -manifest
+	struct xint_compound		*td_cop;			// Compound ops used by -op rmw and -op writeverify
+	struct xint_histograms		*td_hgp;			// Latency histograms of the Worker Threads for the last pass
 #if (LINUX || DARWIN)
 	struct stat					td_statbuf;			// Target File Stat buffer used by xdd_target_open()
 #elif (AIX || SOLARIS)
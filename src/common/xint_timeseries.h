@@ -0,0 +1,86 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_TIMESERIES_H
+#define XINT_TIMESERIES_H
+
+/*
+ * Interval statistics used by -timeseries
+ * A writer thread looks at the counters and latency histograms of each target
+ * every interval without locking them, and writes what changed since the last
+ * look as one line of CSV or one binary record per target. The Results Manager
+ * has it look once more at the end of each pass, before the counters and
+ * histograms start over, so the last interval of a pass is usually short.
+ */
+#define XINT_TIMESERIES_MAGIC		0x58545331	// "XTS1" - first word of a binary time series file
+#define XINT_TIMESERIES_VERSION		1
+
+/** Start of a binary time series file */
+struct xint_timeseries_header {
+	uint32_t	tsh_magic;				// XINT_TIMESERIES_MAGIC
+	uint32_t	tsh_version;			// XINT_TIMESERIES_VERSION
+	int32_t		tsh_number_of_targets;	// Number of records per interval
+	int32_t		tsh_record_size;		// sizeof(xint_timeseries_record_t)
+	nclk_t		tsh_interval;			// Interval in nanoseconds
+};
+typedef struct xint_timeseries_header xint_timeseries_header_t;
+
+/** One interval of one target in a binary time series file - all times are in nanoseconds */
+struct xint_timeseries_record {
+	nclk_t		tsr_time;				// End of the interval from the start of the run
+	nclk_t		tsr_interval;			// Length of the interval
+	int32_t		tsr_target_number;
+	int32_t		tsr_pass_number;
+	int64_t		tsr_bytes;				// Bytes transferred during the interval
+	int64_t		tsr_ops;				// Ops done during the interval
+	int64_t		tsr_latency_count;		// Ops whose times went into the latency values
+	nclk_t		tsr_latency_mean;
+	nclk_t		tsr_latency_p50;
+	nclk_t		tsr_latency_p90;
+	nclk_t		tsr_latency_p99;
+	nclk_t		tsr_latency_p999;
+	nclk_t		tsr_latency_max;
+};
+typedef struct xint_timeseries_record xint_timeseries_record_t;
+
+/** What the writer thread saw of a target the last time it looked */
+struct xint_timeseries_target {
+	xint_histogram_look_t	tst_look;	// Counters and op times so far this pass
+};
+typedef struct xint_timeseries_target xint_timeseries_target_t;
+
+/** Writer thread of -timeseries */
+struct xint_timeseries {
+	pthread_t					tsw_thread;		// The writer thread
+	int32_t						tsw_started;	// Set once the writer thread has been created
+	pthread_mutex_t				tsw_mutex;		// Serializes access to tsw_shutdown and the samples
+	pthread_cond_t				tsw_cond;		// Signaled to tell the writer thread to exit
+	int32_t						tsw_shutdown;	// Set to tell the writer thread to exit
+	FILE						*tsw_fp;		// The time series file
+	nclk_t						tsw_last_time;	// When the writer thread last looked
+	xint_histogram_t			tsw_hist;		// Scratch histogram of the ops of one interval
+	xint_timeseries_target_t	*tsw_targets;	// What was seen of each target
+	struct xint_plan			*tsw_planp;
+};
+typedef struct xint_timeseries xint_timeseries_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
@@ -89,7 +89,9 @@ struct xdd_ts_tte {
 // 512 bits 64 bytes
     nclk_t 			tte_net_end;        // The ending time stamp of the net operation (e2e only)
     nclk_t 			tte_net_end_k;      // The ending time stamp of the net operation (e2e only) kernel
-// 520 bits
+// 896 bits 112 bytes
+    nclk_t			tte_task_setup;		// When the Target Thread set up the task of this op
+    nclk_t			tte_worker_wakeup;	// When the Worker Thread picked up the task
 //	struct timeval	usage_utime;	// usage_utime.tv_sec = usage.ru_utime.tv_sec;
 //	struct timeval	usage_stime;	// usage_utime.tv_sec = usage.ru_utime.tv_sec;
 //	long			nvcsw;			// Number of voluntary context switches so far
@@ -127,6 +129,49 @@ struct xdd_ts_header {
 };
 typedef struct xdd_ts_header xdd_ts_header_t;
 
+// The time stamp dump file starts with the header up to but not including tsh_tte[]
+#define XDD_TS_HEADER_SIZE		offsetof(xdd_ts_header_t, tsh_tte)
+
+// Magic numbers of the formats of the dump file
+// The raw magic number changes whenever xdd_ts_tte_t does
+#define XDD_TS_MAGIC			0xDEADBEF0	// The header is followed by an array of xdd_ts_tte_t
+#define XDD_TS_MAGIC_NO_DISPATCH	0xDEADBEEF	// Older raw dump: the entries end before tte_task_setup
+#define XDD_TS_COMPACT_MAGIC	0xDEADBEEC	// The header is followed by compact blocks
+#define XDD_TS_TTE_SIZE_NO_DISPATCH	offsetof(xdd_ts_tte_t, tte_task_setup)	// Size of an entry of an older raw dump
+
+/**
+ * Block of a compact time stamp dump file used by -ts compact
+ * Each block holds entries of a single Worker Thread. The entries follow the
+ * block header as tsb_bytes of varints. Each value is the difference from a
+ * value of the entry before it in the block, or from another value of the
+ * same entry, so that the numbers stay small:
+ *   op type (one byte), pass number, op number, byte offset (from where the
+ *   previous op ended), disk transfer size, disk start, disk end (from the
+ *   disk start), then the processor numbers if XDD_TS_FIELD_CPU, the network
+ *   values if XDD_TS_FIELD_NET, the kernel times if XDD_TS_FIELD_KERNEL, and
+ *   the task setup and wakeup times (from the disk start) if XDD_TS_FIELD_DISPATCH.
+ * Signed differences are zigzag encoded. Fields that are left out read back
+ * as zero.
+ */
+#define XDD_TS_BLOCK_MAGIC		0x54534231	// "TSB1"
+#define XDD_TS_COMPACT_VERSION	1
+#define XDD_TS_FIELD_CPU		0x0001		// Processor numbers
+#define XDD_TS_FIELD_NET		0x0002		// Network transfer size, calls, times, and processors (E2E)
+#define XDD_TS_FIELD_KERNEL		0x0004		// Kernel times
+#define XDD_TS_FIELD_DISPATCH	0x0008		// Task setup and Worker Thread wakeup times
+#define XDD_TS_COMPACT_MAX_ENTRY_BYTES	256	// No entry takes more than this many bytes
+#define XDD_TS_COMPACT_BLOCK_ENTRIES	4096	// Entries per block when the whole table is written
+struct xdd_ts_block {
+	uint32_t	tsb_magic;					// XDD_TS_BLOCK_MAGIC
+	uint16_t	tsb_version;				// XDD_TS_COMPACT_VERSION
+	uint16_t	tsb_fields;					// XDD_TS_FIELD_* bits of the fields in the entries
+	int32_t		tsb_worker_thread_number;	// Worker Thread the entries belong to
+	int32_t		tsb_thread_id;				// Its system thread ID
+	int64_t		tsb_entries;				// Number of entries in the block
+	int64_t		tsb_bytes;					// Number of bytes of entries after the block header
+};
+typedef struct xdd_ts_block xdd_ts_block_t;
+
 /** ts_options bit settings */
 #define TS_NORMALIZE          0x00000001 /**< Time stamping normalization of output*/
 #define TS_ON                 0x00000002 /**< Time stamping is ON */
@@ -142,8 +187,59 @@ typedef struct xdd_ts_header xdd_ts_header_t;
 #define TS_TRIGOP             0x00000800 /**< Time stamp trigger operation number */
 #define TS_TRIGGERED          0x00001000 /**< Time stamping has been triggered */
 #define TS_SUPPRESS_OUTPUT    0x00002000 /**< Suppress timestamp output */
+#define TS_STREAM             0x00004000 /**< Stream the time stamp entries to the dump file during the run */
+#define TS_COMPACT            0x00008000 /**< Write the dump file in the compact format */
 #define DEFAULT_TS_OPTIONS 0x00000000
 
+// Streaming time stamp capture used by -ts stream
+// Instead of a table entry for every op of the run, each Worker Thread fills
+// one scratch entry of the table for its current op and then copies it into
+// a ring of its own. A writer thread of the target empties the rings into the
+// dump file every XDD_TS_STREAM_INTERVAL nanoseconds so that the memory used
+// does not grow with the length of the run. An entry that finds the ring of
+// its Worker Thread full is dropped and counted.
+#define XDD_TS_STREAM_RING_ENTRIES	4096				// Default number of entries in the ring of a Worker Thread
+#define XDD_TS_STREAM_INTERVAL		(100 * MILLION)		// Time between writes of the rings in nanoseconds
+
+/** Ring of the finished time stamp entries of a Worker Thread
+ * Only the Worker Thread moves tr_head and only the writer thread moves
+ * tr_tail so no lock is needed.
+ */
+struct xint_ts_ring {
+	xdd_ts_tte_t		*tr_entries;		// The ring
+	int64_t				tr_size;			// Number of entries in the ring
+	volatile int64_t	tr_head;			// Number of entries put into the ring so far
+	volatile int64_t	tr_tail;			// Number of entries taken out of the ring so far
+	int64_t				tr_dropped;			// Number of entries that found the ring full
+};
+typedef struct xint_ts_ring xint_ts_ring_t;
+
+/** Writer thread of a target that streams the time stamp entries to the dump file */
+struct xint_ts_stream {
+	int					tsw_fd;				// The dump file
+	pthread_t			tsw_thread;			// The writer thread
+	int32_t				tsw_started;		// Set once the writer thread has been created
+	pthread_mutex_t		tsw_mutex;			// Serializes access to tsw_shutdown
+	pthread_cond_t		tsw_cond;			// Signaled to tell the writer thread to exit
+	int32_t				tsw_shutdown;		// Set to tell the writer thread to exit
+	int64_t				tsw_entries;		// Number of entries written to the dump file
+	int64_t				tsw_dropped;		// Number of entries that could not be written plus, once closed, those the rings dropped
+	int64_t				tsw_write_errors;	// Number of writes to the dump file that failed
+	uint16_t			tsw_fields;			// XDD_TS_FIELD_* bits of the compact blocks, 0 for the raw format
+	struct xint_target_data	*tsw_tdp;		// Target this writer belongs to
+};
+typedef struct xint_ts_stream xint_ts_stream_t;
+
+// Sampled time stamping used by -ts sample
+// Only some of the ops get an entry of the time stamp table. The others fill
+// a scratch entry of their Worker Thread that is never kept. The Target Thread
+// only makes the sampling decision when ts_sample_countdown runs out so that
+// most ops cost a single decrement.
+#define XDD_TS_SAMPLE_NONE		0	// Every op is time stamped
+#define XDD_TS_SAMPLE_EVERY		1	// Every ts_sample_every-th op
+#define XDD_TS_SAMPLE_RANDOM	2	// Each op with a probability of ts_sample_percent percent
+#define XDD_TS_SAMPLE_WINDOW	3	// The ops of the first ts_sample_window nanoseconds of every ts_sample_period
+
 // The timestamp structure is pointed to from the Target Data Structure. 
 // There is one timestamp structure for each Target that has timestamping enabled.
 struct xint_timestamp {
@@ -156,6 +252,17 @@ struct xint_timestamp {
 	char				*ts_output_filename; 	// Timestamp report output filename for this Target
 	FILE				*ts_tsfp;   			// Pointer to the time stamp output file 
 	xdd_ts_header_t		*ts_hdrp;				// Pointer to the actual time stamp header and entries
+	int64_t				ts_ring_size;			// Number of entries in the ring of each Worker Thread for -ts stream
+	xint_ts_stream_t	*ts_streamp;			// Writer thread for -ts stream
+	int32_t				ts_sample_mode;			// XDD_TS_SAMPLE_* used by -ts sample
+	int64_t				ts_sample_every;		// Time stamp one op out of this many for XDD_TS_SAMPLE_EVERY
+	double				ts_sample_percent;		// Percentage of the ops to time stamp for XDD_TS_SAMPLE_RANDOM
+	nclk_t				ts_sample_window;		// Length of the window in nanoseconds for XDD_TS_SAMPLE_WINDOW
+	nclk_t				ts_sample_period;		// Time from the start of one window to the next in nanoseconds
+	nclk_t				ts_sample_window_start;	// Start of the current window, 0 before the first op
+	int64_t				ts_sample_countdown;	// Number of ops until the next sampling decision
+	unsigned short		ts_sample_xsubi[3];		// Random number state for XDD_TS_SAMPLE_RANDOM
+	int64_t				ts_scratch_entry;		// First of the scratch entries of the ops that are not sampled
 };
 typedef struct xint_timestamp xint_timestamp_t;
 
@@ -0,0 +1,60 @@
+/*
+ * XDD - a data movement and benchmarking toolkit
+ *
+ * Copyright (C) 1992-2013 I/O Performance, Inc.
+ * Copyright (C) 2009-2013 UT-Battelle, LLC
+ *
+ * This is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License version 2, as published by the Free Software
+ * Foundation.  See file COPYING.
+ *
+ */
+#ifndef XINT_VERIFY_POOL_H
+#define XINT_VERIFY_POOL_H
+
+#define XDD_VERIFY_POOL_BUFFERS_PER_THREAD	2	// Default number of spare I/O buffers per verifier thread
+
+/** A read buffer handed from a Worker Thread to the verifier threads.
+ * When the job is on the free list vj_bufp is a spare I/O buffer. */
+struct xint_verify_job {
+	struct xint_verify_job	*vj_nextp;		// Next job on the free list or the work queue
+	unsigned char			*vj_bufp;		// I/O buffer - the data of vj_task or a spare buffer
+	struct xint_task		vj_task;		// Copy of the task that read the data into the buffer
+	int32_t					vj_worker_number;	// Worker Thread that read the data
+};
+typedef struct xint_verify_job xint_verify_job_t;
+
+/** Verifier thread pool of a target used by -verifythreads */
+struct xint_verify_pool {
+	int32_t				vp_threads;			// Number of verifier threads
+	int32_t				vp_buffers;			// Number of spare I/O buffers
+	int					vp_buf_size;		// Size in bytes of each spare I/O buffer
+	pthread_t			*vp_threadp;		// The verifier threads
+	xint_verify_job_t	*vp_jobs;			// Array of vp_buffers jobs
+	pthread_mutex_t		vp_mutex;			// Serializes access to everything below
+	pthread_cond_t		vp_work_cond;		// Signaled when a job is queued or the pool shuts down
+	pthread_cond_t		vp_free_cond;		// Signaled when a job goes back on the free list
+	xint_verify_job_t	*vp_freep;			// Jobs with a spare buffer
+	xint_verify_job_t	*vp_headp;			// Oldest job waiting to be verified
+	xint_verify_job_t	*vp_tailp;			// Newest job waiting to be verified
+	int32_t				vp_pending;			// Jobs queued or being verified
+	int32_t				vp_shutdown;		// Set to tell the verifier threads to exit
+	uint64_t			vp_verified;		// Number of buffers verified
+	uint64_t			vp_waits;			// Number of times a Worker Thread waited for a spare buffer
+	nclk_t				vp_wait_time;		// Time Worker Threads spent waiting for a spare buffer
+	struct xint_target_data	*vp_tdp;		// Target this pool belongs to
+};
+typedef struct xint_verify_pool xint_verify_pool_t;
+
+#endif
+/*
+ * Local variables:
+ *  indent-tabs-mode: t
+ *  default-tab-width: 4
+ *  c-indent-level: 4
+ *  c-basic-offset: 4
+ * End:
+ *
+ * vim: ts=4 sts=4 sw=4 noexpandtab
+ */
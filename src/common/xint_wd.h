@@ -23,7 +23,10 @@ struct xint_worker_data {
 	int32_t   					wd_pid;   			// My process ID 
 	unsigned char				*wd_bufp;			// Pointer to the generic I/O buffer
 	int							wd_buf_size;		// Size in bytes of the generic I/O buffer
+	int32_t						wd_buf_pattern_stale;	// Set when wd_bufp was traded for a buffer that does not hold the data pattern
 	int64_t						wd_ts_entry;		// The TimeStamp entry to use when time-stamping an operation
+	struct xint_ts_ring			*wd_ts_ringp;		// Ring of finished TimeStamp entries used by -ts stream
+	int32_t						wd_ts_skip;			// Set when the current op is not sampled by -ts sample and its entry is not kept
 	struct xint_task			wd_task;			// Task Structure
 	struct xint_target_counters	wd_counters;		// Counters specific to this worker for this target
 
@@ -41,6 +44,10 @@ struct xint_worker_data {
 	char						wd_occupant_name[XDD_BARRIER_MAX_NAME_LENGTH];	// For a Target thread this is "TARGET####", for a Worker_Thread it is "TARGET####WORKER####"
 	tot_wait_t					wd_tot_wait;		// The TOT Wait structure for this worker
 	xint_e2e_t					*wd_e2ep;			// Pointer to the e2e struct when needed
+	struct xint_compound_worker	*wd_cwp;			// Compound op state used by -op rmw and -op writeverify
+	uint64_t					*wd_manifest_sums;	// Checksums of the blocks of a write used by -manifest - sized for the I/O buffer
+	struct xint_histograms		*wd_hgp;			// Latency histograms of this Worker Thread used by -histogram
+	struct xint_histograms		*wd_run_hgp;		// Latency histograms of this Worker Thread over the run for the -histogram file
 	xdd_sgio_t					*wd_sgiop;			// SGIO Structure Pointer
 	pthread_mutex_t 			wd_current_state_mutex; 	// Mutex for locking when checking or updating the state info
 	uint32_t					wd_current_state;			// State of this thread at any given time (see Current State definitions below)
@@ -54,6 +61,19 @@ struct xint_worker_data {
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_RELEASE		0x00000040	// Worker Thread is waiting for the TOT lock in order to release the next I/O
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_TS				0x00000080	// Worker Thread is waiting for the TOT lock to set the "wait" time stamp
 #define	WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO				0x00000100	// Waiting on the previous I/O op semaphore
+	// Time spent in each state, kept by xdd_worker_state_enter() and xdd_worker_state_leave() for -statetimes.
+	// A Worker Thread in more than one state at once is charged to the first state below that applies.
+#define	WORKER_STATE_TIME_BUSY			0	// In none of the states below - doing the work of xdd itself
+#define	WORKER_STATE_TIME_IO			1	// WORKER_CURRENT_STATE_IO
+#define	WORKER_STATE_TIME_DEST_RECEIVE	2	// WORKER_CURRENT_STATE_DEST_RECEIVE
+#define	WORKER_STATE_TIME_SRC_SEND		3	// WORKER_CURRENT_STATE_SRC_SEND
+#define	WORKER_STATE_TIME_PREVIOUS_IO	4	// WORKER_CURRENT_STATE_WT_WAITING_FOR_PREVIOUS_IO - serial or loose ordering
+#define	WORKER_STATE_TIME_TOT_LOCK		5	// Any of WORKER_CURRENT_STATE_WT_WAITING_FOR_TOT_LOCK_*
+#define	WORKER_STATE_TIME_BARRIER		6	// WORKER_CURRENT_STATE_BARRIER - mostly waiting for the Target Thread to hand out a task
+#define	WORKER_STATE_TIMES				7	// Number of state times
+	nclk_t						wd_state_time_stamp;		// When the Worker Thread last entered or left a state
+	nclk_t						wd_state_time[WORKER_STATE_TIMES];			// Time in each state this pass
+	nclk_t						wd_state_time_total[WORKER_STATE_TIMES];	// Time in each state over the passes done so far
 };
 typedef struct xint_worker_data worker_data_t;
 
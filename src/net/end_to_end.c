@@ -79,7 +79,10 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	e2ehp->e2eh_byte_offset = wdp->wd_task.task_byte_offset;
 	e2ehp->e2eh_data_length = wdp->wd_task.task_xfer_size;
 
-	e2ep->e2e_xfer_size = sizeof(xdd_e2e_header_t) + e2ehp->e2eh_data_length;
+	// A hole is described by the header alone
+	if (e2ehp->e2eh_magic == XDD_E2E_HOLE)
+		e2ep->e2e_xfer_size = sizeof(xdd_e2e_header_t);
+	else e2ep->e2e_xfer_size = sizeof(xdd_e2e_header_t) + e2ehp->e2eh_data_length;
 
     custom_hton(&(e2ehp->e2eh_magic), sizeof(e2ehp->e2eh_magic));
     custom_hton(&(e2ehp->e2eh_worker_thread_number), sizeof(e2ehp->e2eh_worker_thread_number));
@@ -88,6 +91,8 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
     custom_hton(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
     custom_hton(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
     custom_hton(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+    custom_hton(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+    custom_hton(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
 
 	
 	// The message header for this data packet precedes the data portion
@@ -138,6 +143,8 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
     custom_ntoh(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
     custom_ntoh(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
     custom_ntoh(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+    custom_ntoh(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+    custom_ntoh(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
 
 
 	
@@ -266,6 +273,7 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 			}
 
 			nclk_now(&wdp->wd_counters.tc_current_net_start_time);
+			e2ep->e2e_last_csd = e2ep->e2e_csd[e2ep->e2e_current_csd];
 
 			// Read in the E2E Header 
 			bytes_received = 0;
@@ -313,6 +321,8 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
     custom_ntoh(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
     custom_ntoh(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
     custom_ntoh(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+    custom_ntoh(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+    custom_ntoh(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
 
 
 
@@ -343,16 +353,17 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 		return(-1);
 	}
 
-	if ((e2ehp->e2eh_magic != XDD_E2E_DATA_READY) && (e2ehp->e2eh_magic != XDD_E2E_EOF)) {
+	if ((e2ehp->e2eh_magic != XDD_E2E_DATA_READY) && (e2ehp->e2eh_magic != XDD_E2E_EOF) && (e2ehp->e2eh_magic != XDD_E2E_HOLE)) {
 		// Invalid E2E Header - bad magic number
-		fprintf(xgp->errout,"\n%s: xdd_e2e_dest_receive_header: Target %d Worker: %d: ERROR: Bad magic number 0x%08x on recv %d - should be either 0x%08x or 0x%08x\n",
+		fprintf(xgp->errout,"\n%s: xdd_e2e_dest_receive_header: Target %d Worker: %d: ERROR: Bad magic number 0x%08x on recv %d - should be 0x%08x, 0x%08x, or 0x%08x\n",
 			xgp->progname,
 			tdp->td_target_number,
 			wdp->wd_worker_number,
 			e2ehp->e2eh_magic, 
 			e2ep->e2e_msg_recv,
 			XDD_E2E_DATA_READY, 
-			XDD_E2E_EOF);
+			XDD_E2E_EOF,
+			XDD_E2E_HOLE);
 		return(-1);
 	}
 
@@ -636,6 +647,9 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 	e2ehp->e2eh_byte_offset = -1; // NA
 	e2ehp->e2eh_data_length = 0;	// NA - no data being sent other than the header
 	e2ehp->e2eh_magic = XDD_E2E_EOF;
+	// With checksums on, the destination answers the EOF once it has all the data it asked to be sent again
+	e2ehp->e2eh_flags = (tdp->td_target_options & TO_E2E_CHECKSUM) ? XDD_E2E_FLAG_CRC : 0;
+	e2ehp->e2eh_data_crc = 0;
 	memcpy(e2ehp->e2eh_cookie, tdp->td_magic_cookie, sizeof(e2ehp->e2eh_cookie));
 	
 	custom_hton(&(e2ehp->e2eh_magic), sizeof(e2ehp->e2eh_magic));
@@ -645,6 +659,8 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
     custom_hton(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
     custom_hton(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
     custom_hton(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+    custom_hton(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+    custom_hton(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
 
 
 	if (tdp->td_ts_table.ts_options & (TS_ON | TS_TRIGGERED)) {
@@ -677,6 +693,8 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 			custom_ntoh(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
 			custom_ntoh(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
 			custom_ntoh(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+			custom_ntoh(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+			custom_ntoh(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
 
 		
 			xdd_e2e_err(wdp,"xdd_e2e_eof_source_side","ERROR: error sending EOF to destination\n");
@@ -711,6 +729,8 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
     custom_ntoh(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
     custom_ntoh(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
     custom_ntoh(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+    custom_ntoh(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+    custom_ntoh(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
 
 
 	if (bytes_sent != e2ep->e2e_header_size) {
@@ -718,9 +738,329 @@ if (xgp->global_options & GO_DEBUG_E2E) fprintf(stderr,"DEBUG_E2E: %lld: xdd_e2e
 		return(-1);
 	}
 
+	// Send again whatever the destination still asks for until it answers the EOF
+	if (tdp->td_target_options & TO_E2E_CHECKSUM)
+		return(xdd_e2e_src_wait_eof(wdp));
+
 	return(0);
 } /* end of xdd_e2e_eof_source_side() */
 
+/*----------------------------------------------------------------------*/
+/* Data checksums - -e2e checksum
+ * The source puts a CRC32C of the data of each message in its header.
+ * The destination checks it before the data is written. A message that
+ * does not match is dropped and an XDD_E2E_RESEND message goes back to the
+ * source on the same connection asking for the data to be sent again. The
+ * source reads the file again and sends it flagged XDD_E2E_FLAG_RESENT.
+ * The EOF of the source is flagged XDD_E2E_FLAG_CRC as well and the
+ * destination answers it with an EOF of its own only once every message
+ * it asked for has arrived intact. Until then the source keeps answering
+ * requests and sends a new EOF after each one.
+ */
+static void
+xdd_e2e_hton_header(xdd_e2e_header_t *e2ehp) {
+	custom_hton(&(e2ehp->e2eh_magic), sizeof(e2ehp->e2eh_magic));
+	custom_hton(&(e2ehp->e2eh_worker_thread_number), sizeof(e2ehp->e2eh_worker_thread_number));
+	custom_hton(&(e2ehp->e2eh_sequence_number), sizeof(e2ehp->e2eh_sequence_number));
+	custom_hton(&(e2ehp->e2eh_send_time), sizeof(e2ehp->e2eh_send_time));
+	custom_hton(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
+	custom_hton(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
+	custom_hton(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+	custom_hton(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+	custom_hton(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
+} /* end of xdd_e2e_hton_header() */
+
+static void
+xdd_e2e_ntoh_header(xdd_e2e_header_t *e2ehp) {
+	custom_ntoh(&(e2ehp->e2eh_magic), sizeof(e2ehp->e2eh_magic));
+	custom_ntoh(&(e2ehp->e2eh_worker_thread_number), sizeof(e2ehp->e2eh_worker_thread_number));
+	custom_ntoh(&(e2ehp->e2eh_sequence_number), sizeof(e2ehp->e2eh_sequence_number));
+	custom_ntoh(&(e2ehp->e2eh_send_time), sizeof(e2ehp->e2eh_send_time));
+	custom_ntoh(&(e2ehp->e2eh_recv_time), sizeof(e2ehp->e2eh_recv_time));
+	custom_ntoh(&(e2ehp->e2eh_byte_offset), sizeof(e2ehp->e2eh_byte_offset));
+	custom_ntoh(&(e2ehp->e2eh_data_length), sizeof(e2ehp->e2eh_data_length));
+	custom_ntoh(&(e2ehp->e2eh_flags), sizeof(e2ehp->e2eh_flags));
+	custom_ntoh(&(e2ehp->e2eh_data_crc), sizeof(e2ehp->e2eh_data_crc));
+} /* end of xdd_e2e_ntoh_header() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_send_message() - Send a header and the size-sizeof(header) bytes
+ * of data that follow it on the given socket. The header is left in host
+ * byte order.
+ * Return values: 0 is good, -1 is bad
+ */
+static int32_t
+xdd_e2e_send_message(worker_data_t *wdp, sd_t sd, xdd_e2e_header_t *e2ehp, int size, char const *whence) {
+	int				bytes_sent;		// Cumulative number of bytes sent
+	int				status;			// Status of the send() call
+	unsigned char	*bufp;
+
+
+	xdd_e2e_hton_header(e2ehp);
+	bytes_sent = 0;
+	bufp = (unsigned char *)e2ehp;
+	while (bytes_sent < size) {
+		status = send(sd, bufp + bytes_sent, size - bytes_sent, 0);
+		if (status <= 0) 
+			break;
+		bytes_sent += status;
+	}
+	xdd_e2e_ntoh_header(e2ehp);
+	if (bytes_sent != size) {
+		xdd_e2e_err(wdp,whence,"ERROR: error sending a message for the E2E data checksums\n");
+		return(-1);
+	}
+	return(0);
+} /* end of xdd_e2e_send_message() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_receive_reply() - Receive a header-only message on the given
+ * socket and check its cookie. With MSG_DONTWAIT in flags nothing is read
+ * unless a whole header is already there.
+ * Return values: 1 if a header was received, 0 if there was none waiting,
+ *                -1 is bad
+ */
+static int32_t
+xdd_e2e_receive_reply(worker_data_t *wdp, sd_t sd, xdd_e2e_header_t *e2ehp, int flags) {
+	target_data_t	*tdp;
+	int				status;			// Status of the recv() call
+
+
+	tdp = wdp->wd_tdp;
+	if (flags & MSG_DONTWAIT) {
+		status = recv(sd, e2ehp, sizeof(xdd_e2e_header_t), MSG_PEEK | MSG_DONTWAIT);
+		if ((status < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+			return(0);
+		if ((status > 0) && (status < (int)sizeof(xdd_e2e_header_t)))
+			return(0);
+	}
+	status = recv(sd, e2ehp, sizeof(xdd_e2e_header_t), MSG_WAITALL);
+	if (status != (int)sizeof(xdd_e2e_header_t)) {
+		xdd_e2e_err(wdp,"xdd_e2e_receive_reply","ERROR: error receiving a message for the E2E data checksums\n");
+		return(-1);
+	}
+	xdd_e2e_ntoh_header(e2ehp);
+	if (memcmp(e2ehp->e2eh_cookie, tdp->td_magic_cookie, sizeof(e2ehp->e2eh_cookie))) {
+		fprintf(xgp->errout,"\n%s: xdd_e2e_receive_reply: Target %d Worker: %d: ERROR: Bad magic cookie\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number);
+		return(-1);
+	}
+	return(1);
+} /* end of xdd_e2e_receive_reply() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_src_resend() - Read the data a resend request asks for from the
+ * source file again and send it to the destination. The I/O buffer of the
+ * Worker Thread is free at this point.
+ * Return values: 0 is good, -1 is bad
+ */
+static int32_t
+xdd_e2e_src_resend(worker_data_t *wdp, xdd_e2e_header_t *reqp) {
+	target_data_t		*tdp;
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	xdd_e2e_header_t	*e2ehp;		// Pointer to the E2E Header
+	ssize_t				status;
+
+
+	tdp = wdp->wd_tdp;
+	e2ep = wdp->wd_e2ep;
+	e2ehp = e2ep->e2e_hdrp;
+	if ((reqp->e2eh_data_length <= 0) || (reqp->e2eh_data_length > (int64_t)(wdp->wd_buf_size - getpagesize()))) {
+		fprintf(xgp->errout,"\n%s: xdd_e2e_src_resend: Target %d Worker: %d: ERROR: Bad length %lld in a resend request\n",
+			xgp->progname,
+			tdp->td_target_number,
+			wdp->wd_worker_number,
+			(long long int)reqp->e2eh_data_length);
+		return(-1);
+	}
+	status = pread(tdp->td_file_desc, e2ep->e2e_datap, reqp->e2eh_data_length, reqp->e2eh_byte_offset);
+	if (status != reqp->e2eh_data_length) {
+		xdd_e2e_err(wdp,"xdd_e2e_src_resend","ERROR: could not read the data the destination asked for again\n");
+		return(-1);
+	}
+	memcpy(e2ehp->e2eh_cookie, tdp->td_magic_cookie, sizeof(e2ehp->e2eh_cookie));
+	e2ehp->e2eh_magic = XDD_E2E_DATA_READY;
+	e2ehp->e2eh_worker_thread_number = wdp->wd_worker_number;
+	e2ehp->e2eh_sequence_number = reqp->e2eh_sequence_number;
+	e2ehp->e2eh_byte_offset = reqp->e2eh_byte_offset;
+	e2ehp->e2eh_data_length = reqp->e2eh_data_length;
+	e2ehp->e2eh_flags = XDD_E2E_FLAG_CRC | XDD_E2E_FLAG_RESENT;
+	e2ehp->e2eh_data_crc = (uint32_t)xdd_checksum_block(XDD_CHECKSUM_CRC32C, e2ep->e2e_datap, reqp->e2eh_data_length);
+	if (xdd_e2e_send_message(wdp, e2ep->e2e_sd, e2ehp, sizeof(xdd_e2e_header_t) + reqp->e2eh_data_length, "xdd_e2e_src_resend"))
+		return(-1);
+	pthread_mutex_lock(&tdp->td_counters_mutex);
+	tdp->td_e2ep->e2e_resends++;
+	pthread_mutex_unlock(&tdp->td_counters_mutex);
+	return(0);
+} /* end of xdd_e2e_src_resend() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_src_check_resend() - Answer the resend requests that the
+ * destination has sent so far without waiting for more.
+ * This is called by the source Worker Thread after each send.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_e2e_src_check_resend(worker_data_t *wdp) {
+	xdd_e2e_header_t	req;		// The request from the destination
+	int32_t				status;
+
+
+	for (;;) {
+		status = xdd_e2e_receive_reply(wdp, wdp->wd_e2ep->e2e_sd, &req, MSG_DONTWAIT);
+		if (status <= 0)
+			return(status);
+		if (req.e2eh_magic != XDD_E2E_RESEND) {
+			fprintf(xgp->errout,"\n%s: xdd_e2e_src_check_resend: Target %d Worker: %d: ERROR: Unexpected message 0x%08x from the destination\n",
+				xgp->progname,
+				wdp->wd_tdp->td_target_number,
+				wdp->wd_worker_number,
+				req.e2eh_magic);
+			return(-1);
+		}
+		if (xdd_e2e_src_resend(wdp, &req))
+			return(-1);
+	}
+} /* end of xdd_e2e_src_check_resend() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_src_wait_eof() - Wait for the destination to answer the EOF,
+ * sending again whatever it asks for in the meantime followed by another
+ * EOF each time.
+ * Return values: 0 is good, -1 is bad
+ */
+int32_t
+xdd_e2e_src_wait_eof(worker_data_t *wdp) {
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	xdd_e2e_header_t	req;		// The request from the destination
+	xdd_e2e_header_t	eof;		// The EOF that follows each resend
+
+
+	e2ep = wdp->wd_e2ep;
+	for (;;) {
+		if (xdd_e2e_receive_reply(wdp, e2ep->e2e_sd, &req, 0) < 0)
+			return(-1);
+		if (req.e2eh_magic == XDD_E2E_EOF)
+			return(0);
+		if (req.e2eh_magic != XDD_E2E_RESEND) {
+			fprintf(xgp->errout,"\n%s: xdd_e2e_src_wait_eof: Target %d Worker: %d: ERROR: Unexpected message 0x%08x from the destination\n",
+				xgp->progname,
+				wdp->wd_tdp->td_target_number,
+				wdp->wd_worker_number,
+				req.e2eh_magic);
+			return(-1);
+		}
+		if (xdd_e2e_src_resend(wdp, &req))
+			return(-1);
+		memcpy(&eof, e2ep->e2e_hdrp, sizeof(eof));
+		eof.e2eh_magic = XDD_E2E_EOF;
+		eof.e2eh_byte_offset = -1;
+		eof.e2eh_data_length = 0;
+		eof.e2eh_flags = XDD_E2E_FLAG_CRC;
+		eof.e2eh_data_crc = 0;
+		if (xdd_e2e_send_message(wdp, e2ep->e2e_sd, &eof, sizeof(eof), "xdd_e2e_src_wait_eof"))
+			return(-1);
+	}
+} /* end of xdd_e2e_src_wait_eof() */
+
+/*----------------------------------------------------------------------*/
+/* xdd_e2e_dest_check() - Check the data of the message just received
+ * against its CRC32C, asking for it again if it does not match, and
+ * answer a flagged EOF once nothing is outstanding.
+ * Messages without XDD_E2E_FLAG_CRC are passed as they are.
+ * Return values: 0 if the message is to be used, 1 if it was dropped and
+ *                the next message has to be received in its place,
+ *                -1 is bad
+ */
+int32_t
+xdd_e2e_dest_check(worker_data_t *wdp) {
+	target_data_t		*tdp;
+	xint_e2e_t			*e2ep;		// Pointer to the E2E data struct
+	xdd_e2e_header_t	*e2ehp;		// Pointer to the E2E Header
+	xdd_e2e_header_t	reply;		// The resend request or the answer to the EOF
+	uint32_t			crc;
+
+
+	tdp = wdp->wd_tdp;
+	e2ep = wdp->wd_e2ep;
+	e2ehp = e2ep->e2e_hdrp;
+	if (PLAN_ENABLE_XNI & tdp->td_planp->plan_options) {
+		// XNI has no way back to the source so a bad message can only be reported
+		if ((e2ehp->e2eh_magic != XDD_E2E_DATA_READY) || !(e2ehp->e2eh_flags & XDD_E2E_FLAG_CRC))
+			return(0);
+	} else if (!(e2ehp->e2eh_flags & XDD_E2E_FLAG_CRC)) {
+		return(0);
+	} else if (e2ehp->e2eh_magic == XDD_E2E_EOF) {
+		if (e2ep->e2e_resends_outstanding > 0)
+			return(1); // The source sends another EOF after the data asked for
+		memcpy(&reply, e2ehp, sizeof(reply));
+		memcpy(reply.e2eh_cookie, tdp->td_magic_cookie, sizeof(reply.e2eh_cookie));
+		reply.e2eh_worker_thread_number = wdp->wd_worker_number;
+		if (xdd_e2e_send_message(wdp, e2ep->e2e_last_csd, &reply, sizeof(reply), "xdd_e2e_dest_check"))
+			return(-1);
+		return(0);
+	} else if (e2ehp->e2eh_magic != XDD_E2E_DATA_READY) {
+		return(0);
+	}
+
+	crc = (uint32_t)xdd_checksum_block(XDD_CHECKSUM_CRC32C, e2ep->e2e_datap, e2ehp->e2eh_data_length);
+	pthread_mutex_lock(&tdp->td_counters_mutex);
+	tdp->td_e2ep->e2e_crc_msgs++;
+	if (crc != e2ehp->e2eh_data_crc)
+		tdp->td_e2ep->e2e_crc_errors++;
+	else if (e2ehp->e2eh_flags & XDD_E2E_FLAG_RESENT)
+		tdp->td_e2ep->e2e_resends++;
+	pthread_mutex_unlock(&tdp->td_counters_mutex);
+	if (crc == e2ehp->e2eh_data_crc) {
+		if (e2ehp->e2eh_flags & XDD_E2E_FLAG_RESENT)
+			e2ep->e2e_resends_outstanding--;
+		return(0);
+	}
+
+	fprintf(xgp->errout,"%s: xdd_e2e_dest_check: Target %d Worker: %d: ERROR: CRC32C of the %lld bytes of data at byte offset %lld is 0x%08x instead of 0x%08x%s\n",
+		xgp->progname,
+		tdp->td_target_number,
+		wdp->wd_worker_number,
+		(long long int)e2ehp->e2eh_data_length,
+		(long long int)e2ehp->e2eh_byte_offset,
+		crc,
+		e2ehp->e2eh_data_crc,
+		(PLAN_ENABLE_XNI & tdp->td_planp->plan_options) ? " - cannot ask for it again over XNI" : " - asking for it again");
+	if (PLAN_ENABLE_XNI & tdp->td_planp->plan_options)
+		return(-1);
+
+	// A resent message that is bad again is still the same one outstanding
+	if (!(e2ehp->e2eh_flags & XDD_E2E_FLAG_RESENT))
+		e2ep->e2e_resends_outstanding++;
+	memcpy(&reply, e2ehp, sizeof(reply));
+	memcpy(reply.e2eh_cookie, tdp->td_magic_cookie, sizeof(reply.e2eh_cookie));
+	reply.e2eh_magic = XDD_E2E_RESEND;
+	reply.e2eh_worker_thread_number = wdp->wd_worker_number;
+	reply.e2eh_flags = 0;
+	reply.e2eh_data_crc = 0;
+	if (xdd_e2e_send_message(wdp, e2ep->e2e_last_csd, &reply, sizeof(reply), "xdd_e2e_dest_check"))
+		return(-1);
+	return(1);
+} /* end of xdd_e2e_dest_check() */
+
+/*----------------------------------------------------------------------------*/
+/* xdd_e2e_checksum_display() - Display how many E2E messages of a target had
+ * their data checked over the run and how many had to be sent again
+ * Called by xdd_process_run_results()
+ */
+void
+xdd_e2e_checksum_display(FILE *out, target_data_t *tdp) {
+	xint_e2e_t	*e2ep;
+
+
+	e2ep = tdp->td_e2ep;
+	fprintf(out,"Target %d e2e checksums, %lld, messages checked, %lld, CRC errors, %lld, messages resent\n",
+		tdp->td_target_number, (long long int)e2ep->e2e_crc_msgs,
+		(long long int)e2ep->e2e_crc_errors, (long long int)e2ep->e2e_resends);
+} /* end of xdd_e2e_checksum_display() */
+
 /*
  * Local variables:
  *  indent-tabs-mode: t
@@ -170,6 +170,8 @@ xdd_e2e_src_init(worker_data_t *wdp) {
 	e2ep->e2e_hdrp->e2eh_recv_time = 0;
 	e2ep->e2e_hdrp->e2eh_byte_offset = 0;
 	e2ep->e2e_hdrp->e2eh_data_length = 0;
+	e2ep->e2e_hdrp->e2eh_flags = 0;
+	e2ep->e2e_hdrp->e2eh_data_crc = 0;
 
 
 	return(0);
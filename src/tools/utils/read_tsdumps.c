@@ -46,9 +46,6 @@
 #define NET_END     offsetof(xdd_ts_tte_t, tte_net_end)
 #define NET_XFER    offsetof(xdd_ts_tte_t, tte_net_xfer_size)
 
-/* magic number to make sure we can read the file */
-#define BIN_MAGIC_NUMBER 0xDEADBEEF
-
 #define MAX_WORKER_THREADS 1024
 int thread_id_src[MAX_WORKER_THREADS];
 int thread_id_dst[MAX_WORKER_THREADS];
@@ -786,6 +783,11 @@ int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size)
 		return 0;
 	}
 
+	if (tsize < XDD_TS_HEADER_SIZE) {
+		fprintf(stderr,"File is too short: %s\n",filename);
+		return 0;
+	}
+
 	/* check magic number in xdd_ts_header_t */
 	result = fread(&magic,sizeof(uint32_t),1,tsfd);
 	fseek(tsfd,0,SEEK_SET);
@@ -794,8 +796,8 @@ int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size)
 		fprintf(stderr,"Error reading file: %s\n",filename);
 		return 0;
 	}
-	if (magic != BIN_MAGIC_NUMBER) {
-		fprintf(stderr,"File is not in a readable format: %s\n",filename);
+	if (magic != XDD_TS_MAGIC && magic != XDD_TS_MAGIC_NO_DISPATCH && magic != XDD_TS_COMPACT_MAGIC) {
+		fprintf(stderr,"File is not in a readable format (magic number 0x%08x): %s\n",magic,filename);
 		return 0;
 	}
 
@@ -807,6 +809,44 @@ int xdd_readfile(char *filename, xdd_ts_header_t **tsdata, size_t *tsdata_size)
 		return 0;
 	}
 
+	/* turn the blocks of a compact dump into the array of entries */
+	if (magic == XDD_TS_COMPACT_MAGIC) {
+		xdd_ts_header_t *cdata = xdd_ts_compact_expand((unsigned char *)tdata, tsize, &tsize);
+		free(tdata);
+		if (cdata == NULL) {
+			fprintf(stderr,"Compact timestamp dump is damaged or too big: %s\n",filename);
+			return 0;
+		}
+		tdata = cdata;
+	}
+
+	/* widen the shorter entries of an older raw dump - the times they lack read back as zero */
+	if (magic == XDD_TS_MAGIC_NO_DISPATCH) {
+		size_t nents = (tsize - XDD_TS_HEADER_SIZE) / XDD_TS_TTE_SIZE_NO_DISPATCH;
+		size_t i;
+		xdd_ts_header_t *wdata = calloc(1, XDD_TS_HEADER_SIZE + (nents * sizeof(xdd_ts_tte_t)));
+		if (wdata == NULL) {
+			fprintf(stderr,"Could not allocate memory for file: %s\n",filename);
+			free(tdata);
+			return 0;
+		}
+		memcpy(wdata, tdata, XDD_TS_HEADER_SIZE);
+		for (i = 0; i < nents; i++)
+			memcpy(&wdata->tsh_tte[i], (unsigned char *)tdata + XDD_TS_HEADER_SIZE + (i * XDD_TS_TTE_SIZE_NO_DISPATCH), XDD_TS_TTE_SIZE_NO_DISPATCH);
+		wdata->tsh_magic = XDD_TS_MAGIC;
+		tsize = XDD_TS_HEADER_SIZE + (nents * sizeof(xdd_ts_tte_t));
+		free(tdata);
+		tdata = wdata;
+	}
+
+	/* only the entries that were used are in the file, which is fewer than the table had with -ts sample */
+	if (tdata->tsh_numents > 0 && tdata->tsh_tt_size > (size_t)tdata->tsh_numents)
+		tdata->tsh_tt_size = tdata->tsh_numents;
+	if (tdata->tsh_tt_size > (tsize - XDD_TS_HEADER_SIZE) / sizeof(xdd_ts_tte_t)) {
+		fprintf(stderr,"Timestamp dump is too short: %s\n",filename);
+		return 0;
+	}
+
 	/* no empty sets */
 	if (tdata->tsh_tt_size < 1) {
 		fprintf(stderr,"Timestamp dump was empty: %s\n",filename);
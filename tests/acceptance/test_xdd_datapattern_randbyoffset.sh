@@ -0,0 +1,27 @@
+#!/bin/bash
+#
+# Test the random-by-offset data pattern with an odd request size
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Write the pattern with a request size that is not a multiple of 8 bytes
+#
+generate_local_filename rfile
+$XDDTEST_XDD_EXE -op write -target $rfile -reqsize 3 -blocksize 1000 -numreqs 20 -datapattern randbyoffset >/dev/null 2>&1
+if [ 0 -ne $? ]; then
+    echo "XDD write command failed"
+    finalize_test 1
+fi
+
+#
+# Read it back and verify the contents, including the partial tail words
+#
+verify=$($XDDTEST_XDD_EXE -op read -target $rfile -reqsize 3 -blocksize 1000 -numreqs 20 -datapattern randbyoffset -verify contents 2>/dev/null |grep "data compare errors")
+result=1
+if [ "$verify" = "Target 0 verify, 0, data compare errors" ]; then
+    result=0
+fi
+finalize_test $result
@@ -0,0 +1,31 @@
+#!/bin/bash
+#
+# Test that a compact time stamp dump can be read back by xdd-read-tsdumps
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Dump the time stamps of 100 ops in the compact format
+#
+generate_local_filename tfile
+tsname=$XDDTEST_LOCAL_MOUNT/$TESTNAME/tsc
+$XDDTEST_XDD_EXE -op write -target $tfile -reqsize 1 -blocksize 4096 -numreqs 100 -ts dump $tsname -ts compact >/dev/null 2>&1
+if [ 0 -ne $? -o ! -f $tsname.target.0000.bin ]; then
+    echo "XDD compact time stamp dump failed"
+    finalize_test 1
+fi
+
+#
+# Read the dump back and check that all 100 entries came out of it
+#
+\mkdir -p $XDDTEST_LOCAL_MOUNT/$TESTNAME/analysis
+$XDDTEST_XDD_PATH/xdd-read-tsdumps -o $XDDTEST_LOCAL_MOUNT/$TESTNAME/analysis $tsname.target.0000.bin >/dev/null 2>&1
+entries=$(grep -vc "^#" $XDDTEST_LOCAL_MOUNT/$TESTNAME/analysis/analysis.dat)
+\rm -f gnuplot_analysis
+result=1
+if [ "$entries" = "100" ]; then
+    result=0
+fi
+finalize_test $result
@@ -0,0 +1,31 @@
+#!/bin/bash
+#
+# Test that -ts sample every only time stamps one op out of every N
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# Time stamp every 10th op of a 100 op run
+#
+generate_local_filename tfile
+tsname=$XDDTEST_LOCAL_MOUNT/$TESTNAME/tss
+dumped=$($XDDTEST_XDD_EXE -op write -target $tfile -reqsize 1 -blocksize 4096 -numreqs 100 -ts dump $tsname -ts sample every 10 2>/dev/null |grep "Timestamp table written")
+if [ -z "$dumped" -o -n "${dumped##* - 10 entries, *}" ]; then
+    echo "XDD sampled time stamp dump reported: $dumped"
+    finalize_test 1
+fi
+
+#
+# The dump itself should also hold exactly 10 entries
+#
+\mkdir -p $XDDTEST_LOCAL_MOUNT/$TESTNAME/analysis
+$XDDTEST_XDD_PATH/xdd-read-tsdumps -o $XDDTEST_LOCAL_MOUNT/$TESTNAME/analysis $tsname.target.0000.bin >/dev/null 2>&1
+entries=$(grep -vc "^#" $XDDTEST_LOCAL_MOUNT/$TESTNAME/analysis/analysis.dat)
+\rm -f gnuplot_analysis
+result=1
+if [ "$entries" = "10" ]; then
+    result=0
+fi
+finalize_test $result
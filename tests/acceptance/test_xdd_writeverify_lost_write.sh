@@ -0,0 +1,31 @@
+#!/bin/bash
+#
+# Test that -op writeverify catches a block that changed after it was written
+#
+source ./test_config
+source $XDDTEST_TESTS_DIR/acceptance/common.sh
+initialize_test
+
+#
+# A clean run should not report any lost writes
+#
+generate_local_filename wfile
+lost=$($XDDTEST_XDD_EXE -op writeverify -target $wfile -reqsize 1 -blocksize 4096 -numreqs 60 -readbackdelay 10 -datapattern random 2>/dev/null |grep "Target 0 write-verify")
+if [ -z "$lost" -o -n "${lost##*, 0, lost writes, 0, readback errors}" ]; then
+    echo "Clean write-verify run reported: $lost"
+    finalize_test 1
+fi
+
+#
+# Throttle the run so that the first block is overwritten behind the back
+# of XDD well before it is read back 50 ops later
+#
+generate_local_filename cfile
+( sleep 2; printf 'CORRUPT!' | dd of=$cfile bs=1 seek=0 conv=notrunc >/dev/null 2>&1 ) &
+lost=$($XDDTEST_XDD_EXE -op writeverify -target $cfile -reqsize 1 -blocksize 4096 -numreqs 60 -readbackdelay 50 -throttle ops 10 -datapattern random 2>/dev/null |grep "Target 0 write-verify")
+wait
+result=1
+if [ -n "$lost" -a -z "${lost##*, 1, lost writes, 0, readback errors}" ]; then
+    result=0
+fi
+finalize_test $result